@@ -24,6 +24,7 @@
 #include "ramses_widgets/RendererBackend.h"
 #include "style/RaCoStyle.h"
 #include "utils/CrashDump.h"
+#include "utils/PhaseTracer.h"
 #include "utils/u8path.h"
 
 #include "python_api/PythonAPI.h"
@@ -108,6 +109,10 @@ int main(int argc, char* argv[]) {
 					  << "pythonpath",
 		"Directory to add to python module search path.",
 		"python-path");
+	QCommandLineOption phaseTraceOption(
+		QStringList() << "tracephases",
+		"Record the duration of the project load and scene creation phases and write them as Chrome trace JSON file (viewable in chrome://tracing or Perfetto) on exit.",
+		"trace-file");
 
 	parser.addOption(consoleOption);
 	parser.addOption(noDumpFileCheckOption);
@@ -117,6 +122,7 @@ int main(int argc, char* argv[]) {
 	parser.addOption(ramsesLogicFeatureLevel);
 	parser.addOption(pyrunOption);
 	parser.addOption(pythonPathOption);
+	parser.addOption(phaseTraceOption);
 
 	ramses_base::addRamseFrameworkOptions(parser);
 
@@ -210,6 +216,12 @@ int main(int argc, char* argv[]) {
 		pythonSearchPaths = parser.values(pythonPathOption);
 	}
 
+	QString phaseTracePath{};
+	if (parser.isSet(phaseTraceOption)) {
+		phaseTracePath = QFileInfo(parser.value(phaseTraceOption)).absoluteFilePath();
+		utils::PhaseTracer::instance().setEnabled(true);
+	}
+
 	// set font, must be done after application instance
 	style::RaCoStyle::installFont();
 
@@ -264,7 +276,17 @@ int main(int argc, char* argv[]) {
 
 		w.show();
 
-		return a.exec();
+		auto result = a.exec();
+
+		if (!phaseTracePath.isEmpty()) {
+			auto& tracer = utils::PhaseTracer::instance();
+			if (tracer.writeChromeTrace(phaseTracePath.toStdString())) {
+				LOG_INFO(log_system::COMMON, "Phase trace written to {}\n{}", phaseTracePath.toStdString(), tracer.summary());
+			} else {
+				LOG_ERROR(log_system::COMMON, "Can't write phase trace to {}", phaseTracePath.toStdString());
+			}
+		}
+		return result;
 	} else {
 		exit(1);
 	}
@@ -791,7 +791,35 @@ bool MainWindow::upgradeActiveProject(int newFeatureLevel) {
 		if (racoApplication_->canSaveActiveProject()) {
 			std::string errorMsg;
 			if (racoApplication_->activeRaCoProject().save(errorMsg)) {
-				openProject(QString::fromStdString(racoApplication_->activeProjectPath()), newFeatureLevel);
+				// The widgets reference the engine-side scenes which are recreated by the upgrade.
+				{
+					auto settings = core::PathManager::layoutSettings();
+					dockManager_->saveCurrentLayoutInCache(settings);
+					settings.sync();
+				}
+				delete dockManager_;
+				killTimer(renderTimerId_);
+
+				bool upgraded = true;
+				try {
+					racoApplication_->upgradeActiveProjectFeatureLevel(newFeatureLevel);
+				} catch (const std::exception& e) {
+					LOG_WARNING(log_system::COMMON, "In-place feature level upgrade failed, reloading project: {}", e.what());
+					upgraded = false;
+				}
+
+				renderTimerId_ = startTimer(timerInterval60Fps);
+				dockManager_ = createDockManager();
+				restoreCachedLayout();
+				configureDebugActions(ui, this, racoApplication_->activeRaCoProject().commandInterface());
+
+				updateApplicationTitle();
+				updateUpgradeMenu();
+
+				if (!upgraded) {
+					// Fall back to loading the saved project file with the new feature level.
+					openProject(QString::fromStdString(racoApplication_->activeProjectPath()), newFeatureLevel, false, true);
+				}
 				return true;
 			} else {
 				updateApplicationTitle();
@@ -15,17 +15,21 @@
 #include "components/DataChangeDispatcher.h"
 #include "components/RaCoNameConstants.h"
 #include "core/PathManager.h"
+#include "core/ProjectDiff.h"
 #include "core/ProjectMigration.h"
 #include "log_system/log.h"
 #include "ramses_adaptor/SceneBackend.h"
 #include "ramses_base/HeadlessEngineBackend.h"
+#include "ramses_base/TextureCompressor.h"
 #include "utils/CrashDump.h"
+#include "utils/PhaseTracer.h"
 #include "utils/u8path.h"
 
 #include "python_api/PythonAPI.h"
 
 #include <QCoreApplication>
 #include <QTimer>
+#include <fstream>
 #include <iostream>
 
 namespace py = pybind11;
@@ -36,8 +40,8 @@ class Worker : public QObject {
 	Q_OBJECT
 
 public:
-	Worker(QObject* parent, QString& projectFile, QString& exportPath, QString& pythonScriptPath, QStringList& pythonSearchPaths, bool compressExport, QStringList positionalArguments, int featureLevel, raco::application::ELuaSavingMode luaSavingMode, ramses::RamsesFrameworkConfig ramsesConfig)
-		: QObject(parent), projectFile_(projectFile), exportPath_(exportPath), pythonScriptPath_(pythonScriptPath), pythonSearchPaths_(pythonSearchPaths), compressExport_(compressExport), positionalArguments_(positionalArguments), featureLevel_(featureLevel), luaSavingMode_(luaSavingMode), ramsesConfig_(ramsesConfig) {
+	Worker(QObject* parent, QString& projectFile, QString& exportPath, QString& pythonScriptPath, QStringList& pythonSearchPaths, bool compressExport, bool interleavedVertexData, bool optimizeMeshes, std::optional<raco::ramses_base::EEtcQuality> textureCompression, QString textureCacheDirectory, raco::ramses_adaptor::ExportOptimizations exportOptimizations, QString exportCacheDirectory, QString diffProjectPath, QString diffOutputPath, QStringList positionalArguments, int featureLevel, raco::application::ELuaSavingMode luaSavingMode, ramses::RamsesFrameworkConfig ramsesConfig)
+		: QObject(parent), projectFile_(projectFile), exportPath_(exportPath), pythonScriptPath_(pythonScriptPath), pythonSearchPaths_(pythonSearchPaths), compressExport_(compressExport), interleavedVertexData_(interleavedVertexData), optimizeMeshes_(optimizeMeshes), textureCompression_(textureCompression), textureCacheDirectory_(textureCacheDirectory), exportOptimizations_(exportOptimizations), exportCacheDirectory_(exportCacheDirectory), diffProjectPath_(diffProjectPath), diffOutputPath_(diffOutputPath), positionalArguments_(positionalArguments), featureLevel_(featureLevel), luaSavingMode_(luaSavingMode), ramsesConfig_(ramsesConfig) {
 	}
 
 public Q_SLOTS:
@@ -47,7 +51,9 @@ public Q_SLOTS:
 		std::unique_ptr<raco::application::RaCoApplication> app;
 
 		try {
-			app = std::make_unique<raco::application::RaCoApplication>(backend, raco::application::RaCoApplicationLaunchSettings{projectFile_, false, true, featureLevel_, featureLevel_, false});
+			raco::application::RaCoApplicationLaunchSettings settings{projectFile_, false, true, featureLevel_, featureLevel_, false};
+			settings.optimizeMeshes = optimizeMeshes_;
+			app = std::make_unique<raco::application::RaCoApplication>(backend, settings);
 		} catch (const raco::application::FutureFileVersion& error) {
 			LOG_ERROR(log_system::COMMON, "File load error: project file was created with newer file version {} but current file version is {}.", error.fileVersion_, serialization::RAMSES_PROJECT_FILE_VERSION);
 			app.reset();
@@ -86,14 +92,32 @@ public Q_SLOTS:
 				if (!currentRunStatus.stdErrBuffer.empty()) {
 					LOG_ERROR(log_system::PYTHON, currentRunStatus.stdErrBuffer);
 				}
+			} else if (!diffProjectPath_.isEmpty()) {
+				exitCode_ = diffProjects(app.get());
 			} else if (!exportPath_.isEmpty()) {
 				QString ramsesPath = exportPath_ + "." + raco::names::FILE_EXTENSION_RAMSES_EXPORT;
 
+				app->setExportCacheDirectory(exportCacheDirectory_.toStdString());
+				app->setExportInterleavedVertexData(interleavedVertexData_);
+				app->setExportTextureCompression(textureCompression_, textureCacheDirectory_.toStdString());
+				app->setExportOptimizations(exportOptimizations_);
+
 				std::string error;
 				if (!app->exportProject(ramsesPath.toStdString(), compressExport_, error, false, luaSavingMode_)) {
 					LOG_ERROR(log_system::COMMON, "error exporting to {}\n{}", ramsesPath.toStdString(), error.c_str());
 					exitCode_ = 1;
 				}
+
+				for (const auto& removed : app->lastExportReport().removedObjects) {
+					LOG_INFO(log_system::COMMON, "Not exported: {} '{}' ({}): {}", removed.typeName, removed.objectName, removed.objectID, removed.reason);
+				}
+				for (const auto& link : app->lastExportReport().removedLinks) {
+					LOG_INFO(log_system::COMMON, "Not exported: {}", link);
+				}
+
+				if (auto cache = app->exportCache()) {
+					LOG_INFO(log_system::COMMON, "Export cache statistics: {} hits, {} misses, {} stored", cache->statistics().hits, cache->statistics().misses, cache->statistics().stored);
+				}
 			}
 		}
 
@@ -104,11 +128,48 @@ Q_SIGNALS:
 	void finished(int returnCode);
 
 private:
+	// Compare the project loaded from diffProjectPath_ (old) with the active project (new).
+	int diffProjects(raco::application::RaCoApplication* app) {
+		std::unique_ptr<raco::application::RaCoProject> baseProject;
+		try {
+			core::LoadContext loadContext;
+			baseProject = raco::application::RaCoProject::loadFromFile(diffProjectPath_, app, loadContext, true, featureLevel_);
+		} catch (const std::exception& error) {
+			LOG_ERROR(log_system::COMMON, "File Load Error: loading diff base project {} failed: {}", diffProjectPath_.toStdString(), error.what());
+			return 1;
+		}
+
+		std::ofstream outputFile;
+		if (!diffOutputPath_.isEmpty()) {
+			outputFile.open(utils::u8path(diffOutputPath_.toStdString()).internalPath(), std::ios::out | std::ios::trunc);
+			if (!outputFile) {
+				LOG_ERROR(log_system::COMMON, "Can't open diff output file {}", diffOutputPath_.toStdString());
+				return 1;
+			}
+		}
+		core::ProjectDiffJsonWriter writer(diffOutputPath_.isEmpty() ? std::cout : outputFile);
+
+		auto statistics = core::diffProjects(*baseProject->project(), *app->activeRaCoProject().project(), writer);
+		LOG_INFO(log_system::COMMON, "Project diff: objects {} added, {} removed, {} changed; properties {} added, {} removed, {} changed; links {} added, {} removed, {} changed",
+			statistics.addedObjects, statistics.removedObjects, statistics.changedObjects,
+			statistics.addedProperties, statistics.removedProperties, statistics.changedProperties,
+			statistics.addedLinks, statistics.removedLinks, statistics.changedLinks);
+		return 0;
+	}
+
 	QString projectFile_;
 	QString exportPath_;
 	QString& pythonScriptPath_;
 	QStringList pythonSearchPaths_;
 	bool compressExport_;
+	bool interleavedVertexData_;
+	bool optimizeMeshes_;
+	std::optional<raco::ramses_base::EEtcQuality> textureCompression_;
+	QString textureCacheDirectory_;
+	raco::ramses_adaptor::ExportOptimizations exportOptimizations_;
+	QString exportCacheDirectory_;
+	QString diffProjectPath_;
+	QString diffOutputPath_;
 	QStringList positionalArguments_;
 	int featureLevel_;
 	raco::application::ELuaSavingMode luaSavingMode_;
@@ -141,6 +202,46 @@ int main(int argc, char* argv[]) {
 		QStringList() << "c"
 					  << "compress",
 		"Compress Ramses scene on export (ignored if '-r' is used).");
+	QCommandLineOption interleavedVertexDataOption(
+		QStringList() << "interleaved",
+		"Export the vertex attributes of each mesh as a single interleaved vertex buffer (ignored if '-r' is used).");
+	QCommandLineOption optimizeMeshesOption(
+		QStringList() << "optimizemeshes",
+		"Weld duplicate vertices and reorder the triangles and vertices of all meshes for better GPU vertex cache efficiency when loading them.");
+	QCommandLineOption textureCompressionOption(
+		QStringList() << "etc",
+		"Export 8 bit RGB and RGBA textures compressed to ETC2 using the quality preset 'fast', 'normal' or 'high' (ignored if '-r' is used).",
+		"quality");
+	QCommandLineOption textureCacheOption(
+		QStringList() << "etccache",
+		"Directory for caching the ETC2 compressed textures between exports.",
+		"cache-dir");
+	QCommandLineOption removeUnusedResourcesOption(
+		QStringList() << "removeunused",
+		"Don't export meshes, textures, render buffers, render targets, materials, animation channels and Lua modules which are not used by the exported scene or logic (ignored if '-r' is used).");
+	QCommandLineOption flattenTransformsOption(
+		QStringList() << "flattentransforms",
+		"Bake the transformation of static intermediate nodes into their children and don't export these nodes (ignored if '-r' is used).");
+	QCommandLineOption removeUnusedLogicOption(
+		QStringList() << "removeunusedlogic",
+		"Don't export Lua scripts, Lua interfaces, animations and timers whose outputs can't reach the scene via links (ignored if '-r' is used).");
+	QCommandLineOption shareAppearancesOption(
+		QStringList() << "shareappearances",
+		"Let mesh nodes with identical private material options and uniforms share one appearance and don't export appearance bindings without links (ignored if '-r' is used).");
+	QCommandLineOption exportCacheOption(
+		QStringList() << "x"
+					  << "exportcache",
+		"Use the directory as export cache: exports of unchanged projects are copied from the cache instead of being exported again (ignored if '-r' is used).",
+		"cache-dir");
+	QCommandLineOption diffProjectOption(
+		QStringList() << "D"
+					  << "diff",
+		"Compare the project loaded with '-p' to the specified base project and write the differences as JSON lines (ignored if '-r' is used).",
+		"base-project-path");
+	QCommandLineOption diffOutputOption(
+		QStringList() << "diffoutput",
+		"File to write the differences to instead of the standard output.",
+		"diff-output-path");
 	QCommandLineOption noDumpFileCheckOption(
 		QStringList() << "d"
 					  << "nodump",
@@ -180,10 +281,25 @@ int main(int argc, char* argv[]) {
 					  << "luasavingmode",
 		"Lua script saving mode. Possible options: source_code, byte_code, source_and_byte_code.",
 		"lua-saving-mode");
+	QCommandLineOption phaseTraceOption(
+		QStringList() << "tracephases",
+		"Record the duration of the project load and scene creation phases and write them as Chrome trace JSON file (viewable in chrome://tracing or Perfetto).",
+		"trace-file");
 
 	parser.addOption(loadProjectAction);
 	parser.addOption(exportProjectAction);
 	parser.addOption(compressExportAction);
+	parser.addOption(interleavedVertexDataOption);
+	parser.addOption(optimizeMeshesOption);
+	parser.addOption(textureCompressionOption);
+	parser.addOption(textureCacheOption);
+	parser.addOption(removeUnusedResourcesOption);
+	parser.addOption(flattenTransformsOption);
+	parser.addOption(removeUnusedLogicOption);
+	parser.addOption(shareAppearancesOption);
+	parser.addOption(exportCacheOption);
+	parser.addOption(diffProjectOption);
+	parser.addOption(diffOutputOption);
 	parser.addOption(noDumpFileCheckOption);
 	parser.addOption(logLevelOption);
 
@@ -194,6 +310,7 @@ int main(int argc, char* argv[]) {
 	parser.addOption(ramsesLogicFeatureLevel);
 	parser.addOption(pythonPathOption);
 	parser.addOption(luaSavingModeOption);
+	parser.addOption(phaseTraceOption);
 	
 	// application must be instantiated before parsing command line
 	QCoreApplication a(argc, argv);
@@ -249,6 +366,13 @@ int main(int argc, char* argv[]) {
 
 	QString exportPath{};
 	bool compressExport = parser.isSet(compressExportAction);
+	bool interleavedVertexData = parser.isSet(interleavedVertexDataOption);
+	bool optimizeMeshes = parser.isSet(optimizeMeshesOption);
+	ramses_adaptor::ExportOptimizations exportOptimizations;
+	exportOptimizations.removeUnusedResources = parser.isSet(removeUnusedResourcesOption);
+	exportOptimizations.flattenStaticTransforms = parser.isSet(flattenTransformsOption);
+	exportOptimizations.removeUnusedLogic = parser.isSet(removeUnusedLogicOption);
+	exportOptimizations.sharePrivateAppearances = parser.isSet(shareAppearancesOption);
 	if (parser.isSet(exportProjectAction)) {
 		QFileInfo path(parser.value(exportProjectAction));
 
@@ -258,6 +382,39 @@ int main(int argc, char* argv[]) {
 		}
 	}
 
+	std::optional<ramses_base::EEtcQuality> textureCompression;
+	if (parser.isSet(textureCompressionOption)) {
+		auto option = parser.value(textureCompressionOption);
+		if (option == "fast") {
+			textureCompression = ramses_base::EEtcQuality::Fast;
+		} else if (option == "normal") {
+			textureCompression = ramses_base::EEtcQuality::Normal;
+		} else if (option == "high") {
+			textureCompression = ramses_base::EEtcQuality::High;
+		} else {
+			LOG_ERROR(log_system::COMMON, fmt::format("Invalid texture compression quality: {}. Possible values are: fast, normal, high.", option.toStdString()));
+			exit(1);
+		}
+	}
+	QString textureCacheDirectory{};
+	if (parser.isSet(textureCacheOption)) {
+		textureCacheDirectory = QFileInfo(parser.value(textureCacheOption)).absoluteFilePath();
+	}
+
+	QString exportCacheDirectory{};
+	if (parser.isSet(exportCacheOption)) {
+		exportCacheDirectory = QFileInfo(parser.value(exportCacheOption)).absoluteFilePath();
+	}
+
+	QString diffProjectPath{};
+	if (parser.isSet(diffProjectOption)) {
+		diffProjectPath = QFileInfo(parser.value(diffProjectOption)).absoluteFilePath();
+	}
+	QString diffOutputPath{};
+	if (parser.isSet(diffOutputOption)) {
+		diffOutputPath = QFileInfo(parser.value(diffOutputOption)).absoluteFilePath();
+	}
+
 	QString pythonScriptPath{};
 	if (parser.isSet(pyrunOption)) {
 		QFileInfo path(parser.value(pyrunOption));
@@ -308,9 +465,25 @@ int main(int argc, char* argv[]) {
 		}
 	}
 
-	Worker* task = new Worker(&a, projectFile, exportPath, pythonScriptPath, pythonSearchPaths, compressExport, parser.positionalArguments(), featureLevel, luaSavingMode, ramsesConfig);
+	QString phaseTracePath{};
+	if (parser.isSet(phaseTraceOption)) {
+		phaseTracePath = QFileInfo(parser.value(phaseTraceOption)).absoluteFilePath();
+		utils::PhaseTracer::instance().setEnabled(true);
+	}
+
+	Worker* task = new Worker(&a, projectFile, exportPath, pythonScriptPath, pythonSearchPaths, compressExport, interleavedVertexData, optimizeMeshes, textureCompression, textureCacheDirectory, exportOptimizations, exportCacheDirectory, diffProjectPath, diffOutputPath, parser.positionalArguments(), featureLevel, luaSavingMode, ramsesConfig);
 	QObject::connect(task, &Worker::finished, &QCoreApplication::exit);
 	QTimer::singleShot(0, task, &Worker::run);
 
-	return a.exec();
+	auto result = a.exec();
+
+	if (!phaseTracePath.isEmpty()) {
+		auto& tracer = utils::PhaseTracer::instance();
+		if (tracer.writeChromeTrace(phaseTracePath.toStdString())) {
+			LOG_INFO(log_system::COMMON, "Phase trace written to {}\n{}", phaseTracePath.toStdString(), tracer.summary());
+		} else {
+			LOG_ERROR(log_system::COMMON, "Can't write phase trace to {}", phaseTracePath.toStdString());
+		}
+	}
+	return result;
 }
@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QCryptographicHash>
+
+#include <set>
+#include <string>
+
+namespace raco::application {
+
+/**
+ * @brief Accumulates a deterministic SHA-256 fingerprint from strings, byte arrays and file contents.
+ */
+class ExportFingerprint {
+public:
+	ExportFingerprint();
+
+	void addString(const std::string& value);
+	void addData(const QByteArray& data);
+
+	// Add the contents of a file. Missing or unreadable files contribute a fixed marker instead.
+	void addFile(const std::string& absPath);
+
+	std::string result() const;
+
+private:
+	QCryptographicHash hash_;
+};
+
+/**
+ * @brief Content-addressed local cache for exported .ramses files.
+ *
+ * Exports are identified by a fingerprint over everything influencing the exported file, see RaCoApplication::exportFingerprint.
+ * An export with a fingerprint which has been stored before can be served by copying the cached file.
+ */
+class ExportCache {
+public:
+	// Increase when the fingerprint computation changes in a way that invalidates existing cache entries.
+	static constexpr int FINGERPRINT_VERSION = 2;
+
+	struct Statistics {
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t stored = 0;
+	};
+
+	explicit ExportCache(const std::string& cacheDirectory);
+
+	const std::string& cacheDirectory() const;
+	std::string cachedFilePath(const std::string& fingerprint) const;
+
+	// Copy the cached export for the fingerprint to destinationPath.
+	// @return true and count a cache hit if the cache contained the fingerprint; otherwise count a cache miss.
+	bool retrieve(const std::string& fingerprint, const std::string& destinationPath);
+
+	// Store the exported file under the fingerprint.
+	bool store(const std::string& fingerprint, const std::string& exportedPath);
+
+	const Statistics& statistics() const;
+
+	// Files which are loaded indirectly when loading the file, e.g. the external buffers and images of a .gltf file.
+	static std::set<std::string> fileDependencies(const std::string& absPath);
+
+private:
+	std::string cacheDirectory_;
+	Statistics statistics_;
+};
+
+}  // namespace raco::application
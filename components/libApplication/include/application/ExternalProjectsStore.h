@@ -52,6 +52,10 @@ public:
 
 	const FeatureLevelLoadError* getFlError() const;
 
+	// Raise the feature level of all loaded external projects in place, dependencies first.
+	// External projects which failed to load at the previous feature level are loaded again.
+	void upgradeFeatureLevel(int featureLevel);
+
 private:
 	// Needs to access externalProjects_ directly:
 	friend class ::ObjectTreeViewExternalProjectModelTest;
@@ -66,6 +70,7 @@ private:
 	void buildProjectGraph(const std::string& absPath, std::vector<ProjectGraphNode>& outProjects);
 	void updateExternalProjectsDependingOn(const std::string& absPath, int featureLevel);
 	bool loadExternalProject(const std::string& projectPath, core::LoadContext& loadContext);
+	void registerFileChangedHandler(const std::string& projectPath, int featureLevel);
 
 	RaCoProject* activeProject_ = nullptr;
 	RaCoApplication* application_ = nullptr;
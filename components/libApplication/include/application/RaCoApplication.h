@@ -9,13 +9,17 @@
  */
 #pragma once
 
+#include "application/ExportCache.h"
 #include "application/ExternalProjectsStore.h"
 #include "application/RaCoProject.h"
 #include "components/DataChangeDispatcher.h"
 #include "core/ChangeRecorder.h"
 #include "core/Project.h"
 #include "core/SceneBackendInterface.h"
+#include "ramses_adaptor/ExportOptimizations.h"
+#include <QJsonObject>
 #include <memory>
+#include <optional>
 
 #include "core/ExtrefOperations.h"
 
@@ -27,6 +31,8 @@ enum class ErrorLevel;
 
 namespace raco::ramses_base {
 class BaseEngineBackend;
+class TextureCompressor;
+enum class EEtcQuality;
 }
 
 namespace raco::ramses_adaptor {
@@ -51,6 +57,8 @@ struct RaCoApplicationLaunchSettings {
 	int newFileFeatureLevel;
 	int initialLoadFeatureLevel;
 	bool runningInUI;
+	// Optimize the vertex and index data of all meshes when loading them, see core::MeshDescriptor::optimize.
+	bool optimizeMeshes = false;
 };
 
 // Lua script saving mode. Wraps ramses::ELuaSavingMode.
@@ -78,6 +86,18 @@ public:
 	// - loading scene: -1 = load with feature level in project file; >0 migrate scene to specified feature level
 	void switchActiveRaCoProject(const QString& file, std::function<std::string(const std::string&)> relinkCallback, bool createDefaultScene = true, int featureLevel = -1, bool generateNewObjectIDs = false);
 
+	/**
+	 * @brief Raise the feature level of the active project without reloading it from file.
+	 * 
+	 * Reuses the loaded data model of the active and the external projects, reruns only the feature level
+	 * dependent object handlers and rebuilds the engine-side scene. The result is the same as loading the
+	 * project file with the new feature level.
+	 * 
+	 * @exception FeatureLevelLoadError if the new feature level is smaller than the project feature level
+	 * @exception std::runtime_error if the new feature level is outside the valid range
+	*/
+	void upgradeActiveProjectFeatureLevel(int featureLevel);
+
 	/**
 	 * @brief Save project in new file while changing project ID and all object IDs.
 	 * 
@@ -103,6 +123,41 @@ public:
 		bool forceExportWithErrors = false,
 		ELuaSavingMode luaSavingMode = ELuaSavingMode::SourceCodeOnly);
 
+	/**
+	 * @brief Deterministic fingerprint of everything influencing the exported file.
+	 * 
+	 * Includes the RaCo and Ramses versions, the export options, the feature level, the serialized active project
+	 * and the contents of all external project files and resource files used by the project.
+	*/
+	std::string exportFingerprint(bool compress, bool forceExportWithErrors, ELuaSavingMode luaSavingMode);
+
+	// All export options influencing the exported file, including the project feature level, by name.
+	// Used for the export fingerprint; new export options need to be added here.
+	QJsonObject exportSettings(bool compress, bool forceExportWithErrors, ELuaSavingMode luaSavingMode);
+
+	// Enable the export cache using the specified cache directory; disable it if the directory is empty.
+	// With the export cache enabled exportProject will copy the cached file instead of exporting
+	// if the export fingerprint matches a previous successful export.
+	void setExportCacheDirectory(const std::string& cacheDirectory);
+	const ExportCache* exportCache() const;
+
+	// Export meshes with all vertex attributes packed into a single interleaved vertex buffer per mesh
+	// instead of a separate vertex buffer per attribute.
+	void setExportInterleavedVertexData(bool interleaved);
+	bool exportInterleavedVertexData() const;
+
+	// Export 8 bit RGB and RGBA textures compressed to ETC2 with the given quality preset; disable compression with std::nullopt.
+	// Encoded textures are cached in cacheDirectory unless it is empty.
+	void setExportTextureCompression(std::optional<ramses_base::EEtcQuality> quality, const std::string& cacheDirectory = {});
+	const ramses_base::TextureCompressor* exportTextureCompressor() const;
+
+	// Optional optimization passes applied to the exported scene.
+	void setExportOptimizations(const ramses_adaptor::ExportOptimizations& optimizations);
+	const ramses_adaptor::ExportOptimizations& exportOptimizations() const;
+
+	// Objects left out by the export optimizations in the last export; empty if the export was copied from the export cache.
+	const ramses_adaptor::ExportReport& lastExportReport() const;
+
 	void doOneLoop();
 
 	void resetSceneBackend();
@@ -167,6 +222,12 @@ private:
 
 	ExternalProjectsStore externalProjectsStore_;
 
+	std::unique_ptr<ExportCache> exportCache_;
+	bool exportInterleavedVertexData_ = false;
+	std::shared_ptr<ramses_base::TextureCompressor> exportTextureCompressor_;
+	ramses_adaptor::ExportOptimizations exportOptimizations_;
+	ramses_adaptor::ExportReport lastExportReport_;
+
 	bool logicEngineNeedsUpdate_ = false;
 	bool runningInUI_ = false;
 
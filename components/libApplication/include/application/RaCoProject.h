@@ -94,6 +94,18 @@ public:
 	// @exception ExtrefError
 	void updateExternalReferences(core::LoadContext& loadContext);
 
+	/**
+	 * @brief Raise the feature level of the loaded project in place.
+	 * 
+	 * Only reruns the handlers of objects whose state depends on the engine feature level instead of reloading
+	 * the project file. The engine needs to be set to the new feature level before calling this.
+	 * Resets the undo stack since the previous states can't be restored at the new feature level.
+	 * 
+	 * @exception FeatureLevelLoadError if the new feature level is smaller than the project feature level
+	 * @exception ExtrefError
+	 */
+	void upgradeFeatureLevel(int featureLevel);
+
 	core::Project* project();
 	core::Errors const* errors() const;
 	core::Errors* errors();
@@ -105,6 +117,9 @@ public:
 
 	QJsonDocument serializeProject(const std::unordered_map<std::string, std::vector<int>>& currentVersions);
 
+	// Serialize the complete project including all objects which would be discarded by serializeProject.
+	QJsonDocument serializeProjectData(const std::unordered_map<std::string, std::vector<int>>& currentVersions);
+
 	void applyPreferences() const;
 	void applyDefaultCachedPaths();
 	void setupCachedPathSubscriptions(const components::SDataChangeDispatcher& dataChangeDispatcher);
@@ -119,8 +134,6 @@ private:
 	// @exception ExtrefError
 	RaCoProject(const QString& file, core::Project& p, core::EngineInterface* engineInterface, const core::UndoStack::Callback& callback, core::ExternalProjectsStoreInterface* externalProjectsStore, RaCoApplication* app, core::LoadContext& loadContext, int fileVersion);
 
-	QJsonDocument serializeProjectData(const std::unordered_map<std::string, std::vector<int>>& currentVersions);
-
 
 	void onAfterProjectPathChange(const std::string& oldPath, const std::string& newPath);
 	void generateProjectSubfolder(const std::string& subFolderPath);
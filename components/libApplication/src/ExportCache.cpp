@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "application/ExportCache.h"
+
+#include "log_system/log.h"
+#include "utils/u8path.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+#include <filesystem>
+
+namespace raco::application {
+
+ExportFingerprint::ExportFingerprint() : hash_(QCryptographicHash::Sha256) {
+}
+
+void ExportFingerprint::addString(const std::string& value) {
+	// Include the terminating zero as separator to prevent ambiguities between consecutive strings.
+	hash_.addData(value.c_str(), static_cast<int>(value.size() + 1));
+}
+
+void ExportFingerprint::addData(const QByteArray& data) {
+	addString(std::to_string(data.size()));
+	hash_.addData(data);
+}
+
+void ExportFingerprint::addFile(const std::string& absPath) {
+	QFile file(QString::fromStdString(absPath));
+	if (file.open(QIODevice::ReadOnly)) {
+		QCryptographicHash fileHash(QCryptographicHash::Sha256);
+		fileHash.addData(&file);
+		addData(fileHash.result());
+	} else {
+		addString("<missing>");
+	}
+}
+
+std::string ExportFingerprint::result() const {
+	return hash_.result().toHex().toStdString();
+}
+
+ExportCache::ExportCache(const std::string& cacheDirectory) : cacheDirectory_(cacheDirectory) {
+}
+
+const std::string& ExportCache::cacheDirectory() const {
+	return cacheDirectory_;
+}
+
+std::string ExportCache::cachedFilePath(const std::string& fingerprint) const {
+	return (utils::u8path(cacheDirectory_) / (fingerprint + ".ramses")).string();
+}
+
+bool ExportCache::retrieve(const std::string& fingerprint, const std::string& destinationPath) {
+	auto cachedPath = cachedFilePath(fingerprint);
+	if (utils::u8path(cachedPath).existsFile()) {
+		std::error_code ec;
+		std::filesystem::copy_file(utils::u8path(cachedPath), utils::u8path(destinationPath), std::filesystem::copy_options::overwrite_existing, ec);
+		if (!ec) {
+			++statistics_.hits;
+			LOG_INFO(log_system::PROJECT, "Export cache hit for fingerprint {}: copied {} to {}", fingerprint, cachedPath, destinationPath);
+			return true;
+		}
+		LOG_WARNING(log_system::PROJECT, "Export cache: copying {} to {} failed: {}", cachedPath, destinationPath, ec.message());
+	}
+	++statistics_.misses;
+	LOG_INFO(log_system::PROJECT, "Export cache miss for fingerprint {}", fingerprint);
+	return false;
+}
+
+bool ExportCache::store(const std::string& fingerprint, const std::string& exportedPath) {
+	std::error_code ec;
+	std::filesystem::create_directories(utils::u8path(cacheDirectory_), ec);
+	if (ec) {
+		LOG_WARNING(log_system::PROJECT, "Export cache: can't create cache directory {}: {}", cacheDirectory_, ec.message());
+		return false;
+	}
+
+	// Copy to a temporary file first and rename afterwards to prevent concurrent exports from seeing incomplete cache entries.
+	auto cachedPath = cachedFilePath(fingerprint);
+	auto tempPath = cachedPath + ".tmp";
+	std::filesystem::copy_file(utils::u8path(exportedPath), utils::u8path(tempPath), std::filesystem::copy_options::overwrite_existing, ec);
+	if (!ec) {
+		std::filesystem::rename(utils::u8path(tempPath), utils::u8path(cachedPath), ec);
+	}
+	if (ec) {
+		LOG_WARNING(log_system::PROJECT, "Export cache: storing {} failed: {}", exportedPath, ec.message());
+		std::filesystem::remove(utils::u8path(tempPath), ec);
+		return false;
+	}
+	++statistics_.stored;
+	return true;
+}
+
+const ExportCache::Statistics& ExportCache::statistics() const {
+	return statistics_;
+}
+
+std::set<std::string> ExportCache::fileDependencies(const std::string& absPath) {
+	std::set<std::string> result;
+
+	auto path = utils::u8path(absPath);
+	if (path.extension().string() == ".gltf") {
+		QFile file(QString::fromStdString(absPath));
+		if (file.open(QIODevice::ReadOnly)) {
+			auto document = QJsonDocument::fromJson(file.readAll());
+			for (const auto* key : {"buffers", "images"}) {
+				for (const auto& entry : document[key].toArray()) {
+					auto uri = entry.toObject()["uri"].toString();
+					if (!uri.isEmpty() && !uri.startsWith("data:")) {
+						result.insert((path.parent_path() / QUrl::fromPercentEncoding(uri.toUtf8()).toStdString()).normalized().string());
+					}
+				}
+			}
+		}
+	}
+	return result;
+}
+
+}  // namespace raco::application
@@ -145,7 +145,16 @@ core::Project* ExternalProjectsStore::addExternalProject(const std::string& orig
 
 	bool status = loadExternalProject(projectPath, loadContext);
 
-	int featureLevel = loadContext.featureLevel;
+	registerFileChangedHandler(projectPath, loadContext.featureLevel);
+	application_->dataChangeDispatcher()->setExternalProjectChanged();
+
+	if (status) {
+		return externalProjects_.at(projectPath)->project();
+	}
+	return nullptr;
+}
+
+void ExternalProjectsStore::registerFileChangedHandler(const std::string& projectPath, int featureLevel) {
 	externalProjectFileChangeListeners_[projectPath] = externalProjectFileChangeMonitor_.registerFileChangedHandler(projectPath,
 		[this, projectPath, featureLevel]() {
 			core::LoadContext loadContext;
@@ -153,12 +162,40 @@ core::Project* ExternalProjectsStore::addExternalProject(const std::string& orig
 			loadExternalProject(projectPath, loadContext);
 			updateExternalProjectsDependingOn(projectPath, featureLevel);
 		});
-	application_->dataChangeDispatcher()->setExternalProjectChanged();
+}
 
-	if (status) {
-		return externalProjects_.at(projectPath)->project();
+void ExternalProjectsStore::upgradeFeatureLevel(int featureLevel) {
+	std::vector<ProjectGraphNode> orderedProjects;
+	for (const auto& item : externalProjects_) {
+		buildProjectGraph(item.first, orderedProjects);
 	}
-	return nullptr;
+
+	for (const auto& node : orderedProjects) {
+		try {
+			externalProjects_.at(node.path)->upgradeFeatureLevel(featureLevel);
+		} catch (const core::ExtrefError& e) {
+			LOG_ERROR(log_system::COMMON, "External reference update failed {}", e.what());
+		} catch (const std::runtime_error& e) {
+			LOG_ERROR(log_system::COMMON, "Upgrading external project '{}' failed with error: {}", node.path, e.what());
+		}
+	}
+
+	std::vector<std::string> failedProjects;
+	for (const auto& [projectPath, project] : externalProjects_) {
+		if (!project) {
+			failedProjects.emplace_back(projectPath);
+		}
+	}
+	for (const auto& projectPath : failedProjects) {
+		core::LoadContext loadContext;
+		loadContext.featureLevel = featureLevel;
+		loadExternalProject(projectPath, loadContext);
+	}
+
+	for (const auto& item : externalProjects_) {
+		registerFileChangedHandler(item.first, featureLevel);
+	}
+	application_->dataChangeDispatcher()->setExternalProjectChanged();
 }
 
 std::string ExternalProjectsStore::activeProjectPath() const {
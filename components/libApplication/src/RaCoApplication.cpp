@@ -11,18 +11,24 @@
 
 #include "components/RaCoPreferences.h"
 
+#include "utils/SourceTextStore.h"
 #include "utils/u8path.h"
 
 #include "core/Context.h"
 #include "core/Handles.h"
 #include "components/TracePlayer.h"
 #include "core/Context.h"
+#include "core/CoreAnnotations.h"
 #include "core/PathManager.h"
+#include "core/PathQueries.h"
 #include "core/Project.h"
 #include "core/ProjectMigration.h"
+#include "core/SerializationKeys.h"
 #include "ramses_adaptor/SceneBackend.h"
 #include "ramses_adaptor/AbstractSceneAdaptor.h"
 #include "ramses_base/BaseEngineBackend.h"
+#include "ramses_base/TextureCompressor.h"
+#include "ramses_base/Utils.h"
 #include "user_types/Animation.h"
 
 #include "core/Handles.h"
@@ -65,6 +71,7 @@ RaCoApplication::RaCoApplication(ramses_base::BaseEngineBackend& engine, const R
 	components::RaCoPreferences::init();
 
 	runningInUI_ = settings.runningInUI;
+	meshCache_.setOptimizeMeshes(settings.optimizeMeshes);
 
 	switchActiveRaCoProject(settings.initialProject, {}, settings.createDefaultScene, settings.initialLoadFeatureLevel);
 }
@@ -117,7 +124,8 @@ public:
 void RaCoApplication::setupScene(bool optimizeForExport, bool setupAbstractScene) {
 	auto featureLevel = static_cast<ramses::EFeatureLevel>(activeRaCoProject().project()->featureLevel());
 
-	previewSceneBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors(), optimizeForExport, ramses_adaptor::SceneBackend::toSceneId(*activeRaCoProject().project()->settings()->sceneId_));
+	previewSceneBackend_->setScene(activeRaCoProject().project(), activeRaCoProject().errors(), optimizeForExport, ramses_adaptor::SceneBackend::toSceneId(*activeRaCoProject().project()->settings()->sceneId_),
+		optimizeForExport && exportInterleavedVertexData_, optimizeForExport ? exportTextureCompressor_ : nullptr, exportOptimizations_);
 	if (runningInUI_) {
 		if (setupAbstractScene) {
 			abstractScene_.reset();
@@ -171,6 +179,41 @@ void RaCoApplication::switchActiveRaCoProject(const QString& file, std::function
 
 	// Log all errors after the engine update to make sure that errors created by the adaptor classes are logged.
 	activeProject_->errors()->logAllErrors();
+
+	auto textStatistics = utils::SourceTextStore::instance().statistics();
+	LOG_INFO(log_system::PROJECT, "Shader and script sources: {} unique texts with {} bytes shared by {} bytes of references (deduplication ratio {:.2f})",
+		textStatistics.uniqueTexts, textStatistics.uniqueBytes, textStatistics.referencedBytes, textStatistics.deduplicationRatio());
+}
+
+void RaCoApplication::upgradeActiveProjectFeatureLevel(int featureLevel) {
+	if (!(featureLevel >= ramses_base::BaseEngineBackend::minFeatureLevel && featureLevel <= ramses_base::BaseEngineBackend::maxFeatureLevel)) {
+		throw std::runtime_error(fmt::format("RamsesLogic feature level {} outside valid range ({} ... {})", featureLevel, static_cast<int>(ramses_base::BaseEngineBackend::minFeatureLevel), static_cast<int>(ramses_base::BaseEngineBackend::maxFeatureLevel)));
+	}
+	auto project = activeProject_->project();
+	if (featureLevel < project->featureLevel()) {
+		throw FeatureLevelLoadError(fmt::format("New Feature level {} smaller than project feature level {}.", featureLevel, project->featureLevel()),
+			featureLevel, project->featureLevel(), project->currentPath());
+	}
+
+	previewSceneBackend_->reset();
+	abstractScene_.reset();
+
+	if (static_cast<int>(engine_->featureLevel()) != featureLevel) {
+		// The cached modules belong to the LogicEngine which is recreated by the feature level change.
+		// They are restored when the LuaScriptModules are reparsed below.
+		engine_->coreInterface()->clearModuleCache();
+		engine_->setFeatureLevel(static_cast<ramses::EFeatureLevel>(featureLevel));
+	}
+
+	externalProjectsStore_.upgradeFeatureLevel(featureLevel);
+	activeProject_->upgradeFeatureLevel(featureLevel);
+
+	logicEngineNeedsUpdate_ = true;
+
+	setupScene(false, true);
+	doOneLoop();
+
+	activeProject_->errors()->logAllErrors();
 }
 
 bool RaCoApplication::saveAsWithNewIDs(const QString& newPath, std::string& outError, bool setProjectName) {
@@ -205,19 +248,146 @@ core::ErrorLevel RaCoApplication::getExportSceneDescriptionAndStatus(std::vector
 }
 
 bool RaCoApplication::exportProject(const std::string& ramsesExport, bool compress, std::string& outError, bool forceExportWithErrors, ELuaSavingMode luaSavingMode) {
+	std::string fingerprint;
+	lastExportReport_ = {};
+	if (exportCache_) {
+		fingerprint = exportFingerprint(compress, forceExportWithErrors, luaSavingMode);
+		if (exportCache_->retrieve(fingerprint, ramsesExport)) {
+			return true;
+		}
+	}
+
 	setupScene(true, false);
 	logicEngineNeedsUpdate_ = true;
 	doOneLoop();
 
 	bool status = exportProjectImpl(ramsesExport, compress, outError, forceExportWithErrors, luaSavingMode);
+	lastExportReport_ = previewSceneBackend_->sceneAdaptor()->exportReport();
 
 	setupScene(false, false);
 	logicEngineNeedsUpdate_ = true;
 	rendererDirty_ = true;
 
+	if (status && exportCache_) {
+		exportCache_->store(fingerprint, ramsesExport);
+	}
+
 	return status;
 }
 
+QJsonObject RaCoApplication::exportSettings(bool compress, bool forceExportWithErrors, ELuaSavingMode luaSavingMode) {
+	QJsonObject settings;
+	settings["compress"] = compress;
+	settings["forceExportWithErrors"] = forceExportWithErrors;
+	settings["luaSavingMode"] = static_cast<int>(luaSavingMode);
+	settings["featureLevel"] = activeRaCoProject().project()->featureLevel();
+	settings["interleavedVertexData"] = exportInterleavedVertexData_;
+	settings["optimizeMeshes"] = meshCache_.optimizeMeshes();
+	if (exportTextureCompressor_) {
+		settings["textureCompression"] = QString::fromStdString(fmt::format("etc2-v{}-{}", ramses_base::TextureCompressor::ENCODER_VERSION, static_cast<int>(exportTextureCompressor_->quality())));
+	}
+	ramses_adaptor::visitExportOptimizations(exportOptimizations_, [&settings](const char* name, bool value) {
+		settings[name] = value;
+	});
+	return settings;
+}
+
+std::string RaCoApplication::exportFingerprint(bool compress, bool forceExportWithErrors, ELuaSavingMode luaSavingMode) {
+	auto ramsesVersion = ramses_base::getRamsesVersion();
+	std::unordered_map<std::string, std::vector<int>> currentVersions = {
+		{serialization::keys::FILE_VERSION, {serialization::RAMSES_PROJECT_FILE_VERSION}},
+		{serialization::keys::RAMSES_VERSION, {ramsesVersion.major, ramsesVersion.minor, ramsesVersion.patch}},
+		{serialization::keys::RAMSES_COMPOSER_VERSION, {RACO_VERSION_MAJOR, RACO_VERSION_MINOR, RACO_VERSION_PATCH}}};
+
+	auto project = activeRaCoProject().project();
+
+	ExportFingerprint fingerprint;
+	fingerprint.addString(fmt::format("export-fingerprint-v{}", ExportCache::FINGERPRINT_VERSION));
+	// The application name is part of the metadata written into the exported file.
+	fingerprint.addString(QCoreApplication::applicationName().toStdString());
+	fingerprint.addData(QJsonDocument(exportSettings(compress, forceExportWithErrors, luaSavingMode)).toJson(QJsonDocument::Compact));
+	fingerprint.addData(activeRaCoProject().serializeProjectData(currentVersions).toJson(QJsonDocument::Compact));
+
+	for (const auto& [projectID, info] : project->externalProjectsMap()) {
+		fingerprint.addString(projectID);
+		fingerprint.addFile(project->lookupExternalProjectPath(projectID));
+	}
+
+	// Resource files sorted by object ID to make the fingerprint independent of the instance order.
+	// Only the file contents are used, not the paths, to allow sharing the cache between different checkouts.
+	std::map<std::string, std::set<std::string>> resourceFiles;
+	for (const auto& object : project->instances()) {
+		auto paths = object->watchedFilePaths();
+		for (size_t index = 0; index < object->size(); index++) {
+			if (auto anno = object->get(index)->query<core::URIAnnotation>(); anno && !anno->isProjectSubdirectoryURI()) {
+				auto uri = object->get(index)->asString();
+				if (!uri.empty()) {
+					paths.insert(core::PathQueries::resolveUriPropertyToAbsolutePath(*project, {object, {index}}));
+				}
+			}
+		}
+		for (const auto& path : std::set<std::string>(paths)) {
+			auto dependencies = ExportCache::fileDependencies(path);
+			paths.insert(dependencies.begin(), dependencies.end());
+		}
+		if (!paths.empty()) {
+			resourceFiles[object->objectID()] = paths;
+		}
+	}
+	for (const auto& [objectID, paths] : resourceFiles) {
+		fingerprint.addString(objectID);
+		for (const auto& path : paths) {
+			fingerprint.addFile(path);
+		}
+	}
+
+	return fingerprint.result();
+}
+
+void RaCoApplication::setExportCacheDirectory(const std::string& cacheDirectory) {
+	if (cacheDirectory.empty()) {
+		exportCache_.reset();
+	} else {
+		exportCache_ = std::make_unique<ExportCache>(cacheDirectory);
+	}
+}
+
+const ExportCache* RaCoApplication::exportCache() const {
+	return exportCache_.get();
+}
+
+void RaCoApplication::setExportInterleavedVertexData(bool interleaved) {
+	exportInterleavedVertexData_ = interleaved;
+}
+
+bool RaCoApplication::exportInterleavedVertexData() const {
+	return exportInterleavedVertexData_;
+}
+
+void RaCoApplication::setExportTextureCompression(std::optional<ramses_base::EEtcQuality> quality, const std::string& cacheDirectory) {
+	if (quality) {
+		exportTextureCompressor_ = std::make_shared<ramses_base::TextureCompressor>(*quality, cacheDirectory);
+	} else {
+		exportTextureCompressor_.reset();
+	}
+}
+
+const ramses_base::TextureCompressor* RaCoApplication::exportTextureCompressor() const {
+	return exportTextureCompressor_.get();
+}
+
+void RaCoApplication::setExportOptimizations(const ramses_adaptor::ExportOptimizations& optimizations) {
+	exportOptimizations_ = optimizations;
+}
+
+const ramses_adaptor::ExportOptimizations& RaCoApplication::exportOptimizations() const {
+	return exportOptimizations_;
+}
+
+const ramses_adaptor::ExportReport& RaCoApplication::lastExportReport() const {
+	return lastExportReport_;
+}
+
 bool RaCoApplication::exportProjectImpl(const std::string& ramsesExport, bool compress, std::string& outError, bool forceExportWithErrors, ELuaSavingMode luaSavingMode) const {
 	// Flushing the scene prevents inconsistent states being saved which could lead to unexpected bevahiour after loading the scene:
 	previewSceneBackend_->flush();
@@ -28,8 +28,10 @@
 #include "core/ProjectMigration.h"
 #include "core/Serialization.h"
 #include "core/SerializationKeys.h"
+#include "user_types/LuaInterface.h"
 #include "user_types/LuaScript.h"
 #include "user_types/LuaScriptModule.h"
+#include "user_types/Material.h"
 #include "user_types/MeshNode.h"
 #include "user_types/Node.h"
 #include "user_types/OrthographicCamera.h"
@@ -40,6 +42,7 @@
 #include "user_types/RenderTarget.h"
 #include "user_types/RenderPass.h"
 #include "utils/FileUtils.h"
+#include "utils/PhaseTracer.h"
 #include "utils/ZipUtils.h"
 #include "utils/u8path.h"
 #include "core/CoreFormatter.h"
@@ -100,7 +103,10 @@ RaCoProject::RaCoProject(const QString& file, Project& p, EngineInterface* engin
 	// - link duplicates may have different link validity
 	// - we used to allow links between logicengine primitive Vec2f/... and structs with the same content properties
 	//   although they can't be linked in the logicengine.
-	context_->initLinkValidity();
+	{
+		utils::ScopedPhase phase("load", "initLinkValidity");
+		context_->initLinkValidity();
+	}
 
 	// Create creation records for all PrefabInstances to force update of their children:
 	// This is necessary since we don't save all the children of the PrefabInstances anymore.
@@ -109,7 +115,10 @@ RaCoProject::RaCoProject(const QString& file, Project& p, EngineInterface* engin
 			context_->modelChanges().recordCreateObject(object);
 		}
 	}
-	context_->performExternalFileReload(project_.instances());
+	{
+		utils::ScopedPhase phase("load", "performExternalFileReload");
+		context_->performExternalFileReload(project_.instances());
+	}
 
 	// Push currently loading project on the project load stack to enable project loop detection to work.
 	loadContext.pathStack.emplace_back(file.toStdString());
@@ -382,11 +391,16 @@ int RaCoProject::preloadFeatureLevel(const QString& filename, int featureLevel)
 
 std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename, RaCoApplication* app, LoadContext& loadContext, bool logErrors, int featureLevel, bool generateNewObjectIDs) {
 	LOG_INFO(log_system::PROJECT, "Loading project from {}", filename.toLatin1());
+	utils::ScopedPhase loadPhase("load", "loadFromFile");
 
 	QFileInfo path(filename);
 	QString absPath = path.absoluteFilePath();
 
-	auto document = loadJsonDocument(filename);
+	QJsonDocument document;
+	{
+		utils::ScopedPhase phase("load", "loadJsonDocument");
+		document = loadJsonDocument(filename);
+	}
 
 	auto fileVersion{serialization::deserializeFileVersion(document)};
 	if (fileVersion > serialization::RAMSES_PROJECT_FILE_VERSION) {
@@ -398,8 +412,11 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 
 	auto result{serialization::deserializeProject(document, absPath.toStdString())};
 
-	for (const auto& instance : result.objects) {
-		instance->onAfterDeserialization();
+	{
+		utils::ScopedPhase phase("load", "onAfterDeserialization");
+		for (const auto& instance : result.objects) {
+			instance->onAfterDeserialization();
+		}
 	}
 
 	// Ordering constraint: generateNewObjectIDs needs the pointers created by the onAfterDeserialization handlers above.
@@ -792,6 +809,47 @@ void RaCoProject::updateExternalReferences(core::LoadContext& loadContext) {
 	context_->updateExternalReferences(loadContext);
 }
 
+void RaCoProject::upgradeFeatureLevel(int featureLevel) {
+	if (featureLevel < project_.featureLevel()) {
+		throw FeatureLevelLoadError(fmt::format("New Feature level {} smaller than project feature level {}.", featureLevel, project_.featureLevel()),
+			featureLevel, project_.featureLevel(), project_.currentPath());
+	}
+	if (featureLevel > static_cast<int>(ramses_base::BaseEngineBackend::maxFeatureLevel)) {
+		throw std::runtime_error(fmt::format("RamsesLogic feature level {} outside valid range ({} ... {})", featureLevel, static_cast<int>(ramses_base::BaseEngineBackend::minFeatureLevel), static_cast<int>(ramses_base::BaseEngineBackend::maxFeatureLevel)));
+	}
+
+	LOG_INFO(log_system::PROJECT, "Upgrading project {} from feature level {} to {}", project_.currentPath(), project_.featureLevel(), featureLevel);
+
+	context_->set({project_.settings(), &ProjectSettings::featureLevel_}, featureLevel);
+
+	// Only the objects parsing their contents using the engine depend on the feature level.
+	// The other objects are kept unchanged; objects referencing the reparsed ones are updated by the
+	// referenced object changed handlers. Modules go first since they need to be in the module cache
+	// of the engine before the scripts using them are parsed.
+	std::vector<SEditorObject> engineDependentObjects;
+	std::copy_if(project_.instances().begin(), project_.instances().end(), std::back_inserter(engineDependentObjects), [](const SEditorObject& object) {
+		return object->isType<user_types::LuaScriptModule>() ||
+			   object->isType<user_types::LuaScript>() ||
+			   object->isType<user_types::LuaInterface>() ||
+			   object->isType<user_types::Material>();
+	});
+	std::stable_partition(engineDependentObjects.begin(), engineDependentObjects.end(), [](const SEditorObject& object) {
+		return object->isType<user_types::LuaScriptModule>();
+	});
+	context_->performExternalFileReload(engineDependentObjects);
+
+	// Link validity depends on the feature level of the linked properties.
+	context_->initLinkValidity();
+
+	LoadContext loadContext;
+	loadContext.featureLevel = featureLevel;
+	loadContext.pathStack.emplace_back(project_.currentPath());
+	context_->updateExternalReferences(loadContext);
+
+	undoStack_.reset();
+	dirty_ = true;
+}
+
 Project* RaCoProject::project() {
 	return &project_;
 }
@@ -14,6 +14,8 @@
 #include "application/RaCoApplication.h"
 #include "user_types/Animation.h"
 #include "user_types/AnimationChannel.h"
+#include "user_types/LuaScript.h"
+#include "user_types/LuaScriptModule.h"
 #include "user_types/Mesh.h"
 #include "user_types/Node.h"
 #include "user_types/Material.h"
@@ -21,7 +23,10 @@
 #include "ramses_adaptor/SceneBackend.h"
 #include "ramses_base/BaseEngineBackend.h"
 #include "testing/TestUtil.h"
+#include "core/ProjectMigration.h"
 #include "core/ProjectSettings.h"
+#include "core/SerializationKeys.h"
+#include "utils/FileUtils.h"
 
 using raco::application::RaCoApplication;
 using components::Naming;
@@ -65,6 +70,53 @@ TEST_F(RaCoApplicationFixture, feature_level_load_downgrade_fl_upgrade_raco_majo
 	EXPECT_EQ(backend.featureLevel(), ramses::EFeatureLevel::EFeatureLevel_01);
 }
 
+TEST_F(RaCoApplicationFixture, feature_level_upgrade_in_place_matches_load) {
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{serialization::keys::FILE_VERSION, {serialization::RAMSES_PROJECT_FILE_VERSION}},
+		{serialization::keys::RAMSES_VERSION, {0, 0, 0}},
+		{serialization::keys::RAMSES_COMPOSER_VERSION, {0, 0, 0}}};
+
+	application.switchActiveRaCoProject({}, {}, true, ramses_base::BaseEngineBackend::minFeatureLevel);
+	auto* commandInterface = application.activeRaCoProject().commandInterface();
+	auto module = commandInterface->createObject(user_types::LuaScriptModule::typeDescription.typeName, "module");
+	auto script = commandInterface->createObject(user_types::LuaScript::typeDescription.typeName, "script");
+	auto material = commandInterface->createObject(user_types::Material::typeDescription.typeName, "material");
+	auto node = commandInterface->createObject(user_types::Node::typeDescription.typeName, "node");
+	commandInterface->set({module, &user_types::LuaScriptModule::uri_}, (test_path() / "scripts/moduleDefinition.lua").string());
+	commandInterface->set({script, &user_types::LuaScript::uri_}, (test_path() / "scripts/moduleDependency.lua").string());
+	commandInterface->set({script, {"luaModules", "coalas"}}, module);
+	commandInterface->set({material, {"uriVertex"}}, (test_path() / "shaders" / "basic.vert").string());
+	commandInterface->set({material, {"uriFragment"}}, (test_path() / "shaders" / "basic.frag").string());
+	application.doOneLoop();
+
+	std::string msg;
+	auto projectPath = (test_path() / "project.rca").string();
+	ASSERT_TRUE(application.activeRaCoProject().saveAs(projectPath.c_str(), msg));
+
+	auto projectBefore = application.activeRaCoProject().project();
+	application.upgradeActiveProjectFeatureLevel(ramses_base::BaseEngineBackend::maxFeatureLevel);
+	EXPECT_EQ(application.activeRaCoProject().project(), projectBefore);
+	EXPECT_EQ(application.activeRaCoProject().project()->featureLevel(), ramses_base::BaseEngineBackend::maxFeatureLevel);
+	EXPECT_EQ(backend.featureLevel(), ramses_base::BaseEngineBackend::maxFeatureLevel);
+	EXPECT_FALSE(application.activeRaCoProject().undoStack()->canUndo());
+	auto upgraded = application.activeRaCoProject().serializeProjectData(versions);
+	auto upgradedSceneItems = application.sceneBackend()->getSceneItemDescriptions().size();
+
+	application.switchActiveRaCoProject(QString::fromStdString(projectPath), {}, false, ramses_base::BaseEngineBackend::maxFeatureLevel);
+	auto loaded = application.activeRaCoProject().serializeProjectData(versions);
+
+	EXPECT_EQ(upgraded.toJson().toStdString(), loaded.toJson().toStdString());
+	EXPECT_EQ(upgradedSceneItems, application.sceneBackend()->getSceneItemDescriptions().size());
+}
+
+TEST_F(RaCoApplicationFixture, feature_level_upgrade_in_place_downgrade_throws) {
+	if (ramses_base::BaseEngineBackend::minFeatureLevel < ramses_base::BaseEngineBackend::maxFeatureLevel) {
+		application.switchActiveRaCoProject({}, {}, true, ramses_base::BaseEngineBackend::maxFeatureLevel);
+		EXPECT_THROW(application.upgradeActiveProjectFeatureLevel(ramses_base::BaseEngineBackend::minFeatureLevel), std::runtime_error);
+	}
+	EXPECT_THROW(application.upgradeActiveProjectFeatureLevel(static_cast<int>(ramses_base::BaseEngineBackend::maxFeatureLevel) + 1), std::runtime_error);
+}
+
 TEST_F(RaCoApplicationFixture, exportNewProject) {
 	application.doOneLoop();
 
@@ -947,3 +999,65 @@ TEST_F(RaCoApplicationFixture, add_external_project_no_such_file) {
 	EXPECT_TRUE(application.externalProjects()->isExternalProject((test_path() / "no-such-file.rca").string()));
 	EXPECT_TRUE(application.externalProjects()->getExternalProject((test_path() / "no-such-file.rca").string()) == nullptr);
 }
+
+TEST_F(RaCoApplicationFixture, export_cache_hit_after_miss) {
+	application.doOneLoop();
+	application.setExportCacheDirectory((test_path() / "export-cache").string());
+
+	std::string error;
+	auto firstPath = (test_path() / "export-cache-first.ramses").string();
+	EXPECT_TRUE(application.exportProject(firstPath, false, error));
+	EXPECT_EQ(application.exportCache()->statistics().misses, 1);
+	EXPECT_EQ(application.exportCache()->statistics().hits, 0);
+	EXPECT_EQ(application.exportCache()->statistics().stored, 1);
+
+	auto secondPath = (test_path() / "export-cache-second.ramses").string();
+	EXPECT_TRUE(application.exportProject(secondPath, false, error));
+	EXPECT_EQ(application.exportCache()->statistics().misses, 1);
+	EXPECT_EQ(application.exportCache()->statistics().hits, 1);
+	EXPECT_EQ(utils::file::read(firstPath), utils::file::read(secondPath));
+
+	// Different export options need to be exported separately
+	EXPECT_TRUE(application.exportProject(secondPath, true, error));
+	EXPECT_EQ(application.exportCache()->statistics().misses, 2);
+}
+
+TEST_F(RaCoApplicationFixture, export_cache_fingerprint_changes_with_project_and_resources) {
+	auto* commandInterface = application.activeRaCoProject().commandInterface();
+	auto material = commandInterface->createObject(user_types::Material::typeDescription.typeName, "material");
+	commandInterface->set({material, {"uriVertex"}}, (test_path() / "shaders" / "basic.vert").string());
+	commandInterface->set({material, {"uriFragment"}}, (test_path() / "shaders" / "basic.frag").string());
+	application.doOneLoop();
+
+	auto initial = application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly);
+	EXPECT_EQ(initial, application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly));
+	EXPECT_NE(initial, application.exportFingerprint(false, false, raco::application::ELuaSavingMode::ByteCodeOnly));
+
+	auto node = commandInterface->createObject(user_types::Node::typeDescription.typeName, "node");
+	application.doOneLoop();
+	auto withNode = application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly);
+	EXPECT_NE(initial, withNode);
+
+	commandInterface->set({node, {"translation", "x"}}, 2.0);
+	application.doOneLoop();
+	auto withTranslation = application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly);
+	EXPECT_NE(withNode, withTranslation);
+
+	// Changing the contents of a resource file changes the fingerprint without any change to the project
+	auto shaderPath = test_path() / "shaders" / "basic.frag";
+	auto shaderContents = utils::file::read(shaderPath.string());
+	utils::file::write(shaderPath.string(), shaderContents + "\n// modified\n");
+	EXPECT_NE(withTranslation, application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly));
+	utils::file::write(shaderPath.string(), shaderContents);
+}
+
+TEST_F(RaCoApplicationFixture, export_cache_fingerprint_changes_with_export_optimizations) {
+	std::set<std::string> fingerprints{application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly)};
+
+	ramses_adaptor::ExportOptimizations optimizations;
+	ramses_adaptor::visitExportOptimizations(optimizations, [this, &optimizations, &fingerprints](const char* name, bool& value) {
+		value = true;
+		application.setExportOptimizations(optimizations);
+		EXPECT_TRUE(fingerprints.insert(application.exportFingerprint(false, false, raco::application::ELuaSavingMode::SourceCodeOnly)).second) << name;
+	});
+}
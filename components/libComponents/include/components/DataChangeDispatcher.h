@@ -65,6 +65,7 @@ class EditorObjectListener;
 class PropertyChangeListener;
 class ValueHandleListener;
 class UndoListener;
+class ChangesListener;
 class ChildrenListener;
 
 class DataChangeDispatcher {
@@ -77,6 +78,7 @@ public:
 	using ValueHandleCallback = std::function<void(const core::ValueHandle&)>;
 	using BulkChangeCallback = std::function<void(const core::SEditorObjectSet&)>;
 	using LinkCallback = std::function<void(const core::LinkDescriptor&)>;
+	using ChangesCallback = std::function<void(const core::DataChangeRecorder&)>;
 
 	explicit DataChangeDispatcher();
 
@@ -129,6 +131,9 @@ public:
 	// This will regisiter a callback which is invoked by dispatch() after all other changes have been dispatched.
 	Subscription registerOnAfterDispatch(Callback callback);
 
+	// This will register a callback which is invoked by dispatch() with the recorded changes before any changes are dispatched.
+	Subscription registerOnBeforeDispatch(ChangesCallback callback);
+
 	void addBulkChangeCallback(uint64_t ID, BulkChangeCallback callback);
 	void removeBulkChangeCallback(uint64_t ID);
 
@@ -178,6 +183,7 @@ private:
 	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> rootOrderChangedListeners_{};
 
 	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> onAfterDispatchListeners_{};
+	std::set<std::weak_ptr<ChangesListener>, std::owner_less<std::weak_ptr<ChangesListener>>> onBeforeDispatchListeners_{};
 
 	std::map<uint64_t, BulkChangeCallback> bulkChangeCallbacks_;
 };
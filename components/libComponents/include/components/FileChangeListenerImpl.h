@@ -12,13 +12,16 @@
 #include "core/FileChangeCallback.h"
 #include "core/FileChangeMonitor.h"
 
+#include "components/FileWatcherBackend.h"
+
 #include "utils/u8path.h"
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <map>
 
-#include <QFileSystemWatcher>
 #include <QTimer>
 
 #if (defined(Q_OS_WIN))
@@ -33,15 +36,31 @@ class FileChangeListenerImpl {
 public:
 	using Callback = std::function<void(const std::string& absPath)>;
 
-	FileChangeListenerImpl(const Callback &callbackHandler);
+	FileChangeListenerImpl(const Callback &callbackHandler, std::unique_ptr<FileWatcherBackend> backend = std::make_unique<QtFileWatcherBackend>());
 	virtual ~FileChangeListenerImpl();
 
 	void add(const std::string &absPath);
 	void remove(const std::string &absPath);
 
+	// Immediately process the pending file changes instead of waiting for the delayed load timer.
+	void processPendingChanges();
+
 	static constexpr int DELAYED_FILE_LOAD_TIME_MSEC = 100;
 
+	struct Statistics {
+		// Number of change callbacks invoked.
+		size_t notifiedChanges = 0;
+		// Number of file change events which were dropped because the file contents did not change.
+		size_t suppressedChanges = 0;
+		// Number of directory entries examined while handling directory change events.
+		size_t examinedDirectoryEntries = 0;
+	};
+
+	const Statistics& statistics() const;
+
 private:
+	// Watched files and their parent directories up to the root directory.
+	// The children of a directory node are its watched direct entries, i.e. files and directories.
 	struct Node {
 		Node(
 			utils::u8path path = {}, Node *parent = nullptr, bool isDirectory = true, bool didFileExistOnLastWatch = false)
@@ -53,6 +72,8 @@ private:
 		Node *parent_;
 		bool isDirectory_;
 		bool didFileExistOnLastWatch_;
+		// Digest of the file contents at the time of the last callback; empty if the file didn't exist or couldn't be read.
+		std::optional<FileDigest> digest_;
 	};
 
 	Node rootNode_;
@@ -61,28 +82,24 @@ private:
 
 	Callback fileChangeCallback_;
 
-	QFileSystemWatcher fileWatcher_;
+	std::unique_ptr<FileWatcherBackend> backend_;
 
 	QTimer delayedLoadTimer_;
 	std::set<utils::u8path> changedFiles_;
 
-	QMetaObject::Connection fileWatchConnection_;
-	QMetaObject::Connection directoryWatchConnection_;
+	Statistics statistics_;
+
 	QMetaObject::Connection delayedLoadTimerConnection_;
 
-	void addPathToWatch(const QString &path);
-	void installFileWatch(const utils::u8path &path);
+	void installWatch(const utils::u8path &path);
 	void launchDelayedLoad(const utils::u8path &path);
-	void onFileChanged(const QString &filePath);
+	void onFileChanged(const utils::u8path &filePath);
 	void onDelayedLoad();
-	void onDirectoryChanged(const QString &dirPath);
+	void onDirectoryChanged(const utils::u8path &dirPath);
 	Node *createDirectoryWatches(const utils::u8path &path);
 	void removeDirectoryWatches(Node* node);
-	Node *getNode(const utils::u8path &path);
-	void updateDirectoryWatches(Node *node);
-
-
-	static bool fileCanBeAccessed(const utils::u8path &path);
+	Node *findNode(const utils::u8path &path);
+	void updateDirectoryEntries(Node *node);
 };
 
 }  // namespace raco::components
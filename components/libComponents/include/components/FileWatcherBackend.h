@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "utils/u8path.h"
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+
+#include <functional>
+#include <optional>
+#include <set>
+
+namespace raco::components {
+
+// Size and hash of the file contents.
+struct FileDigest {
+	std::uintmax_t size;
+	QByteArray hash;
+
+	bool operator==(const FileDigest& other) const {
+		return size == other.size && hash == other.hash;
+	}
+};
+
+/**
+ * @brief File system access and change notifications used by the FileChangeListenerImpl.
+ *
+ * Allows to replace the file system in tests.
+ */
+class FileWatcherBackend {
+public:
+	using PathCallback = std::function<void(const utils::u8path& path)>;
+
+	virtual ~FileWatcherBackend() = default;
+
+	virtual void setHandlers(const PathCallback& fileChanged, const PathCallback& directoryChanged) = 0;
+
+	// @return true if the path is watched after the call.
+	virtual bool addWatch(const utils::u8path& path) = 0;
+	virtual bool removeWatch(const utils::u8path& path) = 0;
+	// Watches are dropped implicitly when the watched file or directory is removed.
+	virtual bool isWatched(const utils::u8path& path) const = 0;
+
+	virtual bool exists(const utils::u8path& path) const = 0;
+	virtual bool existsDirectory(const utils::u8path& path) const = 0;
+	// Check if the file can be opened for reading, i.e. is not opened for writing by another process.
+	virtual bool canBeAccessed(const utils::u8path& path) const = 0;
+	// @return digest of the file contents or empty if the file can't be read.
+	virtual std::optional<FileDigest> digest(const utils::u8path& path) const = 0;
+};
+
+/**
+ * @brief FileWatcherBackend for the real file system using a QFileSystemWatcher.
+ */
+class QtFileWatcherBackend : public FileWatcherBackend {
+public:
+	QtFileWatcherBackend();
+	~QtFileWatcherBackend() override;
+
+	void setHandlers(const PathCallback& fileChanged, const PathCallback& directoryChanged) override;
+
+	bool addWatch(const utils::u8path& path) override;
+	bool removeWatch(const utils::u8path& path) override;
+	bool isWatched(const utils::u8path& path) const override;
+
+	bool exists(const utils::u8path& path) const override;
+	bool existsDirectory(const utils::u8path& path) const override;
+	bool canBeAccessed(const utils::u8path& path) const override;
+	std::optional<FileDigest> digest(const utils::u8path& path) const override;
+
+private:
+	// Remove paths dropped by the QFileSystemWatcher from watchedPaths_.
+	void syncWatchState(const QString& path);
+
+	QFileSystemWatcher fileWatcher_;
+	// Mirror of the paths watched by the fileWatcher_ allowing fast lookup.
+	std::set<utils::u8path> watchedPaths_;
+
+	PathCallback fileChanged_;
+	PathCallback directoryChanged_;
+
+	QMetaObject::Connection fileWatchConnection_;
+	QMetaObject::Connection directoryWatchConnection_;
+};
+
+}  // namespace raco::components
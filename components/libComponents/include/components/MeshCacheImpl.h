@@ -36,6 +36,10 @@ public:
 
 	core::SharedSkinData loadSkin(const std::string& absPath, int skinIndex, std::string& outError) override;
 
+	// Apply the mesh optimization to all meshes loaded from now on, see core::MeshDescriptor::optimize.
+	void setOptimizeMeshes(bool optimize);
+	bool optimizeMeshes() const;
+
 private:
 	virtual void unregister(std::string absPath, typename core::MeshCache::Callback* listener) override;
 	virtual void notify(const std::string& absPath) override;
@@ -45,6 +49,7 @@ private:
 	void forceReloadCachedMesh(const std::string& absPath);
 
 	std::unordered_map<std::string, core::UniqueMeshCacheEntry> meshCacheEntries_;
+	bool optimizeMeshes_ = false;
 };
 
 }  // namespace raco::components
\ No newline at end of file
@@ -33,6 +33,20 @@ private:
 	Callback callback_;
 };
 
+class ChangesListener final : public BaseListener {
+	DEBUG_INSTANCE_COUNTER(ChangesListener);
+
+public:
+	using Callback = std::function<void(const DataChangeRecorder&)>;
+	explicit ChangesListener(Callback callback) : callback_{callback} {}
+	void call(const DataChangeRecorder& changes) const noexcept {
+		callback_(changes);
+	}
+
+private:
+	Callback callback_;
+};
+
 class ValueHandleListener final : public BaseListener {
 	DEBUG_INSTANCE_COUNTER(ValueHandleListener);
 
@@ -166,6 +180,12 @@ Subscription::~Subscription() {
 DataChangeDispatcher::DataChangeDispatcher() {}
 
 void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
+	for (auto& listener : onBeforeDispatchListeners_) {
+		if (!listener.expired()) {
+			listener.lock()->call(dataChanges);
+		}
+	}
+
 	// Sync with and reset change recorder:
 
 	emitLinksValidityChanged(dataChanges.getValidityChangedLinks());
@@ -237,7 +257,9 @@ void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
 		}
 	}
 
-	for (auto& listener : onAfterDispatchListeners_) {
+	// Listeners may add or remove subscriptions, e.g. by rebuilding views.
+	auto afterDispatchListeners{onAfterDispatchListeners_};
+	for (auto& listener : afterDispatchListeners) {
 		if (!listener.expired()) {
 			listener.lock()->call();
 		}
@@ -416,6 +438,14 @@ Subscription DataChangeDispatcher::registerOnAfterDispatch(Callback callback) {
 	}};
 }
 
+Subscription DataChangeDispatcher::registerOnBeforeDispatch(ChangesCallback callback) {
+	auto listener{std::make_shared<ChangesListener>(std::move(callback))};
+	onBeforeDispatchListeners_.insert(listener);
+	return Subscription{this, listener, [this, listener]() {
+		onBeforeDispatchListeners_.erase(listener);
+	}};
+}
+
 void DataChangeDispatcher::addBulkChangeCallback(uint64_t id, BulkChangeCallback callback) {
 	bulkChangeCallbacks_[id] = callback;
 }
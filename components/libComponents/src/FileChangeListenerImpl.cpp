@@ -14,49 +14,28 @@
 #include "core/PathManager.h"
 #include "log_system/log.h"
 
-#if (defined(OS_WINDOWS))
-#include <Windows.h>
-#elif (defined(OS_UNIX))
-#include <unistd.h>
-#include <fcntl.h>
-#endif
-
 namespace raco::components {
 
-FileChangeListenerImpl::FileChangeListenerImpl(const Callback& callbackHandler) 
-	: fileChangeCallback_(callbackHandler) {
+FileChangeListenerImpl::FileChangeListenerImpl(const Callback& callbackHandler, std::unique_ptr<FileWatcherBackend> backend)
+	: fileChangeCallback_(callbackHandler), backend_(std::move(backend)) {
 	delayedLoadTimer_.setInterval(DELAYED_FILE_LOAD_TIME_MSEC);
 	delayedLoadTimer_.setSingleShot(true);
 
-	fileWatchConnection_ = QObject::connect(&fileWatcher_, &QFileSystemWatcher::fileChanged, [this](const auto& filePath) { onFileChanged(filePath); });
-	directoryWatchConnection_ = QObject::connect(&fileWatcher_, &QFileSystemWatcher::directoryChanged, [this](const auto& dirPath) { onDirectoryChanged(dirPath); });
+	backend_->setHandlers(
+		[this](const utils::u8path& filePath) { onFileChanged(filePath); },
+		[this](const utils::u8path& dirPath) { onDirectoryChanged(dirPath); });
 	delayedLoadTimerConnection_ = QObject::connect(&delayedLoadTimer_, &QTimer::timeout, [this]() { onDelayedLoad(); });
 }
 
 FileChangeListenerImpl::~FileChangeListenerImpl() {
-	QObject::disconnect(fileWatchConnection_);
-	QObject::disconnect(directoryWatchConnection_);
+	backend_->setHandlers({}, {});
 	QObject::disconnect(delayedLoadTimerConnection_);
 	delayedLoadTimer_.stop();
 }
 
-void FileChangeListenerImpl::addPathToWatch(const QString& path) {
-	auto pathSuccessfullyAdded = fileWatcher_.addPath(path);
-	if (!pathSuccessfullyAdded) {
-		LOG_DEBUG(log_system::RAMSES_BACKEND, "Could not add path {} to file change listener", path.toLatin1());
-	} else {
-		LOG_DEBUG(log_system::RAMSES_BACKEND, "Added path {} to file change listener", path.toLatin1());
-	}
-}
-
-void FileChangeListenerImpl::installFileWatch(const utils::u8path& path) {
-	if (path.exists()) {
-		auto pathQtString = QString::fromStdString(path.string());
-		auto fileWatcherContainsFilePath = fileWatcher_.files().contains(pathQtString);
-
-		if (!fileWatcherContainsFilePath) {
-			addPathToWatch(pathQtString);
-		}
+void FileChangeListenerImpl::installWatch(const utils::u8path& path) {
+	if (!backend_->isWatched(path)) {
+		backend_->addWatch(path);
 	}
 }
 
@@ -67,20 +46,30 @@ void FileChangeListenerImpl::add(const std::string& absPath) {
 	auto directoryNode = createDirectoryWatches(path.parent_path());
 
 	// create file watcher and insert into direct parent directory
-	installFileWatch(path);
-	auto [it, success] = directoryNode->children_.insert({path, std::make_unique<Node>(path, directoryNode, false, path.exists())});
+	bool exists = backend_->exists(path);
+	if (exists) {
+		installWatch(path);
+	}
+	auto [it, success] = directoryNode->children_.insert({path, std::make_unique<Node>(path, directoryNode, false, exists)});
+	if (success) {
+		it->second->digest_ = exists ? backend_->digest(path) : std::nullopt;
+	}
 	watchedFiles_[path] = it->second.get();
 }
 
+const FileChangeListenerImpl::Statistics& FileChangeListenerImpl::statistics() const {
+	return statistics_;
+}
+
 FileChangeListenerImpl::Node* FileChangeListenerImpl::createDirectoryWatches(const utils::u8path& path) {
 	if (path != path.root_path()) {
 		auto node = createDirectoryWatches(path.parent_path());
 
 		auto it = node->children_.find(path);
 		if (it == node->children_.end()) {
-			bool exists = path.existsDirectory();
+			bool exists = backend_->existsDirectory(path);
 			if (exists) {
-				addPathToWatch(QString::fromStdString(path.string()));
+				installWatch(path);
 			}
 			auto [newIt, success] = node->children_.insert({path, std::make_unique<Node>(path, node, true, exists)});
 			return newIt->second.get();
@@ -91,34 +80,29 @@ FileChangeListenerImpl::Node* FileChangeListenerImpl::createDirectoryWatches(con
 	return &rootNode_;
 }
 
-FileChangeListenerImpl::Node* FileChangeListenerImpl::getNode(const utils::u8path& path) {
+FileChangeListenerImpl::Node* FileChangeListenerImpl::findNode(const utils::u8path& path) {
 	if (path != path.root_path()) {
-		auto node = getNode(path.parent_path());
-
-		auto it = node->children_.find(path);
-		assert(it != node->children_.end());
-		return it->second.get();
-	}
-	return &rootNode_;
-}
-
-
-void FileChangeListenerImpl::updateDirectoryWatches(Node* node) {
-	if (node->isDirectory_ && node->path_.existsDirectory()) {
-		addPathToWatch(QString::fromStdString(node->path_.string()));
-		for (const auto& [dummy, childNode] : node->children_) {
-			updateDirectoryWatches(childNode.get());
+		auto node = findNode(path.parent_path());
+		if (node) {
+			auto it = node->children_.find(path);
+			if (it != node->children_.end()) {
+				return it->second.get();
+			}
 		}
+		return nullptr;
 	}
+	return &rootNode_;
 }
 
 void FileChangeListenerImpl::remove(const std::string& absPath) {
 	const utils::u8path& path(absPath);
-	if (fileWatcher_.removePath(QString::fromStdString(path.string()))) {
+	auto it = watchedFiles_.find(path);
+	if (it != watchedFiles_.end()) {
+		backend_->removeWatch(path);
 
 		// remove file node and all parent directories which have no child nodes anymore
-		auto fileNode = watchedFiles_[path];
-		watchedFiles_.erase(path);
+		auto fileNode = it->second;
+		watchedFiles_.erase(it);
 
 		auto parentNode = fileNode->parent_;
 		parentNode->children_.erase(path);
@@ -128,7 +112,7 @@ void FileChangeListenerImpl::remove(const std::string& absPath) {
 
 void FileChangeListenerImpl::removeDirectoryWatches(Node* node) {
 	if (node->children_.empty() && node != &rootNode_) {
-		fileWatcher_.removePath(QString::fromStdString(node->path_.string()));
+		backend_->removeWatch(node->path_);
 	
 		auto parentNode = node->parent_;
 		parentNode->children_.erase(node->path_);
@@ -143,64 +127,73 @@ void FileChangeListenerImpl::launchDelayedLoad(const utils::u8path& path) {
 	LOG_DEBUG(log_system::RAMSES_BACKEND, "Launched delayed file watch loading");
 }
 
-void FileChangeListenerImpl::onFileChanged(const QString& filePath) {
-	launchDelayedLoad(filePath.toStdString());
+void FileChangeListenerImpl::processPendingChanges() {
+	if (!changedFiles_.empty()) {
+		delayedLoadTimer_.stop();
+		onDelayedLoad();
+	}
+}
+
+void FileChangeListenerImpl::onFileChanged(const utils::u8path& filePath) {
+	launchDelayedLoad(filePath);
 }
 
 void FileChangeListenerImpl::onDelayedLoad() {
-#if (defined(OS_WINDOWS) || defined(OS_UNIX))
 	for (const auto& path : changedFiles_) {
-
 		auto it = watchedFiles_.find(path);
 		if (it != watchedFiles_.end()) {
-			it->second->didFileExistOnLastWatch_ = path.exists();
-			if (!it->second->didFileExistOnLastWatch_ || fileCanBeAccessed(path)) {
+			auto node = it->second;
+			node->didFileExistOnLastWatch_ = backend_->exists(path);
+			if (!node->didFileExistOnLastWatch_ || backend_->canBeAccessed(path)) {
+				auto digest = node->didFileExistOnLastWatch_ ? backend_->digest(path) : std::nullopt;
+				if (digest == node->digest_) {
+					++statistics_.suppressedChanges;
+					LOG_DEBUG(log_system::RAMSES_BACKEND, "Suppressed file change callback for unchanged file {}", path.string());
+					continue;
+				}
+				node->digest_ = digest;
+				++statistics_.notifiedChanges;
 				fileChangeCallback_(path.string());
 			}
 		}
 	}
-#else
-	fileChangeCallback_();
-#endif
 
 	changedFiles_.clear();
 }
 
-void FileChangeListenerImpl::onDirectoryChanged(const QString& dirPathString) {
-	utils::u8path dirPath(dirPathString.toStdString());
-	if (auto node = getNode(dirPath)) {
-		updateDirectoryWatches(node);
-	}
-	for (const auto& [path, entry] : watchedFiles_) {
-		if (dirPath.contains(path)) {
-			if (path.exists() != entry->didFileExistOnLastWatch_) {
-				launchDelayedLoad(path);
-			}
-			installFileWatch(path);
-		}
+void FileChangeListenerImpl::onDirectoryChanged(const utils::u8path& dirPath) {
+	auto node = findNode(dirPath);
+	if (node && node != &rootNode_) {
+		updateDirectoryEntries(node);
 	}
 }
 
-bool FileChangeListenerImpl::fileCanBeAccessed(const utils::u8path& path) {
-#if (defined(OS_WINDOWS))
-	auto fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
-
-	if (fileHandle && fileHandle != INVALID_HANDLE_VALUE) {
-		CloseHandle(fileHandle);
-		return true;
+void FileChangeListenerImpl::updateDirectoryEntries(Node* directoryNode) {
+	// Only the direct entries of the directory are examined. Nested directories are only
+	// descended into if they appeared, disappeared or lost their watch.
+	bool exists = backend_->existsDirectory(directoryNode->path_);
+	directoryNode->didFileExistOnLastWatch_ = exists;
+	if (exists) {
+		installWatch(directoryNode->path_);
 	}
 
-	LOG_DEBUG(log_system::RAMSES_BACKEND, "Windows could not access file {} - it seems to be opened for writing by another process right now.", path.string());
-#elif (defined(OS_UNIX))
-	auto fileDescriptor = open(path.string().c_str(), O_RDONLY);
-	if (fileDescriptor > 0) {
-		close(fileDescriptor);
-		return true;
+	for (const auto& [path, entry] : directoryNode->children_) {
+		++statistics_.examinedDirectoryEntries;
+		if (entry->isDirectory_) {
+			bool entryExists = exists && backend_->existsDirectory(path);
+			if (entryExists != entry->didFileExistOnLastWatch_ || (entryExists && !backend_->isWatched(path))) {
+				updateDirectoryEntries(entry.get());
+			}
+		} else {
+			bool entryExists = exists && backend_->exists(path);
+			if (entryExists != entry->didFileExistOnLastWatch_) {
+				launchDelayedLoad(path);
+			}
+			if (entryExists) {
+				installWatch(path);
+			}
+		}
 	}
-
-	LOG_DEBUG(log_system::RAMSES_BACKEND, "Linux could not access file {} - {}", path.string(), strerror(errno));
-#endif
-	return false;
 }
 
-}  // namespace raco::components
\ No newline at end of file
+}  // namespace raco::components
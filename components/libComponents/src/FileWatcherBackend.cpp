@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "components/FileWatcherBackend.h"
+
+#include "log_system/log.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+
+#if (defined(Q_OS_WIN))
+#include <Windows.h>
+#elif (defined(Q_OS_UNIX) || defined(Q_OS_LINUX))
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace raco::components {
+
+QtFileWatcherBackend::QtFileWatcherBackend() {
+	fileWatchConnection_ = QObject::connect(&fileWatcher_, &QFileSystemWatcher::fileChanged, [this](const QString& filePath) {
+		syncWatchState(filePath);
+		if (fileChanged_) {
+			fileChanged_(filePath.toStdString());
+		}
+	});
+	directoryWatchConnection_ = QObject::connect(&fileWatcher_, &QFileSystemWatcher::directoryChanged, [this](const QString& dirPath) {
+		syncWatchState(dirPath);
+		if (directoryChanged_) {
+			directoryChanged_(dirPath.toStdString());
+		}
+	});
+}
+
+QtFileWatcherBackend::~QtFileWatcherBackend() {
+	QObject::disconnect(fileWatchConnection_);
+	QObject::disconnect(directoryWatchConnection_);
+}
+
+void QtFileWatcherBackend::setHandlers(const PathCallback& fileChanged, const PathCallback& directoryChanged) {
+	fileChanged_ = fileChanged;
+	directoryChanged_ = directoryChanged;
+}
+
+bool QtFileWatcherBackend::addWatch(const utils::u8path& path) {
+	if (watchedPaths_.find(path) != watchedPaths_.end()) {
+		return true;
+	}
+	auto pathQtString = QString::fromStdString(path.string());
+	if (!fileWatcher_.addPath(pathQtString)) {
+		LOG_DEBUG(log_system::RAMSES_BACKEND, "Could not add path {} to file change listener", path.string());
+		return false;
+	}
+	LOG_DEBUG(log_system::RAMSES_BACKEND, "Added path {} to file change listener", path.string());
+	watchedPaths_.insert(path);
+	return true;
+}
+
+bool QtFileWatcherBackend::removeWatch(const utils::u8path& path) {
+	watchedPaths_.erase(path);
+	return fileWatcher_.removePath(QString::fromStdString(path.string()));
+}
+
+bool QtFileWatcherBackend::isWatched(const utils::u8path& path) const {
+	return watchedPaths_.find(path) != watchedPaths_.end();
+}
+
+void QtFileWatcherBackend::syncWatchState(const QString& path) {
+	// The QFileSystemWatcher stops watching removed files and directories.
+	if (!fileWatcher_.files().contains(path) && !fileWatcher_.directories().contains(path)) {
+		watchedPaths_.erase(path.toStdString());
+	}
+}
+
+bool QtFileWatcherBackend::exists(const utils::u8path& path) const {
+	return path.exists();
+}
+
+bool QtFileWatcherBackend::existsDirectory(const utils::u8path& path) const {
+	return path.existsDirectory();
+}
+
+bool QtFileWatcherBackend::canBeAccessed(const utils::u8path& path) const {
+#if (defined(Q_OS_WIN))
+	auto fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+
+	if (fileHandle && fileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(fileHandle);
+		return true;
+	}
+
+	LOG_DEBUG(log_system::RAMSES_BACKEND, "Windows could not access file {} - it seems to be opened for writing by another process right now.", path.string());
+#elif (defined(Q_OS_UNIX) || defined(Q_OS_LINUX))
+	auto fileDescriptor = open(path.string().c_str(), O_RDONLY);
+	if (fileDescriptor > 0) {
+		close(fileDescriptor);
+		return true;
+	}
+
+	LOG_DEBUG(log_system::RAMSES_BACKEND, "Linux could not access file {} - {}", path.string(), strerror(errno));
+#endif
+	return false;
+}
+
+std::optional<FileDigest> QtFileWatcherBackend::digest(const utils::u8path& path) const {
+	QFile file(QString::fromStdString(path.string()));
+	if (!file.open(QIODevice::ReadOnly)) {
+		return std::nullopt;
+	}
+	// The hash is only used for change detection: use the fast MD5 algorithm.
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	if (!hash.addData(&file)) {
+		return std::nullopt;
+	}
+	return FileDigest{static_cast<std::uintmax_t>(file.size()), hash.result()};
+}
+
+}  // namespace raco::components
@@ -53,9 +53,22 @@ void MeshCacheImpl::notify(const std::string& absPath) {
 core::SharedMeshData MeshCacheImpl::loadMesh(const core::MeshDescriptor &descriptor) {
 	auto *loader = getLoader(descriptor.absPath);
 	assert(loader != nullptr);
+	if (optimizeMeshes_ && !descriptor.optimize) {
+		auto optimizedDescriptor = descriptor;
+		optimizedDescriptor.optimize = true;
+		return loader->loadMesh(optimizedDescriptor);
+	}
 	return loader->loadMesh(descriptor);
 }
 
+void MeshCacheImpl::setOptimizeMeshes(bool optimize) {
+	optimizeMeshes_ = optimize;
+}
+
+bool MeshCacheImpl::optimizeMeshes() const {
+	return optimizeMeshes_;
+}
+
 const core::MeshScenegraph *components::MeshCacheImpl::getMeshScenegraph(const std::string &absPath) {
 	auto *loader = getLoader(absPath);
 	assert(loader != nullptr);
@@ -0,0 +1,308 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "gtest/gtest.h"
+
+#include "components/FileChangeListenerImpl.h"
+#include "utils/u8path.h"
+
+#include <QCoreApplication>
+
+#include <map>
+#include <optional>
+#include <set>
+
+using namespace raco;
+using components::FileChangeListenerImpl;
+using components::FileDigest;
+using components::FileWatcherBackend;
+
+// In-memory file system which counts the file system queries.
+class FakeFileWatcherBackend : public FileWatcherBackend {
+public:
+	void setHandlers(const PathCallback& fileChanged, const PathCallback& directoryChanged) override {
+		fileChanged_ = fileChanged;
+		directoryChanged_ = directoryChanged;
+	}
+
+	bool addWatch(const utils::u8path& path) override {
+		if (files_.find(path) != files_.end() || directories_.find(path) != directories_.end()) {
+			watched_.insert(path);
+			return true;
+		}
+		return false;
+	}
+
+	bool removeWatch(const utils::u8path& path) override {
+		return watched_.erase(path) > 0;
+	}
+
+	bool isWatched(const utils::u8path& path) const override {
+		return watched_.find(path) != watched_.end();
+	}
+
+	bool exists(const utils::u8path& path) const override {
+		++queries_;
+		return files_.find(path) != files_.end() || directories_.find(path) != directories_.end();
+	}
+
+	bool existsDirectory(const utils::u8path& path) const override {
+		++queries_;
+		return directories_.find(path) != directories_.end();
+	}
+
+	bool canBeAccessed(const utils::u8path& path) const override {
+		return files_.find(path) != files_.end();
+	}
+
+	std::optional<FileDigest> digest(const utils::u8path& path) const override {
+		auto it = files_.find(path);
+		if (it != files_.end()) {
+			return FileDigest{it->second.size(), QByteArray::fromStdString(it->second)};
+		}
+		return std::nullopt;
+	}
+
+	// File system modifications: these emit the same events as the QFileSystemWatcher.
+
+	void createDirectory(const utils::u8path& path) {
+		directories_.insert(path);
+		notifyDirectory(path.parent_path());
+	}
+
+	void writeFile(const utils::u8path& path, const std::string& contents) {
+		bool existed = files_.find(path) != files_.end();
+		files_[path] = contents;
+		if (existed) {
+			notifyFile(path);
+		} else {
+			notifyDirectory(path.parent_path());
+		}
+	}
+
+	void removeFile(const utils::u8path& path) {
+		files_.erase(path);
+		notifyFile(path);
+		notifyDirectory(path.parent_path());
+	}
+
+	void renameDirectory(const utils::u8path& from, const utils::u8path& to) {
+		std::map<utils::u8path, std::string> movedFiles;
+		for (const auto& [path, contents] : files_) {
+			movedFiles[relocate(path, from, to).value_or(path)] = contents;
+		}
+		files_ = movedFiles;
+
+		std::set<utils::u8path> movedDirectories;
+		for (const auto& path : directories_) {
+			movedDirectories.insert(relocate(path, from, to).value_or(path));
+		}
+		directories_ = movedDirectories;
+
+		// Watches of moved paths are dropped
+		for (auto it = watched_.begin(); it != watched_.end();) {
+			if (relocate(*it, from, to)) {
+				it = watched_.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		notifyDirectory(from.parent_path());
+		if (to.parent_path() != from.parent_path()) {
+			notifyDirectory(to.parent_path());
+		}
+	}
+
+	size_t queries() const {
+		return queries_;
+	}
+
+	void resetQueries() {
+		queries_ = 0;
+	}
+
+private:
+	// Map a path inside the directory 'from' to the corresponding path inside 'to'.
+	static std::optional<utils::u8path> relocate(const utils::u8path& path, const utils::u8path& from, const utils::u8path& to) {
+		auto pathString = path.string();
+		auto fromString = from.string();
+		if (pathString == fromString) {
+			return to;
+		}
+		if (pathString.rfind(fromString + "/", 0) == 0) {
+			return utils::u8path(to.string() + pathString.substr(fromString.size()));
+		}
+		return std::nullopt;
+	}
+
+	void notifyFile(const utils::u8path& path) {
+		if (isWatched(path)) {
+			if (files_.find(path) == files_.end()) {
+				watched_.erase(path);
+			}
+			fileChanged_(path);
+		}
+	}
+
+	void notifyDirectory(const utils::u8path& path) {
+		if (isWatched(path)) {
+			directoryChanged_(path);
+		}
+	}
+
+	std::map<utils::u8path, std::string> files_;
+	std::set<utils::u8path> directories_;
+	std::set<utils::u8path> watched_;
+	mutable size_t queries_ = 0;
+
+	PathCallback fileChanged_;
+	PathCallback directoryChanged_;
+};
+
+class FileChangeListenerTest : public testing::Test {
+protected:
+	void SetUp() override {
+		auto backend = std::make_unique<FakeFileWatcherBackend>();
+		fs_ = backend.get();
+		fs_->createDirectory(root_);
+		listener_ = std::make_unique<FileChangeListenerImpl>([this](const std::string& absPath) { ++callbacks_[absPath]; }, std::move(backend));
+	}
+
+	int callbackCount(const utils::u8path& path) {
+		auto it = callbacks_.find(path.string());
+		return it != callbacks_.end() ? it->second : 0;
+	}
+
+	int totalCallbackCount() {
+		int count = 0;
+		for (const auto& [path, pathCount] : callbacks_) {
+			count += pathCount;
+		}
+		return count;
+	}
+
+	int argc = 0;
+	// Needed for the delayed load timer.
+	QCoreApplication eventLoop_{argc, nullptr};
+
+	utils::u8path root_{"/fake-root"};
+	FakeFileWatcherBackend* fs_;
+	std::unique_ptr<FileChangeListenerImpl> listener_;
+	std::map<std::string, int> callbacks_;
+};
+
+TEST_F(FileChangeListenerTest, file_modification) {
+	auto file = root_ / "file.txt";
+	fs_->writeFile(file, "a");
+	listener_->add(file.string());
+
+	fs_->writeFile(file, "b");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 1);
+	EXPECT_EQ(listener_->statistics().notifiedChanges, 1);
+}
+
+TEST_F(FileChangeListenerTest, file_modification_unchanged_contents_suppressed) {
+	auto file = root_ / "file.txt";
+	fs_->writeFile(file, "a");
+	listener_->add(file.string());
+
+	fs_->writeFile(file, "a");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 0);
+	EXPECT_EQ(listener_->statistics().suppressedChanges, 1);
+}
+
+TEST_F(FileChangeListenerTest, file_creation_and_removal) {
+	auto dir = root_ / "dir";
+	auto file = dir / "file.txt";
+	fs_->createDirectory(dir);
+	listener_->add(file.string());
+
+	fs_->writeFile(file, "");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 1);
+
+	fs_->removeFile(file);
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 2);
+
+	// Recreating with identical contents is a change since the file was missing
+	fs_->writeFile(file, "");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 3);
+}
+
+TEST_F(FileChangeListenerTest, file_creation_in_missing_directory) {
+	auto dir = root_ / "dir";
+	auto file = dir / "file.txt";
+	listener_->add(file.string());
+
+	fs_->createDirectory(dir);
+	listener_->processPendingChanges();
+	EXPECT_EQ(totalCallbackCount(), 0);
+
+	fs_->writeFile(file, "");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 1);
+}
+
+TEST_F(FileChangeListenerTest, directory_rename_notifies_nested_files) {
+	auto dir = root_ / "dir";
+	auto nested = dir / "nested";
+	auto file = dir / "file.txt";
+	auto nestedFile = nested / "file.txt";
+	fs_->createDirectory(dir);
+	fs_->createDirectory(nested);
+	fs_->writeFile(file, "a");
+	fs_->writeFile(nestedFile, "b");
+	listener_->add(file.string());
+	listener_->add(nestedFile.string());
+
+	fs_->renameDirectory(dir, root_ / "moved");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 1);
+	EXPECT_EQ(callbackCount(nestedFile), 1);
+
+	fs_->renameDirectory(root_ / "moved", dir);
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(file), 2);
+	EXPECT_EQ(callbackCount(nestedFile), 2);
+
+	// Watches have been reinstalled
+	fs_->writeFile(nestedFile, "c");
+	listener_->processPendingChanges();
+	EXPECT_EQ(callbackCount(nestedFile), 3);
+}
+
+TEST_F(FileChangeListenerTest, directory_event_examines_direct_entries_only) {
+	const int numFiles = 1000;
+	auto busyDir = root_ / "busy";
+	auto otherDir = root_ / "other";
+	fs_->createDirectory(busyDir);
+	fs_->createDirectory(otherDir);
+	for (int index = 0; index < numFiles; index++) {
+		auto file = busyDir / ("file" + std::to_string(index) + ".txt");
+		fs_->writeFile(file, "");
+		listener_->add(file.string());
+	}
+	auto otherFile = otherDir / "file.txt";
+	listener_->add(otherFile.string());
+
+	fs_->resetQueries();
+	auto examinedBefore = listener_->statistics().examinedDirectoryEntries;
+	fs_->writeFile(otherFile, "");
+	listener_->processPendingChanges();
+
+	EXPECT_EQ(callbackCount(otherFile), 1);
+	EXPECT_EQ(listener_->statistics().examinedDirectoryEntries - examinedBefore, 1);
+	// Directory itself and its single entry in the event handling, the file in the delayed load
+	EXPECT_LE(fs_->queries(), 3);
+}
@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raco::mesh_loader {
+
+/**
+ * Deterministic CPU optimization of indexed triangle meshes.
+ *
+ * The vertex data is given as a set of float streams with a fixed number of components per vertex, e.g. one stream
+ * per vertex attribute. All streams must contain the same number of vertices.
+ * The optimizations only change the order and the number of vertices and the order of the triangles; the set of
+ * triangles with their attribute values is unchanged.
+ */
+struct VertexStream {
+	std::vector<float>* data;
+	size_t components;
+};
+
+struct VertexCacheStatistics {
+	// Average cache miss ratio: vertex shader invocations per triangle. Between 0.5 (best) and 3 (worst).
+	double acmr = 0.0;
+	// Average transform to vertex ratio: vertex shader invocations per vertex. 1 is optimal.
+	double atvr = 0.0;
+};
+
+struct VertexFetchStatistics {
+	// Bytes fetched from the vertex buffer divided by the vertex buffer size. 1 is optimal; depends only on the
+	// vertex order and the index buffer but not on the rasterization (overdraw).
+	double overfetch = 0.0;
+};
+
+struct MeshOptimizationStatistics {
+	uint32_t verticesBefore = 0;
+	uint32_t verticesAfter = 0;
+	VertexCacheStatistics cacheBefore;
+	VertexCacheStatistics cacheAfter;
+	VertexFetchStatistics fetchBefore;
+	VertexFetchStatistics fetchAfter;
+};
+
+// Simulate a FIFO post-transform vertex cache of the given size.
+VertexCacheStatistics analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+// Simulate vertex fetching through a small LRU cache of cache lines.
+VertexFetchStatistics analyzeVertexFetch(const std::vector<uint32_t>& indices, uint32_t vertexCount, size_t vertexSize);
+
+// Merge vertices with bitwise identical values in all streams. Returns the remap table from old to new vertex index;
+// the unique vertices are numbered in the order of their first occurrence.
+std::vector<uint32_t> generateWeldRemap(const std::vector<VertexStream>& streams, uint32_t vertexCount, uint32_t& outUniqueVertexCount);
+
+// Reorder the triangles to improve the post-transform vertex cache hit rate (Forsyth's linear-speed algorithm).
+void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+// Returns the remap table ordering the vertices by their first use in the index buffer. Unused vertices are moved to the end.
+std::vector<uint32_t> generateVertexFetchRemap(const std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+void remapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap);
+void remapVertexStream(const VertexStream& stream, const std::vector<uint32_t>& remap, uint32_t newVertexCount);
+
+// Run vertex welding, vertex cache and vertex fetch optimization. The index buffer must be a triangle list.
+MeshOptimizationStatistics optimizeMesh(std::vector<uint32_t>& indices, const std::vector<VertexStream>& streams, uint32_t& vertexCount);
+
+}  // namespace raco::mesh_loader
@@ -0,0 +1,52 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tinygltf {
+class TinyGLTF;
+class Model;
+}  // namespace tinygltf
+
+namespace raco::mesh_loader {
+
+struct glTFLoadStatistics {
+	// Number of external buffer files read and number of base64 data URI buffers decoded by the worker threads
+	size_t bufferFiles = 0;
+	size_t dataUriBuffers = 0;
+	// Number of images which were not decoded
+	size_t skippedImages = 0;
+};
+
+/**
+ * Loads a .gltf or .glb file into a tinygltf model.
+ *
+ * In contrast to TinyGLTF::LoadASCIIFromFile/LoadBinaryFromFile the external buffer files are read and the base64
+ * data URIs of the buffers are decoded on multiple threads before tinygltf parses the file. Images are never decoded
+ * since they are not used by the mesh loader. The resulting model has the same structure and buffer contents as the
+ * one loaded by tinygltf itself, including the original buffer and image URIs; only the image pixel data is missing.
+ *
+ * Falls back to the plain tinygltf loader if the file can't be preprocessed, e.g. because of a JSON syntax error,
+ * to get the tinygltf error messages. Only this fallback uses the passed importer; its file system callbacks are
+ * never changed.
+ *
+ * @param threadCount Maximum number of worker threads; 0 uses the hardware concurrency.
+ */
+bool loadglTFModel(tinygltf::TinyGLTF& importer, tinygltf::Model& model, std::string& err, std::string& warn, const std::string& absPath, unsigned threadCount = 0, glTFLoadStatistics* statistics = nullptr);
+
+// Decodes the base64 payload of a "data:<media type>;base64,<payload>" URI. Returns nullopt for other URIs or invalid payloads.
+std::optional<std::vector<unsigned char>> decodeBase64DataUri(std::string_view uri);
+
+}  // namespace raco::mesh_loader
@@ -70,6 +70,8 @@ private:
 		glm::dmat4* globalModelMatrix = nullptr,
 		glm::dmat4* globalNormalMatrix = nullptr);
 
+	void optimizeMeshData();
+
 	uint32_t numTriangles_;
 	uint32_t numVertices_;
 
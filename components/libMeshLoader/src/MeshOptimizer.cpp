@@ -0,0 +1,360 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "mesh_loader/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace raco::mesh_loader {
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+// Parameters of the vertex cache optimization, see Tom Forsyth, "Linear-Speed Vertex Cache Optimisation".
+constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+constexpr float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+// Parameters of the vertex fetch simulation
+constexpr size_t FETCH_CACHE_LINE_SIZE = 64;
+constexpr uint32_t FETCH_CACHE_LINES = 16;
+
+float forsythVertexScore(int cachePosition, uint32_t remainingValence) {
+	if (remainingValence == 0) {
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cachePosition >= 0) {
+		if (cachePosition < 3) {
+			// The vertices of the last triangle get a fixed score to avoid favouring the triangle just emitted.
+			score = FORSYTH_LAST_TRIANGLE_SCORE;
+		} else {
+			const float scaler = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+			score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+	// Prefer vertices with few remaining triangles to avoid leaving isolated triangles behind.
+	score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingValence), -FORSYTH_VALENCE_BOOST_POWER);
+	return score;
+}
+
+size_t hashVertex(const std::vector<VertexStream>& streams, uint32_t vertex) {
+	// FNV-1a over the bit patterns of all components
+	uint64_t hash = 14695981039346656037ull;
+	for (const auto& stream : streams) {
+		const float* values = stream.data->data() + vertex * stream.components;
+		for (size_t component = 0; component < stream.components; component++) {
+			uint32_t bits;
+			std::memcpy(&bits, &values[component], sizeof(bits));
+			hash = (hash ^ bits) * 1099511628211ull;
+		}
+	}
+	return static_cast<size_t>(hash);
+}
+
+bool verticesEqual(const std::vector<VertexStream>& streams, uint32_t first, uint32_t second) {
+	for (const auto& stream : streams) {
+		const float* data = stream.data->data();
+		if (std::memcmp(data + first * stream.components, data + second * stream.components, stream.components * sizeof(float)) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+VertexCacheStatistics analyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+	VertexCacheStatistics result;
+	if (indices.size() < 3) {
+		return result;
+	}
+
+	// A vertex is in the FIFO cache if fewer than cacheSize misses happened since it was last transformed.
+	std::vector<uint32_t> timestamps(vertexCount, 0);
+	std::vector<bool> used(vertexCount, false);
+	uint32_t time = cacheSize + 1;
+	uint32_t misses = 0;
+	uint32_t usedVertices = 0;
+	for (auto index : indices) {
+		assert(index < vertexCount);
+		if (time - timestamps[index] > cacheSize) {
+			timestamps[index] = time++;
+			misses++;
+		}
+		if (!used[index]) {
+			used[index] = true;
+			usedVertices++;
+		}
+	}
+
+	result.acmr = static_cast<double>(misses) / static_cast<double>(indices.size() / 3);
+	result.atvr = static_cast<double>(misses) / static_cast<double>(usedVertices);
+	return result;
+}
+
+VertexFetchStatistics analyzeVertexFetch(const std::vector<uint32_t>& indices, uint32_t vertexCount, size_t vertexSize) {
+	VertexFetchStatistics result;
+	if (indices.empty() || vertexCount == 0 || vertexSize == 0) {
+		return result;
+	}
+
+	// Cache line -> time of the last access
+	std::unordered_map<size_t, uint64_t> cache;
+	uint64_t time = 0;
+	size_t fetchedBytes = 0;
+	for (auto index : indices) {
+		size_t firstLine = (index * vertexSize) / FETCH_CACHE_LINE_SIZE;
+		size_t lastLine = ((index + 1) * vertexSize - 1) / FETCH_CACHE_LINE_SIZE;
+		for (size_t line = firstLine; line <= lastLine; line++) {
+			++time;
+			auto it = cache.find(line);
+			if (it != cache.end()) {
+				it->second = time;
+				continue;
+			}
+			fetchedBytes += FETCH_CACHE_LINE_SIZE;
+			if (cache.size() == FETCH_CACHE_LINES) {
+				auto oldest = cache.begin();
+				for (auto entry = cache.begin(); entry != cache.end(); ++entry) {
+					if (entry->second < oldest->second) {
+						oldest = entry;
+					}
+				}
+				cache.erase(oldest);
+			}
+			cache.emplace(line, time);
+		}
+	}
+
+	result.overfetch = static_cast<double>(fetchedBytes) / static_cast<double>(vertexCount * vertexSize);
+	return result;
+}
+
+std::vector<uint32_t> generateWeldRemap(const std::vector<VertexStream>& streams, uint32_t vertexCount, uint32_t& outUniqueVertexCount) {
+	std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+	// Hash -> original index of the first vertex with this hash
+	std::unordered_multimap<size_t, uint32_t> uniqueVertices;
+	uniqueVertices.reserve(vertexCount);
+
+	outUniqueVertexCount = 0;
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		auto hash = hashVertex(streams, vertex);
+		auto [begin, end] = uniqueVertices.equal_range(hash);
+		for (auto it = begin; it != end; ++it) {
+			if (verticesEqual(streams, it->second, vertex)) {
+				remap[vertex] = remap[it->second];
+				break;
+			}
+		}
+		if (remap[vertex] == INVALID_INDEX) {
+			remap[vertex] = outUniqueVertexCount++;
+			uniqueVertices.emplace(hash, vertex);
+		}
+	}
+	return remap;
+}
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount) {
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// Triangles using each vertex. The first remainingValence[vertex] entries starting at adjacencyOffsets[vertex]
+	// are the triangles not emitted yet.
+	std::vector<uint32_t> remainingValence(vertexCount, 0);
+	for (auto index : indices) {
+		remainingValence[index]++;
+	}
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remainingValence[vertex];
+	}
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+			for (size_t corner = 0; corner < 3; corner++) {
+				adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+			}
+		}
+	}
+
+	std::vector<int> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		vertexScores[vertex] = forsythVertexScore(-1, remainingValence[vertex]);
+	}
+
+	auto triangleScore = [&indices, &vertexScores](size_t triangle) {
+		return vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]] + vertexScores[indices[triangle * 3 + 2]];
+	};
+
+	std::vector<bool> emitted(triangleCount, false);
+	size_t bestTriangle = 0;
+	float bestScore = triangleScore(0);
+	for (size_t triangle = 1; triangle < triangleCount; triangle++) {
+		float score = triangleScore(triangle);
+		if (score > bestScore) {
+			bestScore = score;
+			bestTriangle = triangle;
+		}
+	}
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> newCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+	// Fallback if no triangle adjacent to the cache is left: take the first triangle not emitted yet.
+	size_t fallbackCursor = 0;
+	bool haveBest = true;
+
+	for (size_t count = 0; count < triangleCount; count++) {
+		if (!haveBest) {
+			while (emitted[fallbackCursor]) {
+				fallbackCursor++;
+			}
+			bestTriangle = fallbackCursor;
+		}
+
+		emitted[bestTriangle] = true;
+		const uint32_t* triangleIndices = &indices[bestTriangle * 3];
+		result.insert(result.end(), triangleIndices, triangleIndices + 3);
+
+		newCache.clear();
+		for (size_t corner = 0; corner < 3; corner++) {
+			auto vertex = triangleIndices[corner];
+			// Remove the triangle from the remaining triangles of the vertex
+			auto begin = adjacency.begin() + adjacencyOffsets[vertex];
+			auto end = begin + remainingValence[vertex];
+			auto it = std::find(begin, end, static_cast<uint32_t>(bestTriangle));
+			assert(it != end);
+			std::iter_swap(it, end - 1);
+			remainingValence[vertex]--;
+
+			if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+				newCache.emplace_back(vertex);
+			}
+		}
+		auto triangleVertices = newCache.size();
+		for (auto vertex : cache) {
+			if (std::find(newCache.begin(), newCache.begin() + triangleVertices, vertex) == newCache.begin() + triangleVertices) {
+				newCache.emplace_back(vertex);
+			}
+		}
+
+		for (size_t position = 0; position < newCache.size(); position++) {
+			auto vertex = newCache[position];
+			cachePositions[vertex] = position < FORSYTH_CACHE_SIZE ? static_cast<int>(position) : -1;
+			vertexScores[vertex] = forsythVertexScore(cachePositions[vertex], remainingValence[vertex]);
+		}
+
+		// Only the triangles using vertices whose score changed need to be rescored.
+		haveBest = false;
+		bestScore = -std::numeric_limits<float>::max();
+		for (auto vertex : newCache) {
+			for (uint32_t adjacent = 0; adjacent < remainingValence[vertex]; adjacent++) {
+				auto triangle = adjacency[adjacencyOffsets[vertex] + adjacent];
+				float score = triangleScore(triangle);
+				if (score > bestScore) {
+					bestScore = score;
+					bestTriangle = triangle;
+					haveBest = true;
+				}
+			}
+		}
+
+		newCache.resize(std::min<size_t>(newCache.size(), FORSYTH_CACHE_SIZE));
+		std::swap(cache, newCache);
+	}
+
+	indices = std::move(result);
+}
+
+std::vector<uint32_t> generateVertexFetchRemap(const std::vector<uint32_t>& indices, uint32_t vertexCount) {
+	std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+	uint32_t next = 0;
+	for (auto index : indices) {
+		if (remap[index] == INVALID_INDEX) {
+			remap[index] = next++;
+		}
+	}
+	for (auto& entry : remap) {
+		if (entry == INVALID_INDEX) {
+			entry = next++;
+		}
+	}
+	return remap;
+}
+
+void remapIndices(std::vector<uint32_t>& indices, const std::vector<uint32_t>& remap) {
+	for (auto& index : indices) {
+		index = remap[index];
+	}
+}
+
+void remapVertexStream(const VertexStream& stream, const std::vector<uint32_t>& remap, uint32_t newVertexCount) {
+	std::vector<float> result(static_cast<size_t>(newVertexCount) * stream.components);
+	for (size_t vertex = 0; vertex < remap.size(); vertex++) {
+		std::copy_n(stream.data->begin() + vertex * stream.components, stream.components, result.begin() + static_cast<size_t>(remap[vertex]) * stream.components);
+	}
+	*stream.data = std::move(result);
+}
+
+MeshOptimizationStatistics optimizeMesh(std::vector<uint32_t>& indices, const std::vector<VertexStream>& streams, uint32_t& vertexCount) {
+	size_t vertexSize = 0;
+	for (const auto& stream : streams) {
+		assert(stream.data->size() == static_cast<size_t>(vertexCount) * stream.components);
+		vertexSize += stream.components * sizeof(float);
+	}
+
+	MeshOptimizationStatistics statistics;
+	statistics.verticesBefore = vertexCount;
+	statistics.cacheBefore = analyzeVertexCache(indices, vertexCount);
+	statistics.fetchBefore = analyzeVertexFetch(indices, vertexCount, vertexSize);
+
+	if (indices.size() % 3 == 0) {
+		uint32_t uniqueVertexCount = 0;
+		auto weldRemap = generateWeldRemap(streams, vertexCount, uniqueVertexCount);
+		if (uniqueVertexCount < vertexCount) {
+			remapIndices(indices, weldRemap);
+			for (const auto& stream : streams) {
+				remapVertexStream(stream, weldRemap, uniqueVertexCount);
+			}
+			vertexCount = uniqueVertexCount;
+		}
+
+		optimizeVertexCache(indices, vertexCount);
+
+		auto fetchRemap = generateVertexFetchRemap(indices, vertexCount);
+		remapIndices(indices, fetchRemap);
+		for (const auto& stream : streams) {
+			remapVertexStream(stream, fetchRemap, vertexCount);
+		}
+	}
+
+	statistics.verticesAfter = vertexCount;
+	statistics.cacheAfter = analyzeVertexCache(indices, vertexCount);
+	statistics.fetchAfter = analyzeVertexFetch(indices, vertexCount, vertexSize);
+	return statistics;
+}
+
+}  // namespace raco::mesh_loader
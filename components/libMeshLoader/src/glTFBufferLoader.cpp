@@ -0,0 +1,391 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "mesh_loader/glTFBufferLoader.h"
+
+#include "utils/u8path.h"
+
+#include <json.hpp>
+#include <log_system/log.h>
+#include <tiny_gltf.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <future>
+#include <map>
+#include <thread>
+
+namespace raco::mesh_loader {
+
+namespace {
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;		  // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;	  // "JSON"
+constexpr uint32_t GLB_HEADER_SIZE = 12;
+constexpr uint32_t GLB_CHUNK_HEADER_SIZE = 8;
+
+// The buffer and image URIs are replaced by these names before tinygltf parses the file.
+// tinygltf then reads the prefetched buffers through the file system callbacks below.
+constexpr std::string_view PREFETCHED_BUFFER_PREFIX = "raco-prefetched-buffer-";
+constexpr std::string_view SKIPPED_IMAGE_PREFIX = "raco-skipped-image-";
+
+// The media types tinygltf accepts for buffer data URIs.
+constexpr std::array<std::string_view, 2> BUFFER_DATA_URI_PREFIXES = {"data:application/octet-stream;base64,", "data:application/gltf-buffer;base64,"};
+
+struct BufferJob {
+	size_t bufferIndex;
+	std::string uri;
+	bool isDataUri;
+	std::vector<unsigned char> data;
+	bool success = false;
+};
+
+struct PrefetchedFiles {
+	std::map<std::string, std::vector<unsigned char>, std::less<>> files;
+};
+
+bool prefetchedFileExists(const std::string& path, void* userData) {
+	auto prefetched = static_cast<PrefetchedFiles*>(userData);
+	return prefetched->files.find(path) != prefetched->files.end();
+}
+
+std::string prefetchedExpandFilePath(const std::string& path, void*) {
+	return path;
+}
+
+bool prefetchedReadWholeFile(std::vector<unsigned char>* out, std::string* err, const std::string& path, void* userData) {
+	auto prefetched = static_cast<PrefetchedFiles*>(userData);
+	auto it = prefetched->files.find(path);
+	if (it == prefetched->files.end()) {
+		if (err) {
+			*err += fmt::format("File not found : {}\n", path);
+		}
+		return false;
+	}
+	// tinygltf reads every buffer exactly once.
+	*out = std::move(it->second);
+	return true;
+}
+
+bool prefetchedWriteWholeFile(std::string* err, const std::string& path, const std::vector<unsigned char>&, void*) {
+	if (err) {
+		*err += fmt::format("Can't write file : {}\n", path);
+	}
+	return false;
+}
+
+bool prefetchedFileSize(size_t* size, std::string* err, const std::string& path, void* userData) {
+	auto prefetched = static_cast<PrefetchedFiles*>(userData);
+	auto it = prefetched->files.find(path);
+	if (it == prefetched->files.end()) {
+		if (err) {
+			*err += fmt::format("File not found : {}\n", path);
+		}
+		return false;
+	}
+	*size = it->second.size();
+	return true;
+}
+
+// Newer tinygltf versions additionally require a file size callback.
+template <typename Callbacks>
+auto setFileSizeCallback(Callbacks& callbacks, int) -> decltype(callbacks.GetFileSizeInBytes, void()) {
+	callbacks.GetFileSizeInBytes = &prefetchedFileSize;
+}
+
+template <typename Callbacks>
+void setFileSizeCallback(Callbacks&, long) {
+}
+
+bool skipImageData(tinygltf::Image*, const int, std::string*, std::string*, int, int, const unsigned char*, int, void*) {
+	return true;
+}
+
+std::optional<std::vector<unsigned char>> readBinaryFile(const utils::u8path& path) {
+	std::ifstream in(path.internalPath(), std::ios::binary | std::ios::ate);
+	if (!in) {
+		return std::nullopt;
+	}
+	auto size = in.tellg();
+	if (size < 0) {
+		return std::nullopt;
+	}
+	std::vector<unsigned char> data(static_cast<size_t>(size));
+	in.seekg(0);
+	if (!data.empty() && !in.read(reinterpret_cast<char*>(data.data()), size)) {
+		return std::nullopt;
+	}
+	return data;
+}
+
+std::string percentDecode(const std::string& uri) {
+	std::string result;
+	result.reserve(uri.size());
+	for (size_t index = 0; index < uri.size(); index++) {
+		if (uri[index] == '%' && index + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[index + 1])) && std::isxdigit(static_cast<unsigned char>(uri[index + 2]))) {
+			result += static_cast<char>(std::stoi(uri.substr(index + 1, 2), nullptr, 16));
+			index += 2;
+		} else {
+			result += uri[index];
+		}
+	}
+	return result;
+}
+
+bool isBufferDataUri(const std::string& uri) {
+	return std::any_of(BUFFER_DATA_URI_PREFIXES.begin(), BUFFER_DATA_URI_PREFIXES.end(), [&uri](std::string_view prefix) {
+		return uri.compare(0, prefix.size(), prefix) == 0;
+	});
+}
+
+void runBufferJob(BufferJob& job, const utils::u8path& baseDirectory) {
+	if (job.isDataUri) {
+		if (auto data = decodeBase64DataUri(job.uri)) {
+			job.data = std::move(data.value());
+			job.success = true;
+		}
+	} else {
+		auto data = readBinaryFile(baseDirectory / job.uri);
+		if (!data && job.uri.find('%') != std::string::npos) {
+			data = readBinaryFile(baseDirectory / percentDecode(job.uri));
+		}
+		if (data) {
+			job.data = std::move(data.value());
+			job.success = true;
+		}
+	}
+}
+
+void runBufferJobs(std::vector<BufferJob>& jobs, const utils::u8path& baseDirectory, unsigned threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	threadCount = static_cast<unsigned>(std::min<size_t>(threadCount, jobs.size()));
+
+	// Every job only writes its own result, so the result doesn't depend on the scheduling.
+	std::atomic<size_t> nextJob{0};
+	auto worker = [&jobs, &baseDirectory, &nextJob]() {
+		for (size_t index = nextJob++; index < jobs.size(); index = nextJob++) {
+			runBufferJob(jobs[index], baseDirectory);
+		}
+	};
+
+	std::vector<std::future<void>> workers;
+	for (unsigned thread = 1; thread < threadCount; thread++) {
+		workers.emplace_back(std::async(std::launch::async, worker));
+	}
+	worker();
+	for (auto& future : workers) {
+		future.get();
+	}
+}
+
+uint32_t readUint32(const unsigned char* data) {
+	return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+void appendUint32(std::vector<unsigned char>& data, uint32_t value) {
+	for (int shift = 0; shift < 32; shift += 8) {
+		data.emplace_back(static_cast<unsigned char>(value >> shift));
+	}
+}
+
+bool loadWithTinyglTF(tinygltf::TinyGLTF& importer, tinygltf::Model& model, std::string& err, std::string& warn, const std::string& absPath, bool isBinary) {
+	if (isBinary) {
+		return importer.LoadBinaryFromFile(&model, &err, &warn, absPath);
+	}
+	return importer.LoadASCIIFromFile(&model, &err, &warn, absPath);
+}
+
+}  // namespace
+
+std::optional<std::vector<unsigned char>> decodeBase64DataUri(std::string_view uri) {
+	static const auto decodingTable = []() {
+		std::array<int8_t, 256> table;
+		table.fill(-1);
+		const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		for (int index = 0; index < 64; index++) {
+			table[static_cast<unsigned char>(alphabet[index])] = static_cast<int8_t>(index);
+		}
+		return table;
+	}();
+
+	if (uri.compare(0, 5, "data:") != 0) {
+		return std::nullopt;
+	}
+	auto separator = uri.find(";base64,");
+	if (separator == std::string_view::npos) {
+		return std::nullopt;
+	}
+	auto payload = uri.substr(separator + 8);
+	while (!payload.empty() && payload.back() == '=') {
+		payload.remove_suffix(1);
+	}
+	if (payload.size() % 4 == 1) {
+		return std::nullopt;
+	}
+
+	std::vector<unsigned char> result;
+	result.reserve(payload.size() * 3 / 4);
+	uint32_t accumulator = 0;
+	int bits = 0;
+	for (char c : payload) {
+		auto value = decodingTable[static_cast<unsigned char>(c)];
+		if (value < 0) {
+			return std::nullopt;
+		}
+		accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+		bits += 6;
+		if (bits >= 8) {
+			bits -= 8;
+			result.emplace_back(static_cast<unsigned char>(accumulator >> bits));
+		}
+	}
+	return result;
+}
+
+bool loadglTFModel(tinygltf::TinyGLTF& importer, tinygltf::Model& model, std::string& err, std::string& warn, const std::string& absPath, unsigned threadCount, glTFLoadStatistics* statistics) {
+	importer.SetImageLoader(&skipImageData, nullptr);
+
+	auto path = utils::u8path(absPath);
+	bool isBinary = path.extension() == ".glb";
+
+	auto fileData = readBinaryFile(path);
+	if (!fileData) {
+		return loadWithTinyglTF(importer, model, err, warn, absPath, isBinary);
+	}
+
+	// Locate the JSON part of the file.
+	const unsigned char* jsonBegin = fileData->data();
+	size_t jsonSize = fileData->size();
+	size_t binChunkOffset = fileData->size();
+	if (isBinary) {
+		if (fileData->size() < GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE || readUint32(fileData->data()) != GLB_MAGIC || readUint32(fileData->data() + GLB_HEADER_SIZE + 4) != GLB_CHUNK_JSON) {
+			return loadWithTinyglTF(importer, model, err, warn, absPath, isBinary);
+		}
+		jsonSize = readUint32(fileData->data() + GLB_HEADER_SIZE);
+		jsonBegin = fileData->data() + GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE;
+		binChunkOffset = GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE + jsonSize;
+		if (binChunkOffset > fileData->size()) {
+			return loadWithTinyglTF(importer, model, err, warn, absPath, isBinary);
+		}
+	}
+
+	auto json = nlohmann::json::parse(jsonBegin, jsonBegin + jsonSize, nullptr, false);
+	if (json.is_discarded() || !json.is_object()) {
+		return loadWithTinyglTF(importer, model, err, warn, absPath, isBinary);
+	}
+
+	// Replace the URIs of the buffers and images and collect the buffer jobs.
+	PrefetchedFiles prefetched;
+	std::vector<BufferJob> jobs;
+	std::map<size_t, std::string> imageUris;
+	auto buffersIt = json.find("buffers");
+	if (buffersIt != json.end() && buffersIt->is_array()) {
+		for (size_t index = 0; index < buffersIt->size(); index++) {
+			auto& buffer = (*buffersIt)[index];
+			if (!buffer.is_object() || !buffer.contains("uri") || !buffer["uri"].is_string()) {
+				continue;
+			}
+			auto uri = buffer["uri"].get<std::string>();
+			bool isDataUri = uri.compare(0, 5, "data:") == 0;
+			if (isDataUri && !isBufferDataUri(uri)) {
+				// Let tinygltf report unsupported media types.
+				continue;
+			}
+			jobs.emplace_back(BufferJob{index, std::move(uri), isDataUri, {}, false});
+			buffer["uri"] = fmt::format("{}{}", PREFETCHED_BUFFER_PREFIX, index);
+		}
+	}
+	auto imagesIt = json.find("images");
+	if (imagesIt != json.end() && imagesIt->is_array()) {
+		for (size_t index = 0; index < imagesIt->size(); index++) {
+			auto& image = (*imagesIt)[index];
+			if (image.is_object() && image.contains("uri") && image["uri"].is_string()) {
+				imageUris[index] = image["uri"].get<std::string>();
+				auto name = fmt::format("{}{}", SKIPPED_IMAGE_PREFIX, index);
+				image["uri"] = name;
+				// tinygltf expects non-empty image data; it is passed to skipImageData and dropped.
+				prefetched.files[name] = {0};
+			}
+		}
+	}
+
+	runBufferJobs(jobs, path.parent_path(), threadCount);
+
+	for (auto& job : jobs) {
+		if (!job.success) {
+			if (job.isDataUri) {
+				err += fmt::format("Failed to decode 'uri' : {} in Buffer\n", job.uri);
+			} else {
+				err += fmt::format("File not found : {}\n", job.uri);
+			}
+			return false;
+		}
+		if (statistics) {
+			++(job.isDataUri ? statistics->dataUriBuffers : statistics->bufferFiles);
+		}
+		prefetched.files[fmt::format("{}{}", PREFETCHED_BUFFER_PREFIX, job.bufferIndex)] = std::move(job.data);
+	}
+
+	// The callbacks refer to the local prefetched files, so they are only installed on a local importer.
+	tinygltf::TinyGLTF prefetchingImporter;
+	prefetchingImporter.SetImageLoader(&skipImageData, nullptr);
+	tinygltf::FsCallbacks callbacks{};
+	callbacks.FileExists = &prefetchedFileExists;
+	callbacks.ExpandFilePath = &prefetchedExpandFilePath;
+	callbacks.ReadWholeFile = &prefetchedReadWholeFile;
+	callbacks.WriteWholeFile = &prefetchedWriteWholeFile;
+	setFileSizeCallback(callbacks, 0);
+	callbacks.user_data = &prefetched;
+	prefetchingImporter.SetFsCallbacks(callbacks);
+
+	// All external files are served by the callbacks, so the base directory is not needed.
+	auto rewrittenJson = json.dump();
+	bool success;
+	if (isBinary) {
+		// Rebuild the GLB with the rewritten JSON chunk and the original binary chunks.
+		rewrittenJson.append((4 - rewrittenJson.size() % 4) % 4, ' ');
+		std::vector<unsigned char> glb;
+		glb.reserve(GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE + rewrittenJson.size() + fileData->size() - binChunkOffset);
+		appendUint32(glb, GLB_MAGIC);
+		appendUint32(glb, readUint32(fileData->data() + 4));
+		appendUint32(glb, static_cast<uint32_t>(GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE + rewrittenJson.size() + fileData->size() - binChunkOffset));
+		appendUint32(glb, static_cast<uint32_t>(rewrittenJson.size()));
+		appendUint32(glb, GLB_CHUNK_JSON);
+		glb.insert(glb.end(), rewrittenJson.begin(), rewrittenJson.end());
+		glb.insert(glb.end(), fileData->begin() + binChunkOffset, fileData->end());
+		fileData.reset();
+		success = prefetchingImporter.LoadBinaryFromMemory(&model, &err, &warn, glb.data(), static_cast<unsigned int>(glb.size()), "");
+	} else {
+		fileData.reset();
+		success = prefetchingImporter.LoadASCIIFromString(&model, &err, &warn, rewrittenJson.c_str(), static_cast<unsigned int>(rewrittenJson.size()), "");
+	}
+
+	// Restore the original URIs.
+	for (const auto& job : jobs) {
+		if (job.bufferIndex < model.buffers.size() && !model.buffers[job.bufferIndex].uri.empty()) {
+			model.buffers[job.bufferIndex].uri = job.uri;
+		}
+	}
+	for (const auto& [index, uri] : imageUris) {
+		if (index < model.images.size() && !model.images[index].uri.empty()) {
+			model.images[index].uri = uri;
+		}
+	}
+	if (statistics) {
+		statistics->skippedImages += model.images.size();
+	}
+	return success;
+}
+
+}  // namespace raco::mesh_loader
@@ -15,6 +15,7 @@
 #include "mesh_loader/glTFFileLoader.h"
 
 #include "mesh_loader/glTFBufferData.h"
+#include "mesh_loader/glTFBufferLoader.h"
 #include "mesh_loader/glTFMesh.h"
 #include "utils/FileUtils.h"
 #include "utils/MathUtils.h"
@@ -239,11 +240,7 @@ bool glTFFileLoader::importglTFScene(const std::string& absPath) {
 		std::string err;
 		std::string warn;
 
-		if (utils::u8path(absPath).extension() == ".glb") {
-			importer_->LoadBinaryFromFile(&*scene_, &err, &warn, absPath);
-		} else {
-			importer_->LoadASCIIFromFile(&*scene_, &err, &warn, absPath);
-		}
+		loadglTFModel(*importer_, *scene_, err, warn, absPath);
 		if (!warn.empty()) {
 			LOG_WARNING(log_system::MESH_LOADER, "Encountered warnings while loading glTF mesh {}: {}", absPath, warn);
 		}
@@ -10,6 +10,7 @@
 
 #include "mesh_loader/glTFMesh.h"
 
+#include "mesh_loader/MeshOptimizer.h"
 #include "mesh_loader/glTFBufferData.h"
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
@@ -121,15 +122,11 @@ glTFMesh::glTFMesh(const tinygltf::Model &scene, const core::MeshScenegraph &sce
 	materials_ = {"material"};
 
 	// Add the vertices
-	const auto& posAttribute = attributes_.emplace_back(Attribute{
+	attributes_.emplace_back(Attribute{
 		ATTRIBUTE_POSITION,
 		VertexAttribDataType::VAT_Float3,
 		vertexBuffer});
 
-	// Build non-indexed triangle buffer to be used for picking in ramses
-	auto vertexData = reinterpret_cast<const glm::vec3 *>(posAttribute.data.data());
-	triangleBuffer_ = core::MeshData::buildTriangleBuffer(vertexData, indexBuffer_);
-
 	for (size_t index = 0; index < morphVertexBuffers.size(); index++) {
 		if (!morphVertexBuffers[index].empty()) {
 			attributes_.emplace_back(Attribute{
@@ -198,6 +195,34 @@ glTFMesh::glTFMesh(const tinygltf::Model &scene, const core::MeshScenegraph &sce
 			attributes_.emplace_back(Attribute{std::string(ATTRIBUTE_JOINTS) + std::to_string(index), VertexAttribDataType::VAT_Float4, jointBuffers[index]});
 		}
 	}
+
+	if (descriptor.optimize) {
+		optimizeMeshData();
+	}
+
+	// Build non-indexed triangle buffer to be used for picking in ramses
+	auto vertexData = reinterpret_cast<const glm::vec3 *>(attributes_.front().data.data());
+	triangleBuffer_ = core::MeshData::buildTriangleBuffer(vertexData, indexBuffer_);
+}
+
+void glTFMesh::optimizeMeshData() {
+	if (numVertices_ == 0) {
+		return;
+	}
+
+	std::vector<VertexStream> streams;
+	for (size_t index = 0; index < attributes_.size(); index++) {
+		auto elementCount = attribElementCount(static_cast<int>(index));
+		if (elementCount != numVertices_) {
+			LOG_WARNING(log_system::MESH_LOADER, "Attribute '{}' has different size than vertex buffer, skipping mesh optimization.", attributes_[index].name);
+			return;
+		}
+		streams.push_back({&attributes_[index].data, attributes_[index].data.size() / elementCount});
+	}
+
+	auto statistics = optimizeMesh(indexBuffer_, streams, numVertices_);
+	LOG_DEBUG(log_system::MESH_LOADER, "Mesh optimization: vertices {} -> {}, ACMR {:.3f} -> {:.3f}, vertex fetch ratio {:.3f} -> {:.3f}",
+		statistics.verticesBefore, statistics.verticesAfter, statistics.cacheBefore.acmr, statistics.cacheAfter.acmr, statistics.fetchBefore.overfetch, statistics.fetchAfter.overfetch);
 }
 
 uint32_t glTFMesh::numSubmeshes() const {
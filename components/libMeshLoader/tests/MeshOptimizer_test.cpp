@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "mesh_loader/MeshOptimizer.h"
+#include "mesh_loader/glTFFileLoader.h"
+#include "testing/RacoBaseTest.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <random>
+#include <set>
+
+using namespace raco;
+using namespace raco::mesh_loader;
+
+namespace {
+
+// Triangles as vertex value tuples, rotated to start with the smallest corner.
+std::multiset<std::vector<float>> triangleSet(const std::vector<uint32_t>& indices, const std::vector<const char*>& buffers, const std::vector<size_t>& vertexSizes) {
+	std::multiset<std::vector<float>> result;
+	for (size_t triangle = 0; triangle < indices.size() / 3; triangle++) {
+		std::array<std::vector<float>, 3> corners;
+		for (size_t corner = 0; corner < 3; corner++) {
+			auto index = indices[triangle * 3 + corner];
+			for (size_t stream = 0; stream < buffers.size(); stream++) {
+				auto values = reinterpret_cast<const float*>(buffers[stream]) + index * vertexSizes[stream];
+				corners[corner].insert(corners[corner].end(), values, values + vertexSizes[stream]);
+			}
+		}
+		auto first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+		std::vector<float> key;
+		for (size_t corner = 0; corner < 3; corner++) {
+			const auto& values = corners[(first + corner) % 3];
+			key.insert(key.end(), values.begin(), values.end());
+		}
+		result.insert(key);
+	}
+	return result;
+}
+
+// Grid of size x size quads with shuffled triangle and vertex order.
+void createShuffledGrid(uint32_t size, std::vector<uint32_t>& indices, std::vector<float>& positions) {
+	std::vector<std::array<uint32_t, 3>> triangles;
+	for (uint32_t y = 0; y < size; y++) {
+		for (uint32_t x = 0; x < size; x++) {
+			uint32_t v0 = y * (size + 1) + x;
+			uint32_t v2 = v0 + size + 1;
+			triangles.push_back({v0, v0 + 1, v2});
+			triangles.push_back({v0 + 1, v2 + 1, v2});
+		}
+	}
+	uint32_t vertexCount = (size + 1) * (size + 1);
+	std::vector<uint32_t> permutation(vertexCount);
+	std::iota(permutation.begin(), permutation.end(), 0);
+
+	std::mt19937 random(42);
+	std::shuffle(triangles.begin(), triangles.end(), random);
+	std::shuffle(permutation.begin(), permutation.end(), random);
+
+	positions.resize(vertexCount * 3);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+		positions[permutation[vertex] * 3] = static_cast<float>(vertex % (size + 1));
+		positions[permutation[vertex] * 3 + 1] = static_cast<float>(vertex / (size + 1));
+		positions[permutation[vertex] * 3 + 2] = 0.0f;
+	}
+	indices.clear();
+	for (const auto& triangle : triangles) {
+		for (auto vertex : triangle) {
+			indices.emplace_back(permutation[vertex]);
+		}
+	}
+}
+
+}  // namespace
+
+TEST(MeshOptimizerTest, analyze_vertex_cache) {
+	// Single triangle: every vertex transformed once
+	auto stats = analyzeVertexCache({0, 1, 2}, 3);
+	EXPECT_DOUBLE_EQ(stats.acmr, 3.0);
+	EXPECT_DOUBLE_EQ(stats.atvr, 1.0);
+
+	// Quad sharing two vertices
+	stats = analyzeVertexCache({0, 1, 2, 2, 1, 3}, 4);
+	EXPECT_DOUBLE_EQ(stats.acmr, 2.0);
+	EXPECT_DOUBLE_EQ(stats.atvr, 1.0);
+
+	// Sequential vertex access fetches every cache line once
+	EXPECT_DOUBLE_EQ(analyzeVertexFetch({0, 1, 2, 3, 4, 5, 6, 7}, 8, 16).overfetch, 1.0);
+}
+
+TEST(MeshOptimizerTest, weld_duplicate_vertices) {
+	// Quad as two triangles with separate vertices
+	std::vector<float> positions{0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+	std::vector<float> uvs{0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 0, 1};
+	std::vector<VertexStream> streams{{&positions, 3}, {&uvs, 2}};
+
+	uint32_t uniqueCount = 0;
+	auto remap = generateWeldRemap(streams, 6, uniqueCount);
+	EXPECT_EQ(uniqueCount, 4u);
+	EXPECT_EQ(remap, std::vector<uint32_t>({0, 1, 2, 1, 3, 2}));
+
+	// Vertices with the same position but different uv are kept apart
+	uvs[3 * 2] = 0.5f;
+	remap = generateWeldRemap(streams, 6, uniqueCount);
+	EXPECT_EQ(uniqueCount, 5u);
+}
+
+TEST(MeshOptimizerTest, optimize_shuffled_grid) {
+	std::vector<uint32_t> indices;
+	std::vector<float> positions;
+	createShuffledGrid(64, indices, positions);
+	auto trianglesBefore = triangleSet(indices, {reinterpret_cast<const char*>(positions.data())}, {3});
+
+	uint32_t vertexCount = static_cast<uint32_t>(positions.size() / 3);
+	auto stats = optimizeMesh(indices, {{&positions, 3}}, vertexCount);
+
+	EXPECT_EQ(stats.verticesAfter, stats.verticesBefore);
+	EXPECT_GT(stats.cacheBefore.acmr, 2.5);
+	EXPECT_LT(stats.cacheAfter.acmr, 0.8);
+	EXPECT_LT(stats.fetchAfter.overfetch * 5.0, stats.fetchBefore.overfetch);
+	EXPECT_EQ(triangleSet(indices, {reinterpret_cast<const char*>(positions.data())}, {3}), trianglesBefore);
+
+	// The result is deterministic
+	std::vector<uint32_t> indices2;
+	std::vector<float> positions2;
+	createShuffledGrid(64, indices2, positions2);
+	uint32_t vertexCount2 = static_cast<uint32_t>(positions2.size() / 3);
+	optimizeMesh(indices2, {{&positions2, 3}}, vertexCount2);
+	EXPECT_EQ(indices2, indices);
+	EXPECT_EQ(positions2, positions);
+}
+
+class MeshOptimizerFileTest : public RacoBaseTest<> {};
+
+TEST_F(MeshOptimizerFileTest, optimized_sample_mesh_has_same_triangles) {
+	auto path = test_path().append("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf").string();
+	core::MeshDescriptor desc{path, 0, true};
+	mesh_loader::glTFFileLoader plainLoader(path);
+	auto plain = plainLoader.loadMesh(desc);
+	desc.optimize = true;
+	mesh_loader::glTFFileLoader optimizedLoader(path);
+	auto optimized = optimizedLoader.loadMesh(desc);
+	ASSERT_TRUE(plain && optimized);
+
+	ASSERT_EQ(plain->numAttributes(), optimized->numAttributes());
+	EXPECT_EQ(plain->numTriangles(), optimized->numTriangles());
+	EXPECT_LE(optimized->numVertices(), plain->numVertices());
+	EXPECT_EQ(optimized->getIndices().size(), plain->getIndices().size());
+
+	std::vector<const char*> plainBuffers;
+	std::vector<const char*> optimizedBuffers;
+	std::vector<size_t> vertexSizes;
+	for (uint32_t index = 0; index < plain->numAttributes(); index++) {
+		EXPECT_EQ(plain->attribName(index), optimized->attribName(index));
+		EXPECT_EQ(optimized->attribElementCount(index), optimized->numVertices());
+		plainBuffers.emplace_back(plain->attribBuffer(index));
+		optimizedBuffers.emplace_back(optimized->attribBuffer(index));
+		vertexSizes.emplace_back(plain->attribDataSize(index) / sizeof(float) / plain->attribElementCount(index));
+	}
+	EXPECT_EQ(triangleSet(optimized->getIndices(), optimizedBuffers, vertexSizes), triangleSet(plain->getIndices(), plainBuffers, vertexSizes));
+
+	auto before = analyzeVertexCache(plain->getIndices(), plain->numVertices());
+	auto after = analyzeVertexCache(optimized->getIndices(), optimized->numVertices());
+	EXPECT_LE(after.acmr, before.acmr);
+	EXPECT_EQ(optimized->triangleBuffer().size(), plain->triangleBuffer().size());
+}
@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "mesh_loader/glTFBufferLoader.h"
+#include "testing/RacoBaseTest.h"
+#include "utils/FileUtils.h"
+
+#include <log_system/log.h>
+#include <tiny_gltf.h>
+
+#include <fstream>
+
+using namespace raco;
+
+namespace {
+
+std::string encodeBase64(const std::vector<unsigned char>& data) {
+	const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string result;
+	size_t index = 0;
+	for (; index + 2 < data.size(); index += 3) {
+		uint32_t value = (data[index] << 16) | (data[index + 1] << 8) | data[index + 2];
+		result += {alphabet[value >> 18], alphabet[(value >> 12) & 63], alphabet[(value >> 6) & 63], alphabet[value & 63]};
+	}
+	if (data.size() - index == 1) {
+		uint32_t value = data[index] << 16;
+		result += {alphabet[value >> 18], alphabet[(value >> 12) & 63], '=', '='};
+	} else if (data.size() - index == 2) {
+		uint32_t value = (data[index] << 16) | (data[index + 1] << 8);
+		result += {alphabet[value >> 18], alphabet[(value >> 12) & 63], alphabet[(value >> 6) & 63], '='};
+	}
+	return result;
+}
+
+std::vector<unsigned char> createBufferData(size_t size, size_t seed) {
+	std::vector<unsigned char> data(size);
+	for (size_t index = 0; index < size; index++) {
+		data[index] = static_cast<unsigned char>((index * 31 + seed * 17) ^ (index >> 8));
+	}
+	return data;
+}
+
+}  // namespace
+
+class glTFBufferLoaderTest : public RacoBaseTest<> {
+public:
+	// Writes a glTF file with external buffer files and base64 data URI buffers.
+	std::string createMultiBufferAsset(size_t fileBuffers, size_t fileBufferSize, size_t dataUriBuffers, size_t dataUriBufferSize) {
+		std::string buffers;
+		for (size_t index = 0; index < fileBuffers + dataUriBuffers; index++) {
+			std::string uri;
+			auto size = index < fileBuffers ? fileBufferSize : dataUriBufferSize;
+			auto data = createBufferData(size, index);
+			if (index < fileBuffers) {
+				uri = fmt::format("buffer{}.bin", index);
+				std::ofstream out((test_path() / uri).internalPath(), std::ios::binary);
+				out.write(reinterpret_cast<const char*>(data.data()), data.size());
+			} else {
+				uri = "data:application/octet-stream;base64," + encodeBase64(data);
+			}
+			buffers += fmt::format("{}{{\"uri\":\"{}\",\"byteLength\":{}}}", index > 0 ? "," : "", uri, size);
+		}
+		auto path = (test_path() / "multi_buffer.gltf").string();
+		utils::file::write(path, fmt::format(R"({{"asset":{{"version":"2.0"}},"buffers":[{}]}})", buffers));
+		return path;
+	}
+
+	static void expectSameBuffers(const tinygltf::Model& left, const tinygltf::Model& right) {
+		ASSERT_EQ(left.buffers.size(), right.buffers.size());
+		for (size_t index = 0; index < left.buffers.size(); index++) {
+			EXPECT_EQ(left.buffers[index].uri, right.buffers[index].uri);
+			EXPECT_TRUE(left.buffers[index].data == right.buffers[index].data) << "buffer " << index;
+		}
+	}
+};
+
+TEST_F(glTFBufferLoaderTest, decode_base64_data_uri) {
+	for (size_t size = 0; size < 10; size++) {
+		auto data = createBufferData(size, 3);
+		auto decoded = mesh_loader::decodeBase64DataUri("data:application/octet-stream;base64," + encodeBase64(data));
+		ASSERT_TRUE(decoded.has_value());
+		EXPECT_EQ(decoded.value(), data);
+	}
+	EXPECT_FALSE(mesh_loader::decodeBase64DataUri("buffer.bin").has_value());
+	EXPECT_FALSE(mesh_loader::decodeBase64DataUri("data:application/octet-stream;base64,AB$C").has_value());
+}
+
+TEST_F(glTFBufferLoaderTest, same_model_as_tinygltf) {
+	for (auto relPath : {"meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", "meshes/AnimatedMorphCube/AnimatedMorphCube.gltf"}) {
+		auto path = (test_path() / relPath).string();
+
+		tinygltf::TinyGLTF reference;
+		tinygltf::Model referenceModel;
+		std::string referenceErr, referenceWarn;
+		ASSERT_TRUE(reference.LoadASCIIFromFile(&referenceModel, &referenceErr, &referenceWarn, path)) << referenceErr;
+
+		tinygltf::TinyGLTF importer;
+		tinygltf::Model model;
+		std::string err, warn;
+		mesh_loader::glTFLoadStatistics statistics;
+		ASSERT_TRUE(mesh_loader::loadglTFModel(importer, model, err, warn, path, 4, &statistics)) << err;
+		EXPECT_TRUE(err.empty());
+
+		expectSameBuffers(model, referenceModel);
+		EXPECT_EQ(model.bufferViews.size(), referenceModel.bufferViews.size());
+		EXPECT_EQ(model.accessors.size(), referenceModel.accessors.size());
+		EXPECT_EQ(model.meshes.size(), referenceModel.meshes.size());
+		EXPECT_EQ(model.nodes.size(), referenceModel.nodes.size());
+		EXPECT_EQ(model.animations.size(), referenceModel.animations.size());
+		ASSERT_EQ(model.images.size(), referenceModel.images.size());
+		for (size_t index = 0; index < model.images.size(); index++) {
+			EXPECT_EQ(model.images[index].uri, referenceModel.images[index].uri);
+			EXPECT_TRUE(model.images[index].image.empty());
+		}
+		EXPECT_EQ(statistics.skippedImages, model.images.size());
+	}
+}
+
+TEST_F(glTFBufferLoaderTest, missing_buffer_file) {
+	auto path = createMultiBufferAsset(2, 16, 1, 16);
+	std::filesystem::remove((test_path() / "buffer1.bin").internalPath());
+
+	tinygltf::TinyGLTF importer;
+	tinygltf::Model model;
+	std::string err, warn;
+	EXPECT_FALSE(mesh_loader::loadglTFModel(importer, model, err, warn, path));
+	EXPECT_NE(err.find("buffer1.bin"), std::string::npos);
+}
+
+TEST_F(glTFBufferLoaderTest, importer_file_system_unchanged) {
+	auto path = createMultiBufferAsset(2, 16, 1, 16);
+
+	tinygltf::TinyGLTF importer;
+	tinygltf::Model model;
+	std::string err, warn;
+	ASSERT_TRUE(mesh_loader::loadglTFModel(importer, model, err, warn, path)) << err;
+
+	// The importer still reads the buffer files from the file system.
+	tinygltf::Model reloadedModel;
+	ASSERT_TRUE(importer.LoadASCIIFromFile(&reloadedModel, &err, &warn, path)) << err;
+	expectSameBuffers(reloadedModel, model);
+}
+
+TEST_F(glTFBufferLoaderTest, multi_buffer_asset) {
+	auto path = createMultiBufferAsset(8, 4 << 10, 8, 1 << 10);
+
+	tinygltf::TinyGLTF reference;
+	tinygltf::Model referenceModel;
+	std::string referenceErr, referenceWarn;
+	ASSERT_TRUE(reference.LoadASCIIFromFile(&referenceModel, &referenceErr, &referenceWarn, path)) << referenceErr;
+
+	tinygltf::TinyGLTF importer;
+	tinygltf::Model model;
+	std::string err, warn;
+	mesh_loader::glTFLoadStatistics statistics;
+	ASSERT_TRUE(mesh_loader::loadglTFModel(importer, model, err, warn, path, 0, &statistics)) << err;
+
+	EXPECT_EQ(statistics.bufferFiles, 8);
+	EXPECT_EQ(statistics.dataUriBuffers, 8);
+	expectSameBuffers(model, referenceModel);
+
+	// The result doesn't depend on the number of threads.
+	tinygltf::TinyGLTF serialImporter;
+	tinygltf::Model serialModel;
+	ASSERT_TRUE(mesh_loader::loadglTFModel(serialImporter, serialModel, err, warn, path, 1)) << err;
+	expectSameBuffers(serialModel, model);
+}
+
+#ifdef NDEBUG
+TEST_F(glTFBufferLoaderTest, performance_multi_buffer_asset) {
+	auto path = createMultiBufferAsset(32, 1 << 20, 32, 256 << 10);
+
+	tinygltf::TinyGLTF importer;
+	tinygltf::Model model;
+	std::string err, warn;
+	assertOperationTimeIsBelow(1000, [&]() {
+		ASSERT_TRUE(mesh_loader::loadglTFModel(importer, model, err, warn, path)) << err;
+	});
+	EXPECT_EQ(model.buffers.size(), 64);
+}
+#endif
@@ -952,6 +952,18 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 		app->doOneLoop();
 	});
 
+	m.def("setNumericValues", [](const core::PropertyDescriptor& desc, const std::vector<core::NumericValue>& values) {
+		checkProperty(desc);
+		app->activeRaCoProject().commandInterface()->setNumericValues(core::ValueHandle(desc), values);
+		app->doOneLoop();
+	});
+
+	m.def("importNumericValues", [](const core::PropertyDescriptor& desc, const std::string& path) {
+		checkProperty(desc);
+		app->activeRaCoProject().commandInterface()->importNumericValues(core::ValueHandle(desc), path);
+		app->doOneLoop();
+	});
+
 	m.def("getInstanceById", [](const std::string& id) -> py::object {
 		return py::cast(app->activeRaCoProject().project()->getInstanceByID(id));
 	});
@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/EditorObject.h"
+#include "core/Handles.h"
+#include "user_types/Node.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace raco::core {
+class Project;
+}
+
+namespace raco::ramses_adaptor {
+
+/**
+ * @brief Optional passes applied by the SceneAdaptor when the scene is optimized for export.
+ *
+ * The passes only change what is written into the exported scene, never the data model.
+ */
+struct ExportOptimizations {
+	// Leave out the resources which can't be reached from any object which is always exported, see findUnusedResources.
+	bool removeUnusedResources = false;
+	// Bake the transformation of static intermediate nodes into their children, see findFlattenableNodes.
+	bool flattenStaticTransforms = false;
+	// Leave out the logic objects and their links which can't influence the scene, see findUnusedLogic.
+	bool removeUnusedLogic = false;
+	// Let mesh nodes with identical unlinked private materials share one appearance without appearance binding, see privateMaterialKey.
+	bool sharePrivateAppearances = false;
+};
+
+/**
+ * @brief Call visitor(name, value) for every option of the ExportOptimizations, e.g. to serialize them.
+ *
+ * Works for const and non-const options. The structured binding doesn't compile if an option is added to
+ * ExportOptimizations without adding it here as well.
+ */
+template <typename Options, typename Visitor>
+void visitExportOptimizations(Options& options, Visitor&& visitor) {
+	auto& [removeUnusedResources, flattenStaticTransforms, removeUnusedLogic, sharePrivateAppearances] = options;
+	visitor("removeUnusedResources", removeUnusedResources);
+	visitor("flattenStaticTransforms", flattenStaticTransforms);
+	visitor("removeUnusedLogic", removeUnusedLogic);
+	visitor("sharePrivateAppearances", sharePrivateAppearances);
+}
+
+/**
+ * @brief Objects left out of the export scene by the export optimizations.
+ */
+struct ExportReport {
+	struct RemovedObject {
+		std::string objectName;
+		std::string objectID;
+		std::string typeName;
+		// Short description of the optimization which removed the object.
+		std::string reason;
+	};
+
+	std::vector<RemovedObject> removedObjects;
+	// Links which are not exported since their start or end object has been removed.
+	std::vector<std::string> removedLinks;
+};
+
+// Resources which are only exported if something uses them: meshes, textures, cube maps, render buffers, render targets,
+// materials, animation channels and Lua modules.
+bool isRemovableResource(const core::SEditorObject& object);
+
+/**
+ * @brief Find the removable resources which don't influence the exported scene.
+ *
+ * The reachability analysis is seeded with all objects which are not removable resources, i.e. the scenegraph nodes, render passes,
+ * blit passes, render layers, timers and logic objects, and with all objects used by links. Every resource referenced by a reachable
+ * object is reachable as well. Objects inside Prefabs are not exported at all and are neither seeds nor part of the result.
+ * The removedObjects, e.g. the result of findUnusedLogic, and the links using them are not used as seeds either.
+ */
+core::SEditorObjectSet findUnusedResources(const core::Project& project, const core::SEditorObjectSet& removedObjects = {});
+
+// Logic objects which are only exported if they can influence the scene: Lua scripts, Lua interfaces, animations and timers.
+bool isRemovableLogic(const core::SEditorObject& object);
+
+/**
+ * @brief Find the removable logic objects whose outputs can't reach the scene.
+ *
+ * The valid links are followed backwards starting at the links ending on objects which are not removable logic, e.g. the bindings
+ * of nodes, cameras, materials, render passes and skins. All logic objects which are not encountered on the way are unused.
+ * Logic objects inside Prefabs are not exported at all and are not part of the result.
+ */
+core::SEditorObjectSet findUnusedLogic(const core::Project& project);
+
+/**
+ * @brief Canonical description of the options and uniform values of a private material.
+ *
+ * Private materials of the same material with equal descriptions result in identical appearances. Texture uniforms are described by
+ * the object ID of the referenced object.
+ */
+std::string privateMaterialKey(const core::ValueHandle& optionsHandle, const core::ValueHandle& uniformsHandle);
+
+/**
+ * @brief Translation, rotation and scaling of a node as used by the scene.
+ *
+ * The rotation is given as Euler angles in degrees using the RAMSES_ROTATION_CONVENTION.
+ */
+struct NodeTransform {
+	glm::vec3 translation{0.0f};
+	glm::vec3 rotation{0.0f};
+	glm::vec3 scaling{1.0f};
+};
+
+NodeTransform nodeTransform(const user_types::SNode& node);
+
+// Local transformation matrix: translation * rotation * scaling.
+glm::mat4 transformMatrix(const NodeTransform& transform);
+
+// Split a matrix into translation, rotation and scaling; empty if the matrix can't be expressed that way, e.g. if it contains shear.
+std::optional<NodeTransform> decomposeTransform(const glm::mat4& matrix);
+
+/**
+ * @brief Find the nodes whose transformation can be baked into their children.
+ *
+ * A node can be flattened if it is a plain Node with child nodes which is visible, enabled and not used by any link, if nothing but its parent refers
+ * to it, and if all of its child nodes have unlinked transformation properties. Since a node transformation can't describe shear, the
+ * transformation of every child combined with the flattened ancestors has to be expressible as translation, rotation and scaling again.
+ * Nodes used by logic, skins or anchor points are therefore always kept with their names.
+ */
+core::SEditorObjectSet findFlattenableNodes(const core::Project& project);
+
+}  // namespace raco::ramses_adaptor
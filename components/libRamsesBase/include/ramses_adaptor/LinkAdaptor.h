@@ -13,11 +13,48 @@
 #include <ramses/client/logic/LogicEngine.h>
 #include <ramses/client/logic/Property.h>
 #include "components/DataChangeDispatcher.h"
+#include <map>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace raco::ramses_adaptor {
 
 class SceneAdaptor;
+class ILogicPropertyProvider;
+
+struct LinkStatistics {
+	// Number of successful logic engine link and unlink operations
+	size_t engineLinks = 0;
+	size_t engineUnlinks = 0;
+	// Number of engine properties looked up by name; properties used by several links are only looked up once per commit
+	size_t propertyLookups = 0;
+	// Number of link commits, i.e. bulk updates which (re)connected at least one link
+	size_t commits = 0;
+};
+
+/**
+ * @brief State of a single link commit of the SceneAdaptor.
+ *
+ * All links lifted or created during a bulk engine update are connected in a single pass after all adaptors have been synced.
+ * The adaptor lookup and the engine property resolution are cached for the duration of the commit since the adaptors
+ * can't change while the links are connected.
+ */
+class LinkCommit {
+public:
+	LinkCommit(SceneAdaptor* sceneAdaptor, LinkStatistics& statistics);
+
+	ramses::Property* property(const core::SEditorObject& object, const std::vector<std::string_view>& propertyNames);
+
+	ramses::LogicEngine& logicEngine();
+	LinkStatistics& statistics();
+
+private:
+	SceneAdaptor* sceneAdaptor_;
+	LinkStatistics& statistics_;
+	std::map<core::SEditorObject, ILogicPropertyProvider*> providers_;
+	std::map<std::pair<ILogicPropertyProvider*, std::string>, ramses::Property*> properties_;
+};
 
 class LinkAdaptor {
 public:
@@ -28,6 +65,7 @@ public:
 	using UniqueEngineLink = std::unique_ptr<EngineLink, std::function<void(EngineLink*)>>;
 	using SLink = core::SLink;
 
+	// The engine links are not created by the constructor but by the next link commit of the SceneAdaptor.
 	explicit LinkAdaptor(const core::LinkDescriptor& link, SceneAdaptor* sceneAdaptor);
 	~LinkAdaptor() {}
 
@@ -35,12 +73,12 @@ public:
 	const core::LinkDescriptor& editorLink() const noexcept { return editorLink_; }
 
 	void lift();
-	void connect();
+	void connect(LinkCommit& commit);
 
 	void readDataFromEngine(core::DataChangeRecorder &recorder);
 
 protected:
-	void connectHelper(const core::ValueHandle& start, const core::ValueHandle& end, bool isWeak);
+	void connectHelper(LinkCommit& commit, const core::ValueHandle& start, const core::ValueHandle& end, bool isWeak);
 	void readFromEngineRecursive(core::DataChangeRecorder& recorder, const core::ValueHandle& property);
 
 	SceneAdaptor* sceneAdaptor_;
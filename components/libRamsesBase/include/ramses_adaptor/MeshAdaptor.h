@@ -21,12 +21,19 @@ namespace raco::ramses_adaptor {
 class SceneAdaptor;
 using VertexDataMap = std::unordered_map<std::string, ramses_base::RamsesArrayResource>;
 
+// Location of an attribute inside its vertex buffer; stride 0 means tightly packed.
+struct VertexDataLayout {
+	uint16_t offset = 0;
+	uint16_t stride = 0;
+};
+
 class MeshAdaptor final : public UserTypeObjectAdaptor<user_types::Mesh> {
 public:
 	explicit MeshAdaptor(SceneAdaptor* sceneAdaptor, user_types::SMesh mesh);
 
 	ramses_base::RamsesArrayResource indicesPtr();
 	const VertexDataMap& vertexData() const;
+	VertexDataLayout vertexDataLayout(const std::string& attribName) const;
 	bool isValid();
 	
 
@@ -35,6 +42,8 @@ public:
 
 private:
 	VertexDataMap vertexDataMap_;
+	// Only contains the attributes of an interleaved vertex buffer.
+	std::unordered_map<std::string, VertexDataLayout> vertexDataLayout_;
 	ramses_base::RamsesArrayResource indices_;
 	core::FileChangeMonitor::UniqueListener meshFileChangeListener_;
 	components::Subscription subscription_;
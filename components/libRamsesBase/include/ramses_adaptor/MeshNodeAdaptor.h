@@ -52,10 +52,16 @@ public:
 
 	const ramses_base::RamsesAppearance& privateAppearance() const;
 	const ramses_base::RamsesAppearanceBinding& appearanceBinding() const;
+
+	// Skins write into the appearance through the appearance binding: their targets never share an appearance.
+	bool isSkinTarget() const;
+	// True if the mesh node has become or stopped being a skin target since the last sync.
+	bool skinTargetChanged() const;
 	std::vector<ExportInformation> getExportInformation() const override;
 
 private:
 	void syncMaterial(core::Errors* errors, size_t index);
+	bool sharePrivateAppearance() const;
 
 	void setupMaterialSubscription();
 	void setupUniformChildrenSubscription();
@@ -64,6 +70,7 @@ private:
 	ramses_base::RamsesAppearance currentAppearance_;
 	ramses_base::RamsesAppearanceBinding appearanceBinding_;
 	ramses_base::RamsesMeshNodeBinding meshNodeBinding_;
+	bool skinTarget_ = false;
 
 	// Subscriptions
 	components::Subscription meshSubscription_;
@@ -74,6 +81,7 @@ private:
 	components::Subscription instanceCountSubscription_;
 	components::Subscription uniformSubscription_;
 	components::Subscription uniformChildrenSubscription_;
+	components::Subscription uniformLinksLifecycle_;
 };
 
 };	// namespace raco::ramses_adaptor
@@ -122,9 +122,7 @@ public:
 		bool status = TypedObjectAdaptor<EditorType, RamsesType>::sync(errors);
 		syncNodeBinding();
 		syncVisibility();
-		syncRotation();
-		syncTranslation();
-		syncScaling();
+		syncTransform();
 		syncChildren();
 		this->tagDirty(false);
 		return status;
@@ -146,9 +144,16 @@ private:
 	void syncChildren() {
 		(*this->ramsesObject()).removeAllChildren();
 		currentRamsesChildren_.clear();
+		addRamsesChildren(this->editorObject());
+	}
 
-		for (const auto& child : *this->editorObject()) {
+	void addRamsesChildren(const core::SEditorObject& object) {
+		for (const auto& child : *object) {
 			SceneAdaptor* scene = this->sceneAdaptor_;
+			if (scene->isFlattened(child)) {
+				addRamsesChildren(child);
+				continue;
+			}
 			auto castedChild = scene->lookup<ISceneObjectProvider>(child);
 			if (castedChild) {
 				auto handle{castedChild->sceneObject()};
@@ -172,22 +177,35 @@ private:
 		nodeBinding_->getInputs()->getChild("enabled")->set(enabled);
 	}
 
-	void syncRotation() {
+	void syncTransform() {
+		auto transform = nodeTransform(this->editorObject());
+		if (auto parentTransform = this->sceneAdaptor_->flattenedParentTransform(this->editorObject())) {
+			// The flattened ancestors have no ramses node: their transformation is applied to this node instead.
+			if (auto combined = decomposeTransform(*parentTransform * transformMatrix(transform))) {
+				transform = *combined;
+			}
+		}
+		syncRotation(transform.rotation);
+		syncTranslation(transform.translation);
+		syncScaling(transform.scaling);
+	}
+
+	void syncRotation(const glm::vec3& rotation) {
 		if ((*this->ramsesObject()).getRotationType() != ramses_adaptor::RAMSES_ROTATION_CONVENTION ||
-			getRacoRotation(this->editorObject()) != getRamsesRotation(this->ramsesObject().get())) {
-			(*this->ramsesObject()).setRotation(getRacoRotation(this->editorObject()), ramses_adaptor::RAMSES_ROTATION_CONVENTION);
+			rotation != getRamsesRotation(this->ramsesObject().get())) {
+			(*this->ramsesObject()).setRotation(rotation, ramses_adaptor::RAMSES_ROTATION_CONVENTION);
 		}
 	}
 
-	void syncTranslation() {
-		if (getRacoTranslation(this->editorObject()) != getRamsesTranslation(this->ramsesObject().get())) {
-			(*this->ramsesObject()).setTranslation(getRacoTranslation(this->editorObject()));
+	void syncTranslation(const glm::vec3& translation) {
+		if (translation != getRamsesTranslation(this->ramsesObject().get())) {
+			(*this->ramsesObject()).setTranslation(translation);
 		}
 	}
 
-	void syncScaling() {
-		if (getRacoScaling(this->editorObject()) != getRamsesScaling(this->ramsesObject().get())) {
-			(*this->ramsesObject()).setScaling(getRacoScaling(this->editorObject()));
+	void syncScaling(const glm::vec3& scaling) {
+		if (scaling != getRamsesScaling(this->ramsesObject().get())) {
+			(*this->ramsesObject()).setScaling(scaling);
 		}
 	}
 
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "ramses_adaptor/ObjectAdaptor.h"
+#include "ramses_adaptor/TagMatchTable.h"
 #include "ramses_base/RamsesHandles.h"
 #include "user_types/RenderLayer.h"
 #include <ramses/client/RenderGroup.h>
@@ -29,12 +30,13 @@ public:
 
 private:
 	void buildRenderGroup(core::Errors* errors);
-	void buildRenderableOrder(core::Errors* errors, ramses_base::RamsesRenderGroup container, std::vector<SEditorObject>& objs, const std::string& tag, bool parentActive, const std::set<std::string>& materialFilterTags, bool materialFilterExclusive, int32_t& orderIndex, bool sceneGraphOrder);
-	void addNestedLayers(core::Errors* errors, ramses_base::RamsesRenderGroup container, const std::vector<user_types::SRenderLayer>& layers, const std::string& tag, int32_t orderIndex, bool sceneGraphOrder);
+	void buildRenderableOrder(core::Errors* errors, ramses_base::RamsesRenderGroup container, uint32_t tag, const TagBits& materialFilterTags, bool haveMaterialFilterTags, bool materialFilterExclusive, int32_t orderIndex, bool sceneGraphOrder);
+	void addNestedLayers(core::Errors* errors, ramses_base::RamsesRenderGroup container, const std::vector<user_types::SRenderLayer>& layers, uint32_t tag, int32_t orderIndex, bool sceneGraphOrder);
+	bool isInMaterialFilter(const SEditorObject& meshnode, const TagBits& materialFilterTags, bool haveMaterialFilterTags, bool materialFilterExclusive);
 
 	ramses_base::RamsesRenderGroupBinding binding_;
 
-	std::array<components::Subscription, 10> subscriptions_;
+	std::array<components::Subscription, 6> subscriptions_;
 };
 
 };	// namespace raco::ramses_adaptor
@@ -10,13 +10,18 @@
 #pragma once
 
 #include "core/Context.h"
+#include "ramses_adaptor/ExportOptimizations.h"
 #include "ramses_adaptor/LinkAdaptor.h"
+#include "ramses_adaptor/TagMatchTable.h"
 //#include "ramses_base/LogicEngine.h"
 #include "ramses_base/RamsesHandles.h"
 #include "ramses_base/BaseEngineBackend.h"
+#include "ramses_base/TextureCompressor.h"
 #include "ramses_adaptor/utilities.h"
 #include "components/DataChangeDispatcher.h"
+#include <functional>
 #include <map>
+#include <optional>
 #include "core/Link.h"
 
 namespace raco::ramses_adaptor {
@@ -32,7 +37,8 @@ class SceneAdaptor {
 	using SEditorObjectSet = core::SEditorObjectSet;
 
 public:
-	explicit SceneAdaptor(ramses::RamsesClient* client, ramses::sceneId_t id, Project* project, components::SDataChangeDispatcher dispatcher, core::Errors* errors, bool optimizeForExport = false);
+	explicit SceneAdaptor(ramses::RamsesClient* client, ramses::sceneId_t id, Project* project, components::SDataChangeDispatcher dispatcher, core::Errors* errors, bool optimizeForExport = false, bool interleaveVertexData = false,
+		std::shared_ptr<ramses_base::TextureCompressor> textureCompressor = nullptr, ExportOptimizations exportOptimizations = {});
 
 	~SceneAdaptor();
 
@@ -61,18 +67,51 @@ public:
 
 	void iterateAdaptors(std::function<void(ObjectAdaptor*)> func);
 
+	// Interned tags and tagged scenegraph shared by the render layer adaptors.
+	TagMatchTable& tagMatchTable();
+
 	bool optimizeForExport() const;
 
+	// Pack all vertex attributes of a mesh into a single interleaved vertex buffer instead of one buffer per attribute.
+	bool interleaveVertexData() const;
+
+	// Compressor for the 8 bit RGB and RGBA textures; nullptr if the textures are not compressed.
+	ramses_base::TextureCompressor* textureCompressor() const;
+
+	// Optional passes of the export scene; only used if optimizeForExport is set.
+	const ExportOptimizations& exportOptimizations() const;
+
+	// Objects currently left out of the scene by the export optimizations.
+	const ExportReport& exportReport() const;
+
+	// True if the node has no ramses node since its transformation is baked into its children.
+	bool isFlattened(const SEditorObject& object) const;
+
+	// Combined transformation of the flattened ancestors of the object up to the closest ancestor in the scene;
+	// empty if the parent of the object is not flattened.
+	std::optional<glm::mat4> flattenedParentTransform(const SEditorObject& object) const;
+
+	// Appearance shared by all private materials with the same key, see ExportOptimizations::sharePrivateAppearances.
+	// The appearance is created if no other user of the key exists.
+	ramses_base::RamsesAppearance sharedAppearance(const std::string& key, const std::function<ramses_base::RamsesAppearance()>& create);
+
 	ramses::EFeatureLevel featureLevel() const;
 
+	// Counters of the logic engine link operations performed by the link adaptors.
+	const LinkStatistics& linkStatistics() const;
+
 	void updateRuntimeError(const ramses::Issue& issue);
 	void clearRuntimeError();
 
 private:
 	bool needAdaptor(SEditorObject object);
+	void updateAdaptorStatus(SEditorObject object);
+	void updateExportOptimizations(const SEditorObjectSet& changedObjects);
+	void updateExportReport();
 	void createLink(const core::LinkDescriptor& link);
 	void changeLinkValidity(const core::LinkDescriptor& link, bool isValid);
 	void removeLink(const core::LinkDescriptor& link);
+	void commitLinkRemovals();
 	void createAdaptor(SEditorObject obj);
 	void removeAdaptor(SEditorObject obj);
 
@@ -86,11 +125,20 @@ private:
 	ramses::RamsesClient* client_;
 	Project* project_;
 	core::Errors* errors_;
+	TagMatchTable tagMatchTable_{project_};
 	ramses_base::RamsesScene scene_{};
 
 	ramses_base::BaseEngineBackend::UniqueLogicEngine logicEngine_;
 
 	bool optimizeForExport_ = false;
+	bool interleaveVertexData_ = false;
+	std::shared_ptr<ramses_base::TextureCompressor> textureCompressor_;
+	ExportOptimizations exportOptimizations_;
+	SEditorObjectSet unusedLogic_;
+	SEditorObjectSet unusedResources_;
+	SEditorObjectSet flattenedNodes_;
+	std::map<std::string, std::weak_ptr<ramses_base::RamsesAppearanceHandle>> sharedAppearances_;
+	ExportReport exportReport_;
 
 	// Fallback resources: used when MeshNode doesn't have valid shader program or mesh data
 	ramses_base::RamsesAppearance defaultAppearance_;
@@ -107,11 +155,17 @@ private:
 		std::map<std::string, std::map<core::LinkDescriptor, SharedLinkAdaptor>> linksByEnd_{};
 	};
 
+	LinkStatistics linkStatistics_;
 	LinkAdaptorContainer links_;
 	std::set<core::LinkDescriptor> newLinks_{};
+	// Removed links keep their engine links until the next bulk update; the engine links are removed before any adaptor is synced or destroyed.
+	std::vector<SharedLinkAdaptor> removedLinks_{};
 
 	components::Subscription subscription_;
 	components::Subscription childrenSubscription_;
+	components::Subscription tagsSubscription_;
+	components::Subscription renderableTagsSubscription_;
+	components::Subscription materialSubscription_;
 	components::Subscription linksLifecycle_;
 	components::Subscription linkValidityChangeSub_;
 	SRamsesAdaptorDispatcher dispatcher_;
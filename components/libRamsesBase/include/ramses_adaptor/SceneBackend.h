@@ -36,7 +36,8 @@ public:
 	using SDataChangeDispatcher = components::SDataChangeDispatcher;
 
 	explicit SceneBackend(ramses_base::BaseEngineBackend& engine, const SDataChangeDispatcher& dispatcher);
-	void setScene(Project* project, core::Errors* errors, bool optimizeForExport, ramses::sceneId_t sceneId);
+	void setScene(Project* project, core::Errors* errors, bool optimizeForExport, ramses::sceneId_t sceneId, bool interleaveVertexData = false, std::shared_ptr<ramses_base::TextureCompressor> textureCompressor = nullptr,
+		ExportOptimizations exportOptimizations = {});
 	void reset();
 	void flush();
 	void readDataFromEngine(core::DataChangeRecorder &recorder);
@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/EditorObject.h"
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace raco::core {
+class Project;
+}
+
+namespace raco::ramses_adaptor {
+
+// Set of interned tag ids stored as a dense bitset.
+class TagBits {
+public:
+	void set(uint32_t id);
+	bool test(uint32_t id) const;
+	bool intersects(const TagBits& other) const;
+	bool any() const;
+	// Ids of the set tags in ascending order.
+	std::vector<uint32_t> ids() const;
+	TagBits& operator|=(const TagBits& other);
+	bool operator==(const TagBits& other) const;
+
+private:
+	std::vector<uint64_t> words_;
+};
+
+/**
+ * @brief Tag membership data shared by all RenderLayerAdaptors of a scene.
+ *
+ * Tags are interned to dense integer ids and the tags of objects are cached as bitsets, so that the render layers can test
+ * membership without comparing strings.
+ *
+ * The table also caches the scenegraph in depth-first order as used by the render layers, i.e. the top-level nodes and all their
+ * descendants. Every entry contains the tags of the object combined with the tags of all its ancestors. The scenegraph is only
+ * rebuilt after structural changes; if the tags of an object change only the entries of its subtree are updated.
+ *
+ * For every tag the mesh node entries having the tag are indexed, so a render layer only visits the mesh nodes of its renderable
+ * tags. The table keeps track of the tags whose mesh nodes, render layers or materials changed. After a change only the render
+ * layers using one of these tags as renderable or material filter tag need to be rebuilt, see takeAffectedRenderLayers.
+ */
+class TagMatchTable {
+public:
+	struct Entry {
+		core::SEditorObject object;
+		// Tags of the object and all its ancestors
+		TagBits tags;
+		// Index of the parent entry or -1 for top-level nodes
+		int parent;
+		// End of the subtree of this entry, i.e. the index of the first entry after the last descendant
+		size_t subtreeEnd;
+		bool meshNode;
+	};
+
+	struct Statistics {
+		size_t sceneGraphRebuilds = 0;
+		size_t subtreeUpdates = 0;
+		// Number of render layers returned by takeAffectedRenderLayers
+		size_t affectedRenderLayers = 0;
+	};
+
+	explicit TagMatchTable(const core::Project* project);
+
+	uint32_t intern(const std::string& tag);
+	TagBits bits(const std::set<std::string>& tags);
+
+	// Cached own tags of a Node, Material or RenderLayer; empty for other objects.
+	const TagBits& objectTags(const core::SEditorObject& object);
+
+	const std::vector<Entry>& sceneGraph();
+
+	// Indices of the mesh node entries of the scenegraph having the tag, in scenegraph order.
+	const std::vector<size_t>& meshNodes(uint32_t tag);
+
+	// Invalidate the scenegraph after objects have been created, deleted or moved.
+	void markStructureDirty();
+	void addObject(const core::SEditorObject& object);
+	void removeObject(const core::SEditorObject& object);
+	// Invalidate the cached tags of an object after its "tags" property changed.
+	void markTagsDirty(const core::SEditorObject& object);
+	// The render layers containing the layer need to check again whether they contain themselves.
+	void markRenderableTagsChanged(const core::SEditorObject& layer);
+	// The render layers containing the mesh node need to check the material filter again.
+	void markMaterialChanged(const core::SEditorObject& meshNode);
+
+	// Update the scenegraph and return the render layers affected by the changes since the last call.
+	std::vector<core::SEditorObject> takeAffectedRenderLayers();
+
+	const Statistics& statistics() const;
+
+private:
+	void rebuildSceneGraph();
+	void addSubtree(const core::SEditorObject& object, int parent);
+	void updateSubtree(size_t index);
+	void markObjectTagsChanged(const core::SEditorObject& object);
+
+	const core::Project* project_;
+	std::unordered_map<std::string, uint32_t> tagIds_;
+	std::unordered_map<core::SEditorObject, TagBits> objectTags_;
+
+	std::vector<Entry> entries_;
+	std::unordered_map<core::SEditorObject, size_t> entryIndices_;
+	// Mesh node entry indices by tag id
+	std::vector<std::vector<size_t>> tagMeshNodes_;
+	std::vector<core::SEditorObject> renderLayers_;
+	bool structureDirty_ = true;
+	std::set<core::SEditorObject> tagsDirty_;
+	std::set<core::SEditorObject> materialsDirty_;
+	// Tags whose mesh nodes, render layers or materials changed since the last takeAffectedRenderLayers
+	TagBits changedTags_;
+
+	Statistics statistics_;
+};
+
+}  // namespace raco::ramses_adaptor
@@ -27,6 +27,7 @@
 #include "utils/MathUtils.h"
 
 #include <memory>
+#include <optional>
 #include <ramses/client/logic/Property.h>
 #include <ramses/client/logic/NodeBinding.h>
 #include <type_traits>
@@ -269,4 +270,26 @@ std::vector<DependencyNode> buildSortedDependencyGraph(core::SEditorObjectSet co
 
 ramses_base::RamsesArrayResource arrayResourceFromAttribute(ramses::Scene* scene, core::SharedMeshData mesh, int attribIndex, std::string_view name);
 
+// All vertex attributes of a mesh packed into a single buffer: the attribute values of each vertex are stored
+// next to each other at the attribute offsets, consecutive vertices are stride bytes apart.
+struct InterleavedVertexData {
+	struct Attribute {
+		std::string name;
+		core::MeshData::VertexAttribDataType type;
+		uint16_t offset;
+	};
+
+	std::vector<std::byte> data;
+	uint32_t vertexCount = 0;
+	uint16_t stride = 0;
+	std::vector<Attribute> attributes;
+};
+
+// Returns std::nullopt if the mesh has no attributes, the attributes have different element counts or
+// the vertex size exceeds the maximum stride supported by ramses.
+std::optional<InterleavedVertexData> interleaveVertexAttributes(const core::MeshData& mesh);
+
+// Size of a single attribute element in bytes.
+size_t vertexAttribElementSize(core::MeshData::VertexAttribDataType type);
+
 };	// namespace raco::ramses_adaptor
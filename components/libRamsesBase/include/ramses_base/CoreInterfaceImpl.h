@@ -15,12 +15,20 @@
 #include "ramses_base/RamsesHandles.h"
 
 #include <map>
+#include <optional>
 
 namespace raco::ramses_base {
 class BaseEngineBackend;
 
 class CoreInterfaceImpl final : public core::EngineInterface {
 public:
+	struct LuaParseStatistics {
+		// Number of parseLuaScript and parseLuaInterface calls
+		size_t requests = 0;
+		// Number of scripts and interfaces actually compiled in the logic engine
+		size_t compilations = 0;
+	};
+
 	explicit CoreInterfaceImpl(BaseEngineBackend* backend);
 	bool parseShader(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader, const std::string& shaderDefines, core::PropertyInterfaceList& outUniforms, core::PropertyInterfaceList& outAttributes, std::string& error) override;
 	bool parseLuaScript(const std::string& luaScript, const std::string& scriptName, const std::vector<std::string>& stdModules, const data_storage::Table& modules, core::PropertyInterfaceList& outInputs, core::PropertyInterfaceList& outOutputs, std::string& error) override;
@@ -32,14 +40,45 @@ public:
 	void removeModuleFromCache(core::SCEditorObject object) override;
 	void clearModuleCache() override;
 
+	const LuaParseStatistics& luaParseStatistics() const;
+
 private:
+	// Identifies a script or interface parse: identical keys give identical parse results.
+	struct LuaParseKey {
+		bool isInterface;
+		std::string source;
+		// Only used for failed parses since the name only shows up in the error message.
+		std::string name;
+		std::vector<std::string> stdModules;
+		// Alias and module object of the module dependencies
+		std::vector<std::pair<std::string, core::SCEditorObject>> modules;
+		int featureLevel;
+
+		bool operator<(const LuaParseKey& other) const;
+	};
+
+	struct LuaParseResult {
+		bool success;
+		core::PropertyInterfaceList inputs;
+		core::PropertyInterfaceList outputs;
+		std::string error;
+	};
+
 	ramses::LogicEngine* logicEngine();
 
 	std::tuple<ramses::LuaConfig, bool> createFullLuaConfig(const std::vector<std::string>& stdModules, const data_storage::Table& modules);
+	std::optional<LuaParseKey> createLuaParseKey(bool isInterface, const std::string& source, const std::string& name, const std::vector<std::string>& stdModules, const data_storage::Table& modules) const;
+	const LuaParseResult& cacheLuaParseResult(LuaParseKey&& key, LuaParseResult&& result);
+	void removeParseResultsUsingModule(const core::SCEditorObject& module);
 
 	BaseEngineBackend* backend_;
 
 	std::map<core::SCEditorObject, ramses_base::RamsesLuaModule> cachedModules_;
+
+	// Parse results of scripts and interfaces. Identical scripts, e.g. the same file used by many LuaScript objects
+	// or the same script parsed again after an undo, are compiled only once.
+	std::map<LuaParseKey, LuaParseResult> cachedParseResults_;
+	LuaParseStatistics luaParseStatistics_;
 };
 
 }  // namespace raco::ramses_base
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raco::ramses_base {
+
+// Search effort of encodeEtc2; higher qualities are slower but reduce the block error.
+enum class EEtcQuality {
+	// Quantized subblock average colors only.
+	Fast = 0,
+	// Additionally try the direct neighbours of the quantized average colors and alpha multipliers.
+	Normal,
+	// Wider search around the quantized average colors; considerably slower.
+	High
+};
+
+// Size in bytes of the compressed image: 8 bytes per 4x4 block for ETC2 RGB and 16 bytes for ETC2 RGBA8.
+size_t etcCompressedSize(uint32_t width, uint32_t height, bool alpha);
+
+/**
+ * Deterministic CPU encoder for ETC2 RGB and ETC2 RGBA8 (ETC2 color with EAC alpha) compressed textures.
+ *
+ * The color blocks only use the ETC1 compatible individual and differential modes; the differential mode is never
+ * used with base colors which would overflow into the ETC2 T, H or planar modes. The images are processed in rows of
+ * 4x4 blocks which are distributed over multiple threads. Every block is encoded independently, so the result does
+ * not depend on the number of threads.
+ *
+ * Encodes tightly packed 8 bit RGB (channels = 3) or RGBA (channels = 4) pixel data.
+ * Incomplete blocks at the right and bottom border are padded by repeating the last column and row.
+ * A threadCount of 0 uses std::thread::hardware_concurrency threads.
+ */
+std::vector<unsigned char> encodeEtc2(const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t channels, EEtcQuality quality, uint32_t threadCount = 0);
+
+// Decode data written by encodeEtc2 back into tightly packed RGB or RGBA data.
+// Returns an empty vector if a block uses one of the ETC2 T, H or planar modes.
+std::vector<unsigned char> decodeEtc2(const unsigned char* blocks, uint32_t width, uint32_t height, uint32_t channels);
+
+// Halve the image size with a 2x2 box filter; odd sizes are rounded down but not below 1.
+std::vector<unsigned char> downsampleImage(const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t channels);
+
+// Peak signal-to-noise ratio in dB of two 8 bit images of the given size in bytes. Identical images return infinity.
+double computePsnr(const unsigned char* image, const unsigned char* reference, size_t size);
+
+}  // namespace raco::ramses_base
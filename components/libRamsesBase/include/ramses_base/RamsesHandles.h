@@ -227,8 +227,8 @@ struct RamsesGeometryHandle {
 		}
 	}
 
-	void addAttributeBuffer(const ramses::AttributeInput& attribInput, RamsesArrayResource attributeBuffer) {
-		if (geometry_->setInputBuffer(attribInput, *attributeBuffer)) {
+	void addAttributeBuffer(const ramses::AttributeInput& attribInput, RamsesArrayResource attributeBuffer, uint16_t offset = 0u, uint16_t stride = 0u) {
+		if (geometry_->setInputBuffer(attribInput, *attributeBuffer, offset, stride)) {
 			trackedMeshVertexData_.emplace_back(attributeBuffer);
 		} else {
 			auto error = scene_->getRamsesClient().getRamsesFramework().getLastError().value();
@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "ramses_base/EtcEncoder.h"
+
+#include <ramses/framework/TextureEnums.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace raco::ramses_base {
+
+/**
+ * @brief Compresses 8 bit RGB and RGBA textures into the ETC2 RGB and ETC2 RGBA formats using the EtcEncoder.
+ *
+ * Encoded images can be stored in an on-disk cache directory. Cache entries are identified by a SHA-256 hash over
+ * the source pixel data, the image size, the number of channels, the quality preset and the encoder version.
+ */
+class TextureCompressor {
+public:
+	// Increase when the encoder output changes to invalidate existing cache entries.
+	static constexpr int ENCODER_VERSION = 1;
+
+	struct Statistics {
+		size_t encodedImages = 0;
+		size_t cacheHits = 0;
+		size_t cacheStored = 0;
+	};
+
+	// The cache is disabled if cacheDirectory is empty.
+	explicit TextureCompressor(EEtcQuality quality, const std::string& cacheDirectory = {});
+
+	EEtcQuality quality() const;
+	const std::string& cacheDirectory() const;
+	const Statistics& statistics() const;
+
+	static std::string cacheKey(const std::vector<unsigned char>& pixels, uint32_t width, uint32_t height, uint32_t channels, EEtcQuality quality);
+
+	// Compress a single image, using the cache if enabled.
+	std::vector<unsigned char> compress(const std::vector<unsigned char>& pixels, uint32_t width, uint32_t height, uint32_t channels);
+
+	// Compress the mip levels of an RGB8 or RGBA8 texture in place. Level i must have the size max(1, width >> i) x max(1, height >> i).
+	// If generateMipChain is set and a single level is given, the remaining levels down to 1x1 are generated on the CPU
+	// since compressed textures can't be mipmapped by the GPU.
+	// @return the compressed texture format or std::nullopt if the texture can't be compressed; the data is unchanged in that case.
+	std::optional<ramses::ETextureFormat> compressMipLevels(std::vector<std::vector<unsigned char>>& mipLevels, ramses::ETextureFormat format, uint32_t width, uint32_t height, bool generateMipChain);
+
+private:
+	std::string cachedFilePath(const std::string& key) const;
+
+	EEtcQuality quality_;
+	std::string cacheDirectory_;
+	Statistics statistics_;
+};
+
+}  // namespace raco::ramses_base
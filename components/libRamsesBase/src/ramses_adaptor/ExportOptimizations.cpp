@@ -0,0 +1,316 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "ramses_adaptor/ExportOptimizations.h"
+
+#include "core/Iterators.h"
+#include "core/Link.h"
+#include "core/PrefabOperations.h"
+#include "core/Project.h"
+#include "core/Queries.h"
+#include "ramses_adaptor/utilities.h"
+#include "user_types/Animation.h"
+#include "user_types/AnimationChannel.h"
+#include "user_types/CubeMap.h"
+#include "user_types/LuaInterface.h"
+#include "user_types/LuaScript.h"
+#include "user_types/LuaScriptModule.h"
+#include "user_types/Material.h"
+#include "user_types/Mesh.h"
+#include "user_types/RenderBuffer.h"
+#include "user_types/RenderBufferMS.h"
+#include "user_types/RenderTarget.h"
+#include "user_types/Texture.h"
+#include "user_types/TextureExternal.h"
+#include "user_types/Timer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/euler_angles.hpp>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+
+namespace raco::ramses_adaptor {
+
+bool isRemovableResource(const core::SEditorObject& object) {
+	return object->isType<user_types::Mesh>() ||
+		   object->isType<user_types::Texture>() ||
+		   object->isType<user_types::TextureExternal>() ||
+		   object->isType<user_types::CubeMap>() ||
+		   object->isType<user_types::RenderBuffer>() ||
+		   object->isType<user_types::RenderBufferMS>() ||
+		   object->as<user_types::RenderTargetBase>() ||
+		   object->isType<user_types::Material>() ||
+		   object->as<user_types::AnimationChannel>() ||
+		   object->isType<user_types::LuaScriptModule>();
+}
+
+core::SEditorObjectSet findUnusedResources(const core::Project& project, const core::SEditorObjectSet& removedObjects) {
+	core::SEditorObjectSet reachable;
+	std::vector<core::SEditorObject> stack;
+	auto visit = [&reachable, &stack](const core::SEditorObject& object) {
+		if (reachable.insert(object).second) {
+			stack.emplace_back(object);
+		}
+	};
+
+	auto isRemoved = [&removedObjects](const core::SEditorObject& object) {
+		return removedObjects.find(object) != removedObjects.end();
+	};
+
+	std::vector<core::SEditorObject> resources;
+	for (const auto& object : project.instances()) {
+		if (core::PrefabOperations::findContainingPrefab(object) || isRemoved(object)) {
+			continue;
+		}
+		if (isRemovableResource(object)) {
+			resources.emplace_back(object);
+		} else {
+			visit(object);
+		}
+	}
+	for (const auto& link : project.links()) {
+		if (!isRemoved(*link->startObject_) && !isRemoved(*link->endObject_)) {
+			visit(*link->startObject_);
+			visit(*link->endObject_);
+		}
+	}
+
+	while (!stack.empty()) {
+		auto object = stack.back();
+		stack.pop_back();
+		for (auto handle : core::ValueTreeIteratorAdaptor(core::ValueHandle(object))) {
+			if (handle.type() == data_storage::PrimitiveType::Ref) {
+				if (auto target = handle.asRef()) {
+					visit(target);
+				}
+			}
+		}
+	}
+
+	core::SEditorObjectSet unused;
+	for (const auto& resource : resources) {
+		if (reachable.find(resource) == reachable.end()) {
+			unused.insert(resource);
+		}
+	}
+	return unused;
+}
+
+bool isRemovableLogic(const core::SEditorObject& object) {
+	return object->isType<user_types::LuaScript>() ||
+		   object->isType<user_types::LuaInterface>() ||
+		   object->isType<user_types::Animation>() ||
+		   object->isType<user_types::Timer>();
+}
+
+core::SEditorObjectSet findUnusedLogic(const core::Project& project) {
+	core::SEditorObjectSet used;
+	std::vector<core::SEditorObject> stack;
+	auto visit = [&used, &stack](const core::SEditorObject& object) {
+		if (used.insert(object).second) {
+			stack.emplace_back(object);
+		}
+	};
+
+	std::map<core::SEditorObject, std::vector<core::SEditorObject>> linkStarts;
+	for (const auto& link : project.links()) {
+		if (!link->isValid()) {
+			continue;
+		}
+		auto endObject = *link->endObject_;
+		if (isRemovableLogic(endObject)) {
+			linkStarts[endObject].emplace_back(*link->startObject_);
+		} else {
+			visit(*link->startObject_);
+		}
+	}
+
+	while (!stack.empty()) {
+		auto object = stack.back();
+		stack.pop_back();
+		auto it = linkStarts.find(object);
+		if (it != linkStarts.end()) {
+			for (const auto& start : it->second) {
+				visit(start);
+			}
+		}
+	}
+
+	core::SEditorObjectSet unused;
+	for (const auto& object : project.instances()) {
+		if (isRemovableLogic(object) && used.find(object) == used.end() && !core::PrefabOperations::findContainingPrefab(object)) {
+			unused.insert(object);
+		}
+	}
+	return unused;
+}
+
+namespace {
+
+void appendValues(std::string& key, const core::ValueHandle& handle) {
+	for (auto child : core::ValueTreeIteratorAdaptor(handle)) {
+		switch (child.type()) {
+			case data_storage::PrimitiveType::Bool:
+				key.append(fmt::format("{}={};", child.getPropName(), child.asBool()));
+				break;
+			case data_storage::PrimitiveType::Int:
+				key.append(fmt::format("{}={};", child.getPropName(), child.asInt()));
+				break;
+			case data_storage::PrimitiveType::Int64:
+				key.append(fmt::format("{}={};", child.getPropName(), child.asInt64()));
+				break;
+			case data_storage::PrimitiveType::Double:
+				key.append(fmt::format("{}={};", child.getPropName(), child.asDouble()));
+				break;
+			case data_storage::PrimitiveType::String:
+				key.append(fmt::format("{}={};", child.getPropName(), child.asString()));
+				break;
+			case data_storage::PrimitiveType::Ref: {
+				auto target = child.asRef();
+				key.append(fmt::format("{}={};", child.getPropName(), target ? target->objectID() : std::string()));
+				break;
+			}
+			default:
+				// Structs and tables: their members are visited by the iterator.
+				key.append(fmt::format("{}:", child.getPropName()));
+				break;
+		}
+	}
+}
+
+}  // namespace
+
+std::string privateMaterialKey(const core::ValueHandle& optionsHandle, const core::ValueHandle& uniformsHandle) {
+	std::string key;
+	appendValues(key, optionsHandle);
+	key.push_back('|');
+	appendValues(key, uniformsHandle);
+	return key;
+}
+
+NodeTransform nodeTransform(const user_types::SNode& node) {
+	return {getRacoTranslation(node), getRacoRotation(node), getRacoScaling(node)};
+}
+
+glm::mat4 transformMatrix(const NodeTransform& transform) {
+	// Euler_ZYX rotates around z first, i.e. the rotation matrix is Rx * Ry * Rz.
+	auto rotation = glm::eulerAngleXYZ(glm::radians(transform.rotation.x), glm::radians(transform.rotation.y), glm::radians(transform.rotation.z));
+	return glm::translate(glm::mat4(1.0f), transform.translation) * rotation * glm::scale(glm::mat4(1.0f), transform.scaling);
+}
+
+std::optional<NodeTransform> decomposeTransform(const glm::mat4& matrix) {
+	constexpr float tolerance = 1e-5f;
+
+	NodeTransform transform;
+	transform.translation = glm::vec3(matrix[3]);
+
+	glm::mat3 rotation(matrix);
+	for (int column = 0; column < 3; column++) {
+		transform.scaling[column] = glm::length(rotation[column]);
+		if (transform.scaling[column] < tolerance) {
+			return std::nullopt;
+		}
+		rotation[column] /= transform.scaling[column];
+	}
+	if (glm::determinant(rotation) < 0.0f) {
+		transform.scaling.x = -transform.scaling.x;
+		rotation[0] = -rotation[0];
+	}
+
+	float rotX, rotY, rotZ;
+	glm::extractEulerAngleXYZ(glm::mat4(rotation), rotX, rotY, rotZ);
+	transform.rotation = {glm::degrees(rotX), glm::degrees(rotY), glm::degrees(rotZ)};
+
+	// Shear survives the steps above unnoticed: only accept the result if it reproduces the matrix.
+	auto recomposed = transformMatrix(transform);
+	for (int column = 0; column < 4; column++) {
+		for (int row = 0; row < 4; row++) {
+			if (std::abs(recomposed[column][row] - matrix[column][row]) > tolerance * std::max(1.0f, std::abs(matrix[column][row]))) {
+				return std::nullopt;
+			}
+		}
+	}
+	return transform;
+}
+
+namespace {
+
+bool hasStaticTransform(const core::Project& project, const user_types::SNode& node) {
+	for (const auto& property : {&user_types::Node::translation_, &user_types::Node::rotation_, &user_types::Node::scaling_}) {
+		if (!core::Queries::getLinksConnectedToPropertySubtree(project, core::ValueHandle(node, property), false, true).empty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool isFlattenCandidate(const core::Project& project, const user_types::SNode& node) {
+	if (!node->isType<user_types::Node>() || !*node->visibility_ || !*node->enabled_) {
+		return false;
+	}
+	if (!core::Queries::getLinksConnectedToObject(project, node, true, true).empty()) {
+		return false;
+	}
+	for (const auto& weakReferrer : node->referencesToThis()) {
+		auto referrer = weakReferrer.lock();
+		if (referrer && referrer != node->getParent()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+core::SEditorObjectSet findFlattenableNodes(const core::Project& project) {
+	core::SEditorObjectSet flattened;
+
+	// parentTransform is the combined transformation of the flattened ancestors up to the closest ancestor which is kept.
+	std::function<void(const core::SEditorObject&, const glm::mat4&)> visit = [&](const core::SEditorObject& object, const glm::mat4& parentTransform) {
+		auto node = object->as<user_types::Node>();
+		if (!node) {
+			return;
+		}
+		auto transform = parentTransform * transformMatrix(nodeTransform(node));
+
+		// Only intermediate nodes are flattened, leaf nodes are kept.
+		bool flatten = isFlattenCandidate(project, node);
+		bool hasChildNodes = false;
+		for (const auto& child : *node) {
+			auto childNode = child->as<user_types::Node>();
+			if (flatten && childNode) {
+				hasChildNodes = true;
+				flatten = hasStaticTransform(project, childNode) && decomposeTransform(transform * transformMatrix(nodeTransform(childNode))).has_value();
+			}
+		}
+		flatten = flatten && hasChildNodes;
+		if (flatten) {
+			flattened.insert(node);
+		}
+
+		for (const auto& child : *node) {
+			visit(child, flatten ? transform : glm::mat4(1.0f));
+		}
+	};
+
+	// Nodes inside Prefabs are skipped since the Prefab itself is a root but not a node.
+	for (const auto& object : project.instances()) {
+		if (!object->getParent()) {
+			visit(object, glm::mat4(1.0f));
+		}
+	}
+	return flattened;
+}
+
+}  // namespace raco::ramses_adaptor
@@ -14,6 +14,7 @@
 #include "core/Queries.h"
 #include "log_system/log.h"
 #include "ramses_adaptor/ObjectAdaptor.h"
+#include "ramses_adaptor/SceneAdaptor.h"
 #include "user_types/EngineTypeAnnotation.h"
 #include "user_types/LuaInterface.h"
 #include "user_types/SyncTableWithEngineInterface.h"
@@ -22,13 +23,17 @@ namespace raco::ramses_adaptor {
 
 namespace {
 
-LinkAdaptor::UniqueEngineLink createEngineLink(ramses::LogicEngine* engine, ramses::Property& origin, ramses::Property& dest, bool isWeak) {
+LinkAdaptor::UniqueEngineLink createEngineLink(ramses::LogicEngine* engine, LinkStatistics* statistics, ramses::Property& origin, ramses::Property& dest, bool isWeak) {
 	if (isWeak ? engine->linkWeak(origin, dest) : engine->link(origin, dest)) {
 		LOG_TRACE(log_system::RAMSES_ADAPTOR, "Create LogicEngine link: {}:{}->{}:{}", fmt::ptr(&origin), origin.getName(), fmt::ptr(&dest), dest.getName());
-		return {new LinkAdaptor::EngineLink{&origin, &dest}, [engine](LinkAdaptor::EngineLink* link) {
+		++statistics->engineLinks;
+		return {new LinkAdaptor::EngineLink{&origin, &dest}, [engine, statistics](LinkAdaptor::EngineLink* link) {
 					bool success = engine->unlink(*link->origin, *link->dest);
 					LOG_TRACE(log_system::RAMSES_ADAPTOR, "Destroy LogicEngine link: {}->{} ({})", fmt::ptr(link->origin), fmt::ptr(link->dest), success);
 					assert(success);
+					if (success) {
+						++statistics->engineUnlinks;
+					}
 				}};
 	} else {
 		LOG_WARNING(log_system::RAMSES_ADAPTOR, "Create LogicEngine link failed: {}->{}", fmt::ptr(&origin), fmt::ptr(&dest));
@@ -70,8 +75,40 @@ std::optional<core::PropertyDescriptor> followLinkChain(const core::Project& pro
 
 }  // namespace
 
+LinkCommit::LinkCommit(SceneAdaptor* sceneAdaptor, LinkStatistics& statistics) : sceneAdaptor_(sceneAdaptor), statistics_(statistics) {
+}
+
+ramses::Property* LinkCommit::property(const core::SEditorObject& object, const std::vector<std::string_view>& propertyNames) {
+	auto providerIt = providers_.find(object);
+	if (providerIt == providers_.end()) {
+		providerIt = providers_.emplace(object, dynamic_cast<ILogicPropertyProvider*>(sceneAdaptor_->lookupAdaptor(object))).first;
+	}
+	auto provider = providerIt->second;
+	if (!provider) {
+		return nullptr;
+	}
+
+	std::string path;
+	for (const auto& name : propertyNames) {
+		path.append(name).push_back('\0');
+	}
+	auto propIt = properties_.find({provider, path});
+	if (propIt == properties_.end()) {
+		++statistics_.propertyLookups;
+		propIt = properties_.emplace(std::make_pair(provider, std::move(path)), provider->getProperty(propertyNames)).first;
+	}
+	return propIt->second;
+}
+
+ramses::LogicEngine& LinkCommit::logicEngine() {
+	return sceneAdaptor_->logicEngine();
+}
+
+LinkStatistics& LinkCommit::statistics() {
+	return statistics_;
+}
+
 LinkAdaptor::LinkAdaptor(const core::LinkDescriptor& link, SceneAdaptor* sceneAdaptor) : editorLink_{link}, sceneAdaptor_{sceneAdaptor} {
-	connect();
 }
 
 void LinkAdaptor::lift() {
@@ -79,11 +116,11 @@ void LinkAdaptor::lift() {
 	engineLinks_.clear();
 }
 
-void LinkAdaptor::connectHelper(const core::ValueHandle& start, const core::ValueHandle& end, bool isWeak) {
+void LinkAdaptor::connectHelper(LinkCommit& commit, const core::ValueHandle& start, const core::ValueHandle& end, bool isWeak) {
 	if (!core::Queries::isEnginePrimitive(end)) {
 		for (size_t index = 0; index < end.size(); index++) {
 			auto endChild = end[index];
-			connectHelper(start.get(endChild.getPropName()), endChild, isWeak);
+			connectHelper(commit, start.get(endChild.getPropName()), endChild, isWeak);
 		}
 	} else {
 		std::optional<core::PropertyDescriptor> startPropOpt = start.getDescriptor();
@@ -92,15 +129,11 @@ void LinkAdaptor::connectHelper(const core::ValueHandle& start, const core::Valu
 		}
 		if (startPropOpt) {
 			auto startProp = startPropOpt.value();
-			if (auto startAdaptor = sceneAdaptor_->lookupAdaptor(startProp.object())) {
-				const auto& names = startProp.propertyNames();
-				if (auto startEngineProp = dynamic_cast<ILogicPropertyProvider*>(startAdaptor)->getProperty({names.begin(), names.end()})) {
-					if (auto endAdaptor = sceneAdaptor_->lookupAdaptor(editorLink_.end.object())) {
-						if (auto endEngineProp = dynamic_cast<ILogicPropertyProvider*>(endAdaptor)->getProperty(end.getPropertyNamesVector())) {
-							if (auto engineLink = createEngineLink(&sceneAdaptor_->logicEngine(), *startEngineProp, *endEngineProp, isWeak)) {
-								engineLinks_.emplace_back(std::move(engineLink));
-							}
-						}
+			const auto& names = startProp.propertyNames();
+			if (auto startEngineProp = commit.property(startProp.object(), {names.begin(), names.end()})) {
+				if (auto endEngineProp = commit.property(editorLink_.end.object(), end.getPropertyNamesVector())) {
+					if (auto engineLink = createEngineLink(&commit.logicEngine(), &commit.statistics(), *startEngineProp, *endEngineProp, isWeak)) {
+						engineLinks_.emplace_back(std::move(engineLink));
 					}
 				}
 			}
@@ -108,7 +141,7 @@ void LinkAdaptor::connectHelper(const core::ValueHandle& start, const core::Valu
 	}	
 }
 
-void LinkAdaptor::connect() {
+void LinkAdaptor::connect(LinkCommit& commit) {
 	LOG_TRACE(log_system::RAMSES_ADAPTOR, "Connect editor link: {}", editorLink_);
 	engineLinks_.clear();
 
@@ -117,7 +150,7 @@ void LinkAdaptor::connect() {
 	}
 
 	if (editorLink_.isValid) {
-		connectHelper(core::ValueHandle(editorLink_.start), core::ValueHandle(editorLink_.end), editorLink_.isWeak);
+		connectHelper(commit, core::ValueHandle(editorLink_.start), core::ValueHandle(editorLink_.end), editorLink_.isWeak);
 	}
 }
 
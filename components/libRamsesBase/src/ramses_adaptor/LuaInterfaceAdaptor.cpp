@@ -14,7 +14,7 @@
 #include "ramses_adaptor/LuaScriptModuleAdaptor.h"
 #include "user_types/LuaScript.h"
 #include "user_types/PrefabInstance.h"
-#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
 
 namespace raco::ramses_adaptor {
 
@@ -115,7 +115,8 @@ bool LuaInterfaceAdaptor::sync(core::Errors* errors) {
 	ObjectAdaptor::sync(errors);
 
 	if (recreateStatus_) {
-		auto interfaceText = utils::file::read(core::PathQueries::resolveUriPropertyToAbsolutePath(sceneAdaptor_->project(), {editorObject_, &user_types::LuaInterface::uri_}));
+		auto sharedText = utils::SourceTextStore::instance().readOrEmpty(core::PathQueries::resolveUriPropertyToAbsolutePath(sceneAdaptor_->project(), {editorObject_, &user_types::LuaInterface::uri_}));
+		const std::string& interfaceText = *sharedText;
 		LOG_TRACE(log_system::RAMSES_ADAPTOR, "{}: {}", generateRamsesObjectName(), interfaceText);
 		ramsesInterface_.reset();
 
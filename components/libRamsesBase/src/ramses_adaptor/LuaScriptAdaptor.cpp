@@ -14,7 +14,7 @@
 #include "ramses_adaptor/utilities.h"
 #include "ramses_base/Utils.h"
 #include "user_types/PrefabInstance.h"
-#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
 
 namespace raco::ramses_adaptor {
 
@@ -87,7 +87,8 @@ bool LuaScriptAdaptor::sync(core::Errors* errors) {
 	ObjectAdaptor::sync(errors);
 
 	if (recreateStatus_) {
-		auto scriptContent = utils::file::read(core::PathQueries::resolveUriPropertyToAbsolutePath(sceneAdaptor_->project(), {editorObject_, &user_types::LuaScript::uri_}));
+		auto sharedText = utils::SourceTextStore::instance().readOrEmpty(core::PathQueries::resolveUriPropertyToAbsolutePath(sceneAdaptor_->project(), {editorObject_, &user_types::LuaScript::uri_}));
+		const std::string& scriptContent = *sharedText;
 		LOG_TRACE(log_system::RAMSES_ADAPTOR, "{}: {}", generateRamsesObjectName(), scriptContent);
 		luaScript_.reset();
 		if (!scriptContent.empty()) {
@@ -23,7 +23,7 @@
 #include "user_types/Material.h"
 #include "user_types/RenderBuffer.h"
 #include "user_types/RenderBufferMS.h"
-#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
 
 #include "user_types/EngineTypeAnnotation.h"
 
@@ -76,11 +76,11 @@ bool MaterialAdaptor::sync(core::Errors* errors) {
 	appearance_.reset();
 
 	if (editorObject()->isShaderValid()) {
-		std::string const vertexShader{user_types::Material::loadShader(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriVertex_})};
-		std::string const fragmentShader{user_types::Material::loadShader(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriFragment_})};
-		std::string const geometryShader{user_types::Material::loadShader(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriGeometry_})};
-		std::string const shaderDefines = utils::file::read(core::PathQueries::resolveUriPropertyToAbsolutePath(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriDefines_}));
-		auto const effectDescription = ramses_base::createEffectDescription(vertexShader, geometryShader, fragmentShader, shaderDefines);
+		auto const vertexShader{user_types::Material::loadShader(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriVertex_})};
+		auto const fragmentShader{user_types::Material::loadShader(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriFragment_})};
+		auto const geometryShader{user_types::Material::loadShader(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriGeometry_})};
+		auto const shaderDefines = utils::SourceTextStore::instance().readOrEmpty(core::PathQueries::resolveUriPropertyToAbsolutePath(sceneAdaptor_->project(), {editorObject(), &user_types::Material::uriDefines_}));
+		auto const effectDescription = ramses_base::createEffectDescription(*vertexShader, *geometryShader, *fragmentShader, *shaderDefines);
 		reset(ramses_base::ramsesEffect(sceneAdaptor_->scene(), *effectDescription, {}, editorObject_->objectIDAsRamsesLogicID()));
 	} else {
 		reset(createEffect(sceneAdaptor_));
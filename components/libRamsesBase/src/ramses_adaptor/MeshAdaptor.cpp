@@ -14,6 +14,7 @@
 #include "ramses_adaptor/utilities.h"
 #include "ramses_base/RamsesHandles.h"
 #include "user_types/Mesh.h"
+#include <set>
 #include <unordered_map>
 
 namespace raco::ramses_adaptor {
@@ -38,6 +39,14 @@ const VertexDataMap& MeshAdaptor::vertexData() const {
 	return vertexDataMap_;
 }
 
+VertexDataLayout MeshAdaptor::vertexDataLayout(const std::string& attribName) const {
+	auto it = vertexDataLayout_.find(attribName);
+	if (it != vertexDataLayout_.end()) {
+		return it->second;
+	}
+	return {};
+}
+
 bool MeshAdaptor::isValid() {
 	auto mesh = editorObject_->meshData();
 	return mesh.get() != nullptr;
@@ -50,13 +59,29 @@ bool MeshAdaptor::sync(core::Errors* errors) {
 		auto indices = mesh->getIndices();
 		indices_ = ramsesArrayResource(sceneAdaptor_->scene(), indices, std::string(this->editorObject_->objectName() + "_MeshIndexData").c_str());
 
-		for (uint32_t i{0}; i < mesh->numAttributes(); i++) {
-			auto name = mesh->attribName(i);
-			std::string attribName = this->editorObject_->objectName() + "_MeshVertexData_" + name;
-			vertexDataMap_[name] = arrayResourceFromAttribute(sceneAdaptor_->scene(), mesh, i, attribName); 
+		vertexDataMap_.clear();
+		vertexDataLayout_.clear();
+		std::optional<InterleavedVertexData> interleaved;
+		if (sceneAdaptor_->interleaveVertexData()) {
+			interleaved = interleaveVertexAttributes(*mesh);
+		}
+		if (interleaved) {
+			std::string bufferName = this->editorObject_->objectName() + "_MeshVertexData";
+			auto buffer = ramsesArrayResource(sceneAdaptor_->scene(), static_cast<uint32_t>(interleaved->data.size()), interleaved->data.data(), bufferName);
+			for (const auto& attribute : interleaved->attributes) {
+				vertexDataMap_[attribute.name] = buffer;
+				vertexDataLayout_[attribute.name] = {attribute.offset, interleaved->stride};
+			}
+		} else {
+			for (uint32_t i{0}; i < mesh->numAttributes(); i++) {
+				auto name = mesh->attribName(i);
+				std::string attribName = this->editorObject_->objectName() + "_MeshVertexData_" + name;
+				vertexDataMap_[name] = arrayResourceFromAttribute(sceneAdaptor_->scene(), mesh, i, attribName);
+			}
 		}
 	} else {
 		vertexDataMap_.clear();
+		vertexDataLayout_.clear();
 		indices_.reset();
 	}
 	tagDirty(false);
@@ -72,8 +97,12 @@ std::vector<ExportInformation> MeshAdaptor::getExportInformation() const {
 
 	result.emplace_back(indices_.get()->getType(), indices_->getName());
 
+	// All attributes share the same resource if the vertex data is interleaved.
+	std::set<const ramses::ArrayResource*> resources;
 	for (const auto& item : vertexDataMap_)	{
-		result.emplace_back(ramses::ERamsesObjectType::ArrayResource, item.second->getName());
+		if (resources.insert(item.second.get()).second) {
+			result.emplace_back(ramses::ERamsesObjectType::ArrayResource, item.second->getName());
+		}
 	}
 
 	return result;
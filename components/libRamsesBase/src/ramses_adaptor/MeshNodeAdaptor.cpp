@@ -11,6 +11,7 @@
 
 #include "user_types/CubeMap.h"
 #include "user_types/EngineTypeAnnotation.h"
+#include "user_types/Skin.h"
 #include "user_types/Texture.h"
 
 #include "ramses_adaptor/SceneAdaptor.h"
@@ -31,7 +32,20 @@ MeshNodeAdaptor::MeshNodeAdaptor(SceneAdaptor* sceneAdaptor, user_types::SMeshNo
 
 	  instanceCountSubscription_{sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{node, &user_types::MeshNode::instanceCount_}, [this] {
 		  tagDirty();
-	  })} {
+	  })},
+
+	  uniformLinksLifecycle_{sceneAdaptor->dispatcher()->registerOnLinksLifeCycleForEnd(
+		  node,
+		  [this](const core::LinkDescriptor&) {
+			  if (sharePrivateAppearance()) {
+				  tagDirty();
+			  }
+		  },
+		  [this](const core::LinkDescriptor&) {
+			  if (sharePrivateAppearance()) {
+				  tagDirty();
+			  }
+		  })} {
 	setupMaterialSubscription();
 	setupUniformChildrenSubscription();
 }
@@ -113,6 +127,19 @@ const ramses_base::RamsesAppearanceBinding& MeshNodeAdaptor::appearanceBinding()
 	return appearanceBinding_;
 }
 
+bool MeshNodeAdaptor::isSkinTarget() const {
+	for (const auto& weakReferrer : editorObject()->referencesToThis()) {
+		auto referrer = weakReferrer.lock();
+		if (referrer && referrer->isType<user_types::Skin>()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool MeshNodeAdaptor::skinTargetChanged() const {
+	return skinTarget_ != isSkinTarget();
+}
 
 bool MeshNodeAdaptor::sync(core::Errors* errors) {
 	errors->removeIf([this](core::ErrorItem const& error) {
@@ -156,20 +183,31 @@ void MeshNodeAdaptor::syncMaterial(core::Errors* errors, size_t index) {
 
 	appearanceBinding_.reset();
 	privateAppearance_.reset();
+	skinTarget_ = isSkinTarget();
 
 	if (auto materialAdapt = materialAdaptor(index)) {
 		LOG_TRACE(log_system::RAMSES_ADAPTOR, "using materialAdaptor (valid)");
 		if (editorObject()->materialPrivate(index)) {
-			privateAppearance_ = ramses_base::ramsesAppearance(sceneAdaptor_->scene(), materialAdapt->getRamsesObjectPointer(), editorObject_->objectIDAsRamsesLogicID());
-			currentAppearance_ = privateAppearance_;
-
-			appearanceBinding_ = ramses_base::ramsesAppearanceBinding(*privateAppearance_->get(), &sceneAdaptor_->logicEngine(), editorObject()->objectName() + "_AppearanceBinding", editorObject_->objectIDAsRamsesLogicID());
-
 			core::ValueHandle optionsHandle = editorObject()->getMaterialOptionsHandle(index);
 			core::ValueHandle uniformsHandle = editorObject()->getUniformContainerHandle(index);
-			updateAppearance(errors, sceneAdaptor_, privateAppearance_, *editorObject()->getOptions(index), optionsHandle, uniformsHandle);
+			auto createAppearance = [this, materialAdapt]() {
+				auto appearance = ramses_base::ramsesAppearance(sceneAdaptor_->scene(), materialAdapt->getRamsesObjectPointer(), editorObject_->objectIDAsRamsesLogicID());
+				(*appearance)->setName(std::string(this->editorObject()->objectName() + "_Appearance").c_str());
+				return appearance;
+			};
+
+			if (sharePrivateAppearance() && !skinTarget_ && core::Queries::getLinksConnectedToPropertySubtree(sceneAdaptor_->project(), uniformsHandle, false, true).empty()) {
+				// Without links and skin the appearance only depends on the option and uniform values and doesn't need a binding.
+				auto key = fmt::format("{}|{}", fmt::ptr(materialAdapt->getRamsesObjectPointer().get()), privateMaterialKey(optionsHandle, uniformsHandle));
+				privateAppearance_ = sceneAdaptor_->sharedAppearance(key, createAppearance);
+			} else {
+				privateAppearance_ = createAppearance();
+				appearanceBinding_ = ramses_base::ramsesAppearanceBinding(*privateAppearance_->get(), &sceneAdaptor_->logicEngine(), editorObject()->objectName() + "_AppearanceBinding", editorObject_->objectIDAsRamsesLogicID());
+			}
+			currentAppearance_ = privateAppearance_;
 
-			(*privateAppearance_)->setName(std::string(this->editorObject()->objectName() + "_Appearance").c_str());
+			// Updating a shared appearance again with the same values refreshes the texture samplers it uses.
+			updateAppearance(errors, sceneAdaptor_, privateAppearance_, *editorObject()->getOptions(index), optionsHandle, uniformsHandle);
 		} else {
 			currentAppearance_ = materialAdapt->appearance();
 		}
@@ -181,6 +219,10 @@ void MeshNodeAdaptor::syncMaterial(core::Errors* errors, size_t index) {
 	ramsesObject().setAppearance(currentAppearance_);
 }
 
+bool MeshNodeAdaptor::sharePrivateAppearance() const {
+	return sceneAdaptor_->optimizeForExport() && sceneAdaptor_->exportOptimizations().sharePrivateAppearances;
+}
+
 void MeshNodeAdaptor::syncMeshObject() {
 	auto geometry = ramses_base::ramsesGeometry(sceneAdaptor_->scene(), currentAppearance_->effect(), editorObject()->objectIDAsRamsesLogicID());
 	(*geometry)->setName(std::string(this->editorObject()->objectName() + "_Geometry").c_str());
@@ -195,7 +237,8 @@ void MeshNodeAdaptor::syncMeshObject() {
 
 			auto it = vertexData.find(attribName);
 			if (it != vertexData.end()) {
-				geometry->addAttributeBuffer(attribInput, it->second);
+				auto layout = meshAdapt->vertexDataLayout(attribName);
+				geometry->addAttributeBuffer(attribInput, it->second, layout.offset, layout.stride);
 			} else {
 				LOG_ERROR(log_system::RAMSES_ADAPTOR, "Attrribute mismatch in MeshNode '{}': attribute '{}' required by Material '{}' not found in Mesh '{}'.", editorObject()->objectName(), attribName, material(0)->objectName(), mesh()->objectName());
 			}
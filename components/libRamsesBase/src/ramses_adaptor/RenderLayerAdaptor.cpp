@@ -17,22 +17,19 @@
 #include "user_types/Enumerations.h"
 #include "user_types/MeshNode.h"
 
-#include "core/Queries_Tags.h"
 
 namespace raco::ramses_adaptor {
 
 RenderLayerAdaptor::RenderLayerAdaptor(SceneAdaptor* sceneAdaptor, std::shared_ptr<user_types::RenderLayer> editorObject)
 	: TypedObjectAdaptor(sceneAdaptor, editorObject, ramses_base::ramsesRenderGroup(sceneAdaptor->scene(), editorObject->objectIDAsRamsesLogicID())),
-	  subscriptions_{sceneAdaptor->dispatcher()->registerOnObjectsLifeCycle([this](SEditorObject obj) { tagDirty(); }, [this](SEditorObject obj) { tagDirty(); }),
-		  sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{editorObject, &user_types::RenderLayer::objectName_}, [this]() { tagDirty(); }),
+	  subscriptions_{sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{editorObject, &user_types::RenderLayer::objectName_}, [this]() { tagDirty(); }),
 		  sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{editorObject, &user_types::RenderLayer::renderableTags_}, [this]() { tagDirty(); }),
 		  sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{editorObject, &user_types::RenderLayer::materialFilterTags_}, [this]() { tagDirty(); }),
 		  sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{editorObject, &user_types::RenderLayer::materialFilterMode_}, [this]() { tagDirty(); }),
 		  sceneAdaptor->dispatcher()->registerOn(core::ValueHandle{editorObject, &user_types::RenderLayer::sortOrder_}, [this]() { tagDirty(); }),
-		  sceneAdaptor->dispatcher()->registerOnChildren(core::ValueHandle{editorObject, &user_types::RenderLayer::renderableTags_}, [this](auto) { tagDirty(); }),
-		  sceneAdaptor->dispatcher()->registerOnPropertyChange("children", [this](core::ValueHandle handle) { tagDirty(); }),
-		  sceneAdaptor->dispatcher()->registerOnPropertyChange("tags", [this](core::ValueHandle handle) { tagDirty(); }),
-		  sceneAdaptor->dispatcher()->registerOnPropertyChange("renderableTags", [this](core::ValueHandle handle) { tagDirty(); })} {
+		  sceneAdaptor->dispatcher()->registerOnChildren(core::ValueHandle{editorObject, &user_types::RenderLayer::renderableTags_}, [this](auto) { tagDirty(); })} {
+	// Changes of the scenegraph, of tags and of materials are tracked by the TagMatchTable. The SceneAdaptor only tags
+	// the render layers dirty which use the affected tags, see TagMatchTable::takeAffectedRenderLayers.
 }
 
 void RenderLayerAdaptor::buildRenderGroup(core::Errors* errors) {
@@ -45,18 +42,16 @@ void RenderLayerAdaptor::buildRenderGroup(core::Errors* errors) {
 
 	binding_.reset();
 
-	std::vector<SEditorObject> topLevelNodes;
 	std::vector<user_types::SRenderLayer> layers;
 	for (auto const& child : sceneAdaptor_->project().instances()) {
-		if (!child->getParent() && child->as<user_types::Node>()) {
-			topLevelNodes.emplace_back(child);
-		}
 		if (auto layer = child->as<user_types::RenderLayer>()) {
 			layers.emplace_back(layer);
 		}
 	}
 
-	std::set<std::string> materialTags{editorObject()->materialFilterTags()};
+	auto& tagTable = sceneAdaptor_->tagMatchTable();
+	auto materialTags = editorObject()->materialFilterTags();
+	TagBits materialTagBits = tagTable.bits(materialTags);
 	
 	user_types::ERenderLayerOrder sortOrder = static_cast<user_types::ERenderLayerOrder>(*editorObject()->sortOrder_);
 	bool sceneGraphOrder = sortOrder == user_types::ERenderLayerOrder::SceneGraph;
@@ -67,6 +62,7 @@ void RenderLayerAdaptor::buildRenderGroup(core::Errors* errors) {
 
 	for (size_t index = 0; index < editorObject()->renderableTags_->size(); index++) {
 		auto const& renderableTag = editorObject()->renderableTags_->name(index);
+		auto renderableTagId = tagTable.intern(renderableTag);
 
 		ramses_base::RamsesRenderGroup container;
 
@@ -81,8 +77,8 @@ void RenderLayerAdaptor::buildRenderGroup(core::Errors* errors) {
 			container->setName((editorObject()->objectName() + "." + renderableTag).c_str());
 		}
 
-		buildRenderableOrder(errors, container, topLevelNodes, renderableTag, false, materialTags, *editorObject()->materialFilterMode_ == static_cast<int>(user_types::ERenderLayerMaterialFilterMode::Exclusive), orderIndex, sceneGraphOrder);
-		addNestedLayers(errors, container, layers, renderableTag, orderIndex, sceneGraphOrder);
+		buildRenderableOrder(errors, container, renderableTagId, materialTagBits, !materialTags.empty(), *editorObject()->materialFilterMode_ == static_cast<int>(user_types::ERenderLayerMaterialFilterMode::Exclusive), orderIndex, sceneGraphOrder);
+		addNestedLayers(errors, container, layers, renderableTagId, orderIndex, sceneGraphOrder);
 
 		if (!sceneGraphOrder && (!sceneAdaptor_->optimizeForExport() || !container->empty())) {
 			ramsesObject().addRenderGroup(container, orderIndex);
@@ -98,67 +94,72 @@ void RenderLayerAdaptor::buildRenderGroup(core::Errors* errors) {
 	}
 }
 
-void RenderLayerAdaptor::buildRenderableOrder(core::Errors* errors, ramses_base::RamsesRenderGroup container, std::vector<SEditorObject>& objs, const std::string& tag, bool parentActive, const std::set<std::string>& materialFilterTags, bool materialFilterExclusive, int32_t& orderIndex, bool sceneGraphOrder) {
+bool RenderLayerAdaptor::isInMaterialFilter(const SEditorObject& meshnode, const TagBits& materialFilterTags, bool haveMaterialFilterTags, bool materialFilterExclusive) {
+	// Same as core::Queries::isMeshNodeInMaterialFilter but using the interned tags.
+	if (!haveMaterialFilterTags) {
+		return materialFilterExclusive;
+	}
+	auto material = meshnode->as<user_types::MeshNode>()->getMaterial(0);
+	if (!material) {
+		return materialFilterExclusive;
+	}
+	bool matHasTag = sceneAdaptor_->tagMatchTable().objectTags(material).intersects(materialFilterTags);
+	return matHasTag != materialFilterExclusive;
+}
 
-	for (const auto& obj : objs) {
-		bool currentActive = parentActive || core::Queries::hasObjectTag(obj->as<user_types::Node>(), tag);
+void RenderLayerAdaptor::buildRenderableOrder(core::Errors* errors, ramses_base::RamsesRenderGroup container, uint32_t tag, const TagBits& materialFilterTags, bool haveMaterialFilterTags, bool materialFilterExclusive, int32_t orderIndex, bool sceneGraphOrder) {
+	// The entries contain the tags inherited from the ancestors, so a mesh node is active if its entry has the tag.
+	// Only the mesh nodes having the tag are visited.
+	auto& tagTable = sceneAdaptor_->tagMatchTable();
+	const auto& sceneGraph = tagTable.sceneGraph();
 
-		if (currentActive) {
-			if (obj->isType<user_types::MeshNode>()) {
-				if (core::Queries::isMeshNodeInMaterialFilter(obj->as<user_types::MeshNode>(), materialFilterTags, materialFilterExclusive)) {
-					auto adaptor = sceneAdaptor_->lookup<MeshNodeAdaptor>(obj);
-					if (sceneGraphOrder) {
-						if (ramsesObject().containsMeshNode(adaptor->getRamsesObjectPointer())) {
-							if (ramsesObject().getMeshNodeOrder(adaptor->getRamsesObjectPointer()) != orderIndex) {
-								const auto errorMsg = fmt::format("Mesh node '{}' has been added to render layer '{}' more than once with different priorities.", obj->objectName(), editorObject()->objectName());
-								errors->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::WARNING, {editorObject()->shared_from_this(), &user_types::RenderLayer::renderableTags_}, errorMsg);
-								LOG_WARNING(log_system::RAMSES_ADAPTOR, errorMsg);
-							}
-						} else {
-							container->addMeshNode(adaptor->getRamsesObjectPointer(), orderIndex);
-						}
-					} else {
-						if (std::any_of(getRamsesObjectPointer()->containedRenderGroups().begin(), getRamsesObjectPointer()->containedRenderGroups().end(), [adaptor, container](const auto& item) {
-							return item.first->containsMeshNode(adaptor->getRamsesObjectPointer()) && item.first != container;
-							})) {
-							const auto errorMsg = fmt::format("Mesh node '{}' has been added to render layer '{}' via multiple tags.", obj->objectName(), editorObject()->objectName());
-							errors->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::ERROR, {editorObject()->shared_from_this(), &user_types::RenderLayer::renderableTags_}, errorMsg);
-							LOG_ERROR(log_system::RAMSES_ADAPTOR, errorMsg);
-						} else {
-							container->addMeshNode(adaptor->getRamsesObjectPointer(), orderIndex);
-						}
-					}
-				}
-			}
+	for (auto index : tagTable.meshNodes(tag)) {
+		const auto& entry = sceneGraph[index];
+		if (!isInMaterialFilter(entry.object, materialFilterTags, haveMaterialFilterTags, materialFilterExclusive)) {
+			continue;
 		}
 
+		const auto& obj = entry.object;
+		auto adaptor = sceneAdaptor_->lookup<MeshNodeAdaptor>(obj);
 		if (sceneGraphOrder) {
 			// Make sure the orderIndex leaves all mesh nodes in scene graph order, even if they belong to different tags.
-			++orderIndex;
-		}
-
-		if (obj->children_->size() > 0) {
-			auto vec = obj->children_->asVector<SEditorObject>();
-			buildRenderableOrder(errors, container, vec, tag, currentActive, materialFilterTags, materialFilterExclusive, orderIndex, sceneGraphOrder);
+			auto sceneGraphIndex = static_cast<int32_t>(index);
+			if (ramsesObject().containsMeshNode(adaptor->getRamsesObjectPointer())) {
+				if (ramsesObject().getMeshNodeOrder(adaptor->getRamsesObjectPointer()) != sceneGraphIndex) {
+					const auto errorMsg = fmt::format("Mesh node '{}' has been added to render layer '{}' more than once with different priorities.", obj->objectName(), editorObject()->objectName());
+					errors->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::WARNING, {editorObject()->shared_from_this(), &user_types::RenderLayer::renderableTags_}, errorMsg);
+					LOG_WARNING(log_system::RAMSES_ADAPTOR, errorMsg);
+				}
+			} else {
+				container->addMeshNode(adaptor->getRamsesObjectPointer(), sceneGraphIndex);
+			}
+		} else {
+			if (std::any_of(getRamsesObjectPointer()->containedRenderGroups().begin(), getRamsesObjectPointer()->containedRenderGroups().end(), [adaptor, container](const auto& item) {
+				return item.first->containsMeshNode(adaptor->getRamsesObjectPointer()) && item.first != container;
+				})) {
+				const auto errorMsg = fmt::format("Mesh node '{}' has been added to render layer '{}' via multiple tags.", obj->objectName(), editorObject()->objectName());
+				errors->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::ERROR, {editorObject()->shared_from_this(), &user_types::RenderLayer::renderableTags_}, errorMsg);
+				LOG_ERROR(log_system::RAMSES_ADAPTOR, errorMsg);
+			} else {
+				container->addMeshNode(adaptor->getRamsesObjectPointer(), orderIndex);
+			}
 		}
 	}
 }
 
 namespace {
-bool containsLayer(const std::vector<user_types::SRenderLayer>& allLayers, user_types::SRenderLayer rootLayer, user_types::SRenderLayer queriedChild) {
+bool containsLayer(TagMatchTable& tagTable, const std::vector<user_types::SRenderLayer>& allLayers, user_types::SRenderLayer rootLayer, user_types::SRenderLayer queriedChild) {
+	TagBits rootTags;
 	for (size_t index = 0; index < rootLayer->renderableTags_->size(); index++) {
-		auto const& rootTag = rootLayer->renderableTags_->name(index);
-		if (core::Queries::hasObjectTag(queriedChild, rootTag)) {
-			return true;
-		}
+		rootTags.set(tagTable.intern(rootLayer->renderableTags_->name(index)));
 	}
-	for (size_t index = 0; index < rootLayer->renderableTags_->size(); index++) {
-		auto const& rootTag = rootLayer->renderableTags_->name(index);
-		for (auto layer : allLayers) {
-			if (core::Queries::hasObjectTag(layer, rootTag)) {
-				if (containsLayer(allLayers, layer, queriedChild)) {
-					return true;
-				}
+	if (tagTable.objectTags(queriedChild).intersects(rootTags)) {
+		return true;
+	}
+	for (auto layer : allLayers) {
+		if (tagTable.objectTags(layer).intersects(rootTags)) {
+			if (containsLayer(tagTable, allLayers, layer, queriedChild)) {
+				return true;
 			}
 		}
 	}
@@ -167,16 +168,17 @@ bool containsLayer(const std::vector<user_types::SRenderLayer>& allLayers, user_
 }
 }
 
-void RenderLayerAdaptor::addNestedLayers(core::Errors* errors, ramses_base::RamsesRenderGroup container, const std::vector<user_types::SRenderLayer>& layers, const std::string& tag, int32_t orderIndex, bool sceneGraphOrder) {
+void RenderLayerAdaptor::addNestedLayers(core::Errors* errors, ramses_base::RamsesRenderGroup container, const std::vector<user_types::SRenderLayer>& layers, uint32_t tag, int32_t orderIndex, bool sceneGraphOrder) {
+	auto& tagTable = sceneAdaptor_->tagMatchTable();
 	for (auto layer : layers) {
-		if (core::Queries::hasObjectTag(layer, tag)) {
+		if (tagTable.objectTags(layer).test(tag)) {
 			if (sceneGraphOrder) {
 				const auto errorMsg = fmt::format("Render layer '{}' is using ordering by 'Scene Graph' but contains render layers. The render layers will be ignored.", editorObject()->objectName());
 				errors->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::ERROR, {editorObject()->shared_from_this(), &user_types::RenderLayer::sortOrder_}, errorMsg);
 				LOG_ERROR(log_system::RAMSES_ADAPTOR, errorMsg);
 				return;
 			}
-			if (containsLayer(layers, layer, editorObject())) {
+			if (containsLayer(tagTable, layers, layer, editorObject())) {
 				const auto errorMsg = fmt::format("Render layer '{}' contains itself.", editorObject()->objectName());
 				errors->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::WARNING, {editorObject()->shared_from_this(), &user_types::RenderLayer::renderableTags_}, errorMsg);
 				LOG_WARNING(log_system::RAMSES_ADAPTOR, errorMsg);
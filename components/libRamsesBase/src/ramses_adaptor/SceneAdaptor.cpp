@@ -11,6 +11,7 @@
 
 #include "components/DataChangeDispatcher.h"
 #include "components/EditorObjectFormatter.h"
+#include "core/CoreFormatter.h"
 #include "core/Iterators.h"
 #include "core/PrefabOperations.h"
 #include "core/Project.h"
@@ -20,6 +21,7 @@
 #include "ramses_adaptor/DefaultRamsesObjects.h"
 #include "ramses_adaptor/Factories.h"
 #include "ramses_adaptor/LuaScriptAdaptor.h"
+#include "ramses_adaptor/MeshNodeAdaptor.h"
 #include "ramses_adaptor/ObjectAdaptor.h"
 #include "ramses_adaptor/OrthographicCameraAdaptor.h"
 #include "ramses_adaptor/PerspectiveCameraAdaptor.h"
@@ -31,26 +33,48 @@
 #include "user_types/Prefab.h"
 #include "core/ProjectSettings.h"
 #include "user_types/RenderPass.h"
+#include "utils/PhaseTracer.h"
+#include "log_system/log.h"
 
 #include <spdlog/fmt/fmt.h>
 
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <tuple>
 #include <unordered_set>
 
 namespace raco::ramses_adaptor {
 
 using namespace raco::ramses_base;
 
-SceneAdaptor::SceneAdaptor(ramses::RamsesClient* client, ramses::sceneId_t id, Project* project, components::SDataChangeDispatcher dispatcher, core::Errors* errors, bool optimizeForExport)
+SceneAdaptor::SceneAdaptor(ramses::RamsesClient* client, ramses::sceneId_t id, Project* project, components::SDataChangeDispatcher dispatcher, core::Errors* errors, bool optimizeForExport, bool interleaveVertexData,
+	std::shared_ptr<ramses_base::TextureCompressor> textureCompressor, ExportOptimizations exportOptimizations)
 	: client_{client},
 	  project_(project),
 	  scene_{ramsesScene(id, client_)},
 	  logicEngine_{ramses_base::BaseEngineBackend::UniqueLogicEngine(scene_->createLogicEngine(), [this](ramses::LogicEngine* logicEngine) { scene_->destroy(*logicEngine); })},
-	  subscription_{dispatcher->registerOnObjectsLifeCycle([this](SEditorObject obj) { createAdaptor(obj); }, [this](SEditorObject obj) { removeAdaptor(obj); })},
+	  subscription_{dispatcher->registerOnObjectsLifeCycle(
+		  [this](SEditorObject obj) {
+			  tagMatchTable_.addObject(obj);
+			  createAdaptor(obj);
+		  },
+		  [this](SEditorObject obj) {
+			  tagMatchTable_.removeObject(obj);
+			  removeAdaptor(obj);
+		  })},
 	  childrenSubscription_(dispatcher->registerOnPropertyChange("children", [this](core::ValueHandle handle) {
 		  adaptorStatusDirty_ = true;
+		  tagMatchTable_.markStructureDirty();
+	  })),
+	  tagsSubscription_(dispatcher->registerOnPropertyChange("tags", [this](core::ValueHandle handle) {
+		  tagMatchTable_.markTagsDirty(handle.rootObject());
+	  })),
+	  renderableTagsSubscription_(dispatcher->registerOnPropertyChange("renderableTags", [this](core::ValueHandle handle) {
+		  tagMatchTable_.markRenderableTagsChanged(handle.rootObject());
+	  })),
+	  materialSubscription_(dispatcher->registerOnPropertyChange("material", [this](core::ValueHandle handle) {
+		  tagMatchTable_.markMaterialChanged(handle.rootObject());
 	  })),
 	  linksLifecycle_{dispatcher->registerOnLinksLifeCycle(
 		  [this](const core::LinkDescriptor& link) { createLink(link); }, 
@@ -59,10 +83,33 @@ SceneAdaptor::SceneAdaptor(ramses::RamsesClient* client, ramses::sceneId_t id, P
 		  [this](const core::LinkDescriptor& link) { changeLinkValidity(link, link.isValid); })},
 	  dispatcher_{dispatcher},
 	  errors_{errors},
-	  optimizeForExport_(optimizeForExport) {
+	  optimizeForExport_(optimizeForExport),
+	  interleaveVertexData_(interleaveVertexData),
+	  textureCompressor_(textureCompressor),
+	  exportOptimizations_(exportOptimizations) {
+	utils::ScopedPhase scenePhase("scene", "SceneAdaptor");
+
+	if (optimizeForExport_ && exportOptimizations_.removeUnusedLogic) {
+		utils::ScopedPhase phase("scene", "findUnusedLogic");
+		unusedLogic_ = findUnusedLogic(*project_);
+	}
+	if (optimizeForExport_ && exportOptimizations_.removeUnusedResources) {
+		utils::ScopedPhase phase("scene", "findUnusedResources");
+		unusedResources_ = findUnusedResources(*project_, unusedLogic_);
+	}
+	if (optimizeForExport_ && exportOptimizations_.flattenStaticTransforms) {
+		utils::ScopedPhase phase("scene", "findFlattenableNodes");
+		flattenedNodes_ = findFlattenableNodes(*project_);
+	}
+	if (optimizeForExport_ && (exportOptimizations_.removeUnusedResources || exportOptimizations_.flattenStaticTransforms || exportOptimizations_.removeUnusedLogic)) {
+		updateExportReport();
+	}
 
-	for (const SEditorObject& obj : project_->instances()) {
-		createAdaptor(obj);
+	{
+		utils::ScopedPhase phase("scene", "createAdaptors");
+		for (const SEditorObject& obj : project_->instances()) {
+			createAdaptor(obj);
+		}
 	}
 
 	dispatcher_->addBulkChangeCallback(id.getValue(), [this](const core::SEditorObjectSet& changedObjects) {
@@ -75,7 +122,10 @@ SceneAdaptor::SceneAdaptor(ramses::RamsesClient* client, ramses::sceneId_t id, P
 
 	const auto& instances{project_->instances()};
 	core::SEditorObjectSet initialBulkUpdate(instances.begin(), instances.end());
-	performBulkEngineUpdate(initialBulkUpdate);
+	{
+		utils::ScopedPhase phase("scene", "initialEngineUpdate");
+		performBulkEngineUpdate(initialBulkUpdate);
+	}
 
 	scene_->flush();
 	scene_->publish(ramses::EScenePublicationMode::LocalAndRemote);
@@ -94,12 +144,117 @@ ramses::sceneId_t SceneAdaptor::sceneId() {
 }
 
 bool SceneAdaptor::needAdaptor(SEditorObject object) {
-	return !core::PrefabOperations::findContainingPrefab(object) && !object->isType<core::ProjectSettings>();
+	return !core::PrefabOperations::findContainingPrefab(object) && !object->isType<core::ProjectSettings>() &&
+		   unusedResources_.find(object) == unusedResources_.end() && unusedLogic_.find(object) == unusedLogic_.end() && !isFlattened(object);
+}
+
+void SceneAdaptor::updateAdaptorStatus(SEditorObject object) {
+	auto adaptor = lookupAdaptor(object);
+
+	bool haveAdaptor = adaptor != nullptr;
+	if (haveAdaptor != needAdaptor(object)) {
+		if (haveAdaptor) {
+			for (auto link : core::Queries::getLinksConnectedToObject(*project_, object, true, true)) {
+				removeLink(link->descriptor());
+			}
+			removeAdaptor(object);
+		} else {
+			createAdaptor(object);
+			for (auto link : core::Queries::getLinksConnectedToObject(*project_, object, true, true)) {
+				createLink(link->descriptor());
+			}
+		}
+	}
+}
+
+void SceneAdaptor::updateExportOptimizations(const SEditorObjectSet& changedObjects) {
+	bool adaptorsChanged = false;
+	if (exportOptimizations_.removeUnusedLogic) {
+		auto unusedLogic = findUnusedLogic(*project_);
+		if (unusedLogic != unusedLogic_) {
+			unusedLogic_ = std::move(unusedLogic);
+			adaptorsChanged = true;
+		}
+	}
+	if (exportOptimizations_.removeUnusedResources) {
+		auto unusedResources = findUnusedResources(*project_, unusedLogic_);
+		if (unusedResources != unusedResources_) {
+			unusedResources_ = std::move(unusedResources);
+			adaptorsChanged = true;
+		}
+	}
+
+	bool transformsChanged = false;
+	if (exportOptimizations_.flattenStaticTransforms) {
+		auto flattenedNodes = findFlattenableNodes(*project_);
+		if (flattenedNodes != flattenedNodes_) {
+			flattenedNodes_ = std::move(flattenedNodes);
+			adaptorsChanged = true;
+			transformsChanged = true;
+		} else {
+			// Flattened nodes have no adaptor which would notice changes of their transformation or children.
+			transformsChanged = std::any_of(changedObjects.begin(), changedObjects.end(), [this](const SEditorObject& object) {
+				return isFlattened(object);
+			});
+		}
+	}
+
+	if (adaptorsChanged) {
+		for (const auto& object : project_->instances()) {
+			updateAdaptorStatus(object);
+		}
+		updateExportReport();
+	}
+	if (transformsChanged) {
+		for (const auto& [object, adaptor] : adaptors_) {
+			if (dynamic_cast<ISceneObjectProvider*>(adaptor.get())) {
+				adaptor->tagDirty();
+			}
+		}
+	}
+
+	if (exportOptimizations_.sharePrivateAppearances) {
+		// Changing the targets of a skin decides whether a mesh node can share its appearance.
+		for (const auto& [object, adaptor] : adaptors_) {
+			auto meshNodeAdaptor = dynamic_cast<MeshNodeAdaptor*>(adaptor.get());
+			if (meshNodeAdaptor && meshNodeAdaptor->skinTargetChanged()) {
+				adaptor->tagDirty();
+			}
+		}
+	}
+}
+
+void SceneAdaptor::updateExportReport() {
+	exportReport_.removedObjects.clear();
+	for (const auto& object : unusedResources_) {
+		exportReport_.removedObjects.emplace_back(ExportReport::RemovedObject{object->objectName(), object->objectID(), object->getTypeDescription().typeName, "unused resource"});
+	}
+	for (const auto& object : flattenedNodes_) {
+		exportReport_.removedObjects.emplace_back(ExportReport::RemovedObject{object->objectName(), object->objectID(), object->getTypeDescription().typeName, "flattened static transform"});
+	}
+	for (const auto& object : unusedLogic_) {
+		exportReport_.removedObjects.emplace_back(ExportReport::RemovedObject{object->objectName(), object->objectID(), object->getTypeDescription().typeName, "logic without influence on the scene"});
+	}
+	std::sort(exportReport_.removedObjects.begin(), exportReport_.removedObjects.end(), [](const auto& lhs, const auto& rhs) {
+		return std::tie(lhs.objectName, lhs.objectID) < std::tie(rhs.objectName, rhs.objectID);
+	});
+
+	exportReport_.removedLinks.clear();
+	for (const auto& link : project_->links()) {
+		if (unusedLogic_.find(*link->startObject_) != unusedLogic_.end() || unusedLogic_.find(*link->endObject_) != unusedLogic_.end()) {
+			exportReport_.removedLinks.emplace_back(fmt::format("{}", link->descriptor()));
+		}
+	}
+	std::sort(exportReport_.removedLinks.begin(), exportReport_.removedLinks.end());
+
+	LOG_INFO(log_system::RAMSES_ADAPTOR, "Export optimizations: {} unused resources, {} flattened nodes, {} unused logic objects and {} links are not exported",
+		unusedResources_.size(), flattenedNodes_.size(), unusedLogic_.size(), exportReport_.removedLinks.size());
 }
 
 
 void SceneAdaptor::createAdaptor(SEditorObject obj) {
 	if (needAdaptor(obj)) {
+		utils::ScopedPhase phase("createAdaptor", obj->getTypeDescription().typeName);
 		auto adaptor = Factories::createAdaptor(this, obj);
 		if (adaptor) {
 			adaptor->tagDirty();
@@ -109,6 +264,7 @@ void SceneAdaptor::createAdaptor(SEditorObject obj) {
 }
 
 void SceneAdaptor::removeAdaptor(SEditorObject obj) {
+	commitLinkRemovals();
 	auto adaptorWasLogicProvider = dynamic_cast<ILogicPropertyProvider*>(lookupAdaptor(obj)) != nullptr;
 	adaptors_.erase(obj);
 	deleteUnusedDefaultResources();
@@ -124,10 +280,59 @@ void SceneAdaptor::iterateAdaptors(std::function<void(ObjectAdaptor*)> func) {
 	}
 }
 
+TagMatchTable& SceneAdaptor::tagMatchTable() {
+	return tagMatchTable_;
+}
+
 bool SceneAdaptor::optimizeForExport() const {
 	return optimizeForExport_;
 }
 
+const ExportOptimizations& SceneAdaptor::exportOptimizations() const {
+	return exportOptimizations_;
+}
+
+bool SceneAdaptor::isFlattened(const SEditorObject& object) const {
+	return flattenedNodes_.find(object) != flattenedNodes_.end();
+}
+
+std::optional<glm::mat4> SceneAdaptor::flattenedParentTransform(const SEditorObject& object) const {
+	std::optional<glm::mat4> transform;
+	for (auto parent = object->getParent(); parent && isFlattened(parent); parent = parent->getParent()) {
+		transform = transformMatrix(nodeTransform(parent->as<user_types::Node>())) * transform.value_or(glm::mat4(1.0f));
+	}
+	return transform;
+}
+
+ramses_base::RamsesAppearance SceneAdaptor::sharedAppearance(const std::string& key, const std::function<ramses_base::RamsesAppearance()>& create) {
+	if (auto appearance = sharedAppearances_[key].lock()) {
+		return appearance;
+	}
+
+	for (auto it = sharedAppearances_.begin(); it != sharedAppearances_.end();) {
+		if (it->second.expired()) {
+			it = sharedAppearances_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	auto appearance = create();
+	sharedAppearances_[key] = appearance;
+	return appearance;
+}
+
+const ExportReport& SceneAdaptor::exportReport() const {
+	return exportReport_;
+}
+
+bool SceneAdaptor::interleaveVertexData() const {
+	return interleaveVertexData_;
+}
+
+ramses_base::TextureCompressor* SceneAdaptor::textureCompressor() const {
+	return textureCompressor_.get();
+}
+
 ramses::EFeatureLevel SceneAdaptor::featureLevel() const {
 	return client_->getRamsesFramework().getFeatureLevel();
 }
@@ -246,12 +451,27 @@ void SceneAdaptor::removeLink(const core::LinkDescriptor& link) {
 	}
 
 	auto endObjId = link.end.object()->objectID();
-	links_.linksByEnd_[endObjId].erase(link);
-	if (links_.linksByEnd_[endObjId].empty()) {
-		links_.linksByEnd_.erase(endObjId);
+	auto endIt = links_.linksByEnd_.find(endObjId);
+	if (endIt != links_.linksByEnd_.end()) {
+		auto linkIt = endIt->second.find(link);
+		if (linkIt != endIt->second.end()) {
+			removedLinks_.emplace_back(linkIt->second);
+			endIt->second.erase(linkIt);
+		}
+		if (endIt->second.empty()) {
+			links_.linksByEnd_.erase(endIt);
+		}
 	}
 }
 
+void SceneAdaptor::commitLinkRemovals() {
+	removedLinks_.clear();
+}
+
+const LinkStatistics& SceneAdaptor::linkStatistics() const {
+	return linkStatistics_;
+}
+
 ramses::RamsesClient* SceneAdaptor::client() {
 	return client_;
 }
@@ -317,29 +537,26 @@ void SceneAdaptor::rebuildSortedDependencyGraph(SEditorObjectSet const& objects)
 }
 
 void SceneAdaptor::performBulkEngineUpdate(const core::SEditorObjectSet& changedObjects) {
+	commitLinkRemovals();
+
 	if (adaptorStatusDirty_) {
 		for (const auto& item : dependencyGraph_) {
-			auto object = item.object;
-			auto adaptor = lookupAdaptor(object);
-
-			bool haveAdaptor = adaptor != nullptr;
-			if (haveAdaptor != needAdaptor(object)) {
-				if (haveAdaptor) {
-					for (auto link : core::Queries::getLinksConnectedToObject(*project_, object, true, true)) {
-						removeLink(link->descriptor());
-					}
-					removeAdaptor(object);
-				} else {
-					createAdaptor(object);
-					for (auto link : core::Queries::getLinksConnectedToObject(*project_, object, true, true)) {
-						createLink(link->descriptor());
-					}
-				}
-			}
+			updateAdaptorStatus(item.object);
 		}
 		adaptorStatusDirty_ = false;
 	}
 
+	// Any change can add or remove references to resources or make transformations static.
+	if (optimizeForExport_ && !changedObjects.empty()) {
+		updateExportOptimizations(changedObjects);
+	}
+
+	for (const auto& layer : tagMatchTable_.takeAffectedRenderLayers()) {
+		if (auto adaptor = lookupAdaptor(layer)) {
+			adaptor->tagDirty();
+		}
+	}
+
 	if (dependencyGraph_.empty() || !changedObjects.empty()) {
 		rebuildSortedDependencyGraph(SEditorObjectSet(project_->instances().begin(), project_->instances().end()));
 		// Check if all render passes have a unique order index, otherwise Ramses renders them in arbitrary order.
@@ -396,6 +613,7 @@ void SceneAdaptor::performBulkEngineUpdate(const core::SEditorObjectSet& changed
 			}
 
 			if (needsUpdate) {
+				utils::ScopedPhase phase("syncAdaptor", object->getTypeDescription().typeName);
 				auto hasChanged = adaptor->sync(errors_);
 				if (hasChanged) {
 					updated.insert(object);
@@ -404,14 +622,21 @@ void SceneAdaptor::performBulkEngineUpdate(const core::SEditorObjectSet& changed
 		}
 	}
 
-	for (const auto& link : liftedLinks) {
-		link->connect();
-	}
+	// Link commit: connect the lifted and the new links in a single pass resolving each engine property only once.
+	if (!liftedLinks.empty() || !newLinks_.empty()) {
+		utils::ScopedPhase phase("scene", "linkCommit");
+		LinkCommit commit(this, linkStatistics_);
+		for (const auto& link : liftedLinks) {
+			link->connect(commit);
+		}
 
-	for (const auto& newLink : newLinks_) {
-		auto adaptor = std::make_shared<LinkAdaptor>(newLink, this);
-		links_.linksByStart_[newLink.start.object()->objectID()][newLink] = adaptor;
-		links_.linksByEnd_[newLink.end.object()->objectID()][newLink] = adaptor;
+		for (const auto& newLink : newLinks_) {
+			auto adaptor = std::make_shared<LinkAdaptor>(newLink, this);
+			links_.linksByStart_[newLink.start.object()->objectID()][newLink] = adaptor;
+			links_.linksByEnd_[newLink.end.object()->objectID()][newLink] = adaptor;
+			adaptor->connect(commit);
+		}
+		++linkStatistics_.commits;
 	}
 
 	newLinks_.clear();
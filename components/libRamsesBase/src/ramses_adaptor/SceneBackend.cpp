@@ -42,9 +42,9 @@ ramses::LogicEngine* SceneBackend::logicEngine() const {
 }
 
 
-void SceneBackend::setScene(Project* project, core::Errors* errors, bool optimizeForExport, ramses::sceneId_t sceneId) {
+void SceneBackend::setScene(Project* project, core::Errors* errors, bool optimizeForExport, ramses::sceneId_t sceneId, bool interleaveVertexData, std::shared_ptr<ramses_base::TextureCompressor> textureCompressor, ExportOptimizations exportOptimizations) {
 	scene_.reset();
-	scene_ = std::make_unique<SceneAdaptor>(client(), sceneId, project, dispatcher_, errors, optimizeForExport);
+	scene_ = std::make_unique<SceneAdaptor>(client(), sceneId, project, dispatcher_, errors, optimizeForExport, interleaveVertexData, textureCompressor, exportOptimizations);
 }
 
 ramses::sceneId_t SceneBackend::toSceneId(int i) {
@@ -0,0 +1,306 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "ramses_adaptor/TagMatchTable.h"
+
+#include "core/Project.h"
+#include "user_types/Material.h"
+#include "user_types/MeshNode.h"
+#include "user_types/Node.h"
+#include "user_types/RenderLayer.h"
+
+#include <algorithm>
+
+namespace raco::ramses_adaptor {
+
+namespace {
+const std::vector<size_t> noMeshNodes;
+}
+
+void TagBits::set(uint32_t id) {
+	if (id / 64 >= words_.size()) {
+		words_.resize(id / 64 + 1);
+	}
+	words_[id / 64] |= uint64_t{1} << (id % 64);
+}
+
+bool TagBits::test(uint32_t id) const {
+	return id / 64 < words_.size() && (words_[id / 64] & (uint64_t{1} << (id % 64))) != 0;
+}
+
+bool TagBits::intersects(const TagBits& other) const {
+	auto count = std::min(words_.size(), other.words_.size());
+	for (size_t index = 0; index < count; index++) {
+		if ((words_[index] & other.words_[index]) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool TagBits::any() const {
+	return std::any_of(words_.begin(), words_.end(), [](uint64_t word) { return word != 0; });
+}
+
+std::vector<uint32_t> TagBits::ids() const {
+	std::vector<uint32_t> result;
+	for (size_t index = 0; index < words_.size(); index++) {
+		for (uint32_t bit = 0; bit < 64; bit++) {
+			if ((words_[index] & (uint64_t{1} << bit)) != 0) {
+				result.emplace_back(static_cast<uint32_t>(index * 64 + bit));
+			}
+		}
+	}
+	return result;
+}
+
+TagBits& TagBits::operator|=(const TagBits& other) {
+	if (other.words_.size() > words_.size()) {
+		words_.resize(other.words_.size());
+	}
+	for (size_t index = 0; index < other.words_.size(); index++) {
+		words_[index] |= other.words_[index];
+	}
+	return *this;
+}
+
+bool TagBits::operator==(const TagBits& other) const {
+	const auto& shorter = words_.size() < other.words_.size() ? words_ : other.words_;
+	const auto& longer = words_.size() < other.words_.size() ? other.words_ : words_;
+	return std::equal(shorter.begin(), shorter.end(), longer.begin()) &&
+		   std::all_of(longer.begin() + shorter.size(), longer.end(), [](uint64_t word) { return word == 0; });
+}
+
+TagMatchTable::TagMatchTable(const core::Project* project) : project_(project) {
+}
+
+uint32_t TagMatchTable::intern(const std::string& tag) {
+	return tagIds_.emplace(tag, static_cast<uint32_t>(tagIds_.size())).first->second;
+}
+
+TagBits TagMatchTable::bits(const std::set<std::string>& tags) {
+	TagBits result;
+	for (const auto& tag : tags) {
+		result.set(intern(tag));
+	}
+	return result;
+}
+
+const TagBits& TagMatchTable::objectTags(const core::SEditorObject& object) {
+	auto it = objectTags_.find(object);
+	if (it == objectTags_.end()) {
+		const data_storage::Table* tags = nullptr;
+		if (auto node = object->as<user_types::Node>()) {
+			tags = &*node->tags_;
+		} else if (auto material = object->as<user_types::Material>()) {
+			tags = &*material->tags_;
+		} else if (auto layer = object->as<user_types::RenderLayer>()) {
+			tags = &*layer->tags_;
+		}
+		TagBits objectBits;
+		if (tags) {
+			for (size_t index = 0; index < tags->size(); index++) {
+				objectBits.set(intern(tags->get(index)->asString()));
+			}
+		}
+		it = objectTags_.emplace(object, std::move(objectBits)).first;
+	}
+	return it->second;
+}
+
+const std::vector<TagMatchTable::Entry>& TagMatchTable::sceneGraph() {
+	if (structureDirty_) {
+		rebuildSceneGraph();
+	} else if (!tagsDirty_.empty()) {
+		std::vector<size_t> dirtyIndices;
+		for (const auto& object : tagsDirty_) {
+			auto it = entryIndices_.find(object);
+			if (it != entryIndices_.end()) {
+				dirtyIndices.emplace_back(it->second);
+			}
+		}
+		std::sort(dirtyIndices.begin(), dirtyIndices.end());
+		// Subtrees nested in an already updated subtree don't need another update.
+		size_t updatedEnd = 0;
+		for (auto index : dirtyIndices) {
+			if (index >= updatedEnd) {
+				updateSubtree(index);
+				updatedEnd = entries_[index].subtreeEnd;
+			}
+		}
+	}
+	// The old tags have been added when the objects were marked dirty. This covers the materials and render layers.
+	for (const auto& object : tagsDirty_) {
+		changedTags_ |= objectTags(object);
+	}
+	tagsDirty_.clear();
+	for (const auto& meshNode : materialsDirty_) {
+		if (auto it = entryIndices_.find(meshNode); it != entryIndices_.end()) {
+			changedTags_ |= entries_[it->second].tags;
+		}
+	}
+	materialsDirty_.clear();
+	return entries_;
+}
+
+const std::vector<size_t>& TagMatchTable::meshNodes(uint32_t tag) {
+	sceneGraph();
+	return tag < tagMeshNodes_.size() ? tagMeshNodes_[tag] : noMeshNodes;
+}
+
+void TagMatchTable::markStructureDirty() {
+	structureDirty_ = true;
+}
+
+void TagMatchTable::addObject(const core::SEditorObject& object) {
+	markObjectTagsChanged(object);
+	structureDirty_ = true;
+}
+
+void TagMatchTable::removeObject(const core::SEditorObject& object) {
+	markObjectTagsChanged(object);
+	objectTags_.erase(object);
+	tagsDirty_.erase(object);
+	materialsDirty_.erase(object);
+	structureDirty_ = true;
+}
+
+void TagMatchTable::markTagsDirty(const core::SEditorObject& object) {
+	if (auto it = objectTags_.find(object); it != objectTags_.end()) {
+		changedTags_ |= it->second;
+		objectTags_.erase(it);
+	}
+	tagsDirty_.insert(object);
+}
+
+void TagMatchTable::markRenderableTagsChanged(const core::SEditorObject& layer) {
+	markObjectTagsChanged(layer);
+}
+
+void TagMatchTable::markMaterialChanged(const core::SEditorObject& meshNode) {
+	materialsDirty_.insert(meshNode);
+}
+
+std::vector<core::SEditorObject> TagMatchTable::takeAffectedRenderLayers() {
+	sceneGraph();
+
+	std::vector<core::SEditorObject> result;
+	if (changedTags_.any()) {
+		for (const auto& object : renderLayers_) {
+			auto layer = object->as<user_types::RenderLayer>();
+			TagBits renderableTags;
+			for (size_t index = 0; index < layer->renderableTags_->size(); index++) {
+				renderableTags.set(intern(layer->renderableTags_->name(index)));
+			}
+			if (renderableTags.intersects(changedTags_) || bits(layer->materialFilterTags()).intersects(changedTags_)) {
+				result.emplace_back(object);
+			}
+		}
+		changedTags_ = TagBits();
+	}
+	statistics_.affectedRenderLayers += result.size();
+	return result;
+}
+
+void TagMatchTable::markObjectTagsChanged(const core::SEditorObject& object) {
+	changedTags_ |= objectTags(object);
+}
+
+const TagMatchTable::Statistics& TagMatchTable::statistics() const {
+	return statistics_;
+}
+
+void TagMatchTable::rebuildSceneGraph() {
+	auto oldEntries = std::move(entries_);
+	auto oldTagMeshNodes = std::move(tagMeshNodes_);
+	entries_.clear();
+	entryIndices_.clear();
+	tagMeshNodes_.clear();
+	renderLayers_.clear();
+	for (const auto& object : project_->instances()) {
+		if (!object->getParent() && object->as<user_types::Node>()) {
+			addSubtree(object, -1);
+		} else if (object->isType<user_types::RenderLayer>()) {
+			renderLayers_.emplace_back(object);
+		}
+	}
+
+	for (size_t index = 0; index < entries_.size(); index++) {
+		if (entries_[index].meshNode) {
+			for (auto tag : entries_[index].tags.ids()) {
+				if (tag >= tagMeshNodes_.size()) {
+					tagMeshNodes_.resize(tag + 1);
+				}
+				tagMeshNodes_[tag].emplace_back(index);
+			}
+		}
+	}
+
+	// The index is used as priority by the render layers sorted by scenegraph, so a shifted index changes the tag as well.
+	for (size_t tag = 0; tag < std::max(oldTagMeshNodes.size(), tagMeshNodes_.size()); tag++) {
+		const auto& oldIndices = tag < oldTagMeshNodes.size() ? oldTagMeshNodes[tag] : noMeshNodes;
+		const auto& newIndices = tag < tagMeshNodes_.size() ? tagMeshNodes_[tag] : noMeshNodes;
+		if (!std::equal(oldIndices.begin(), oldIndices.end(), newIndices.begin(), newIndices.end(), [this, &oldEntries](size_t oldIndex, size_t newIndex) {
+				return oldIndex == newIndex && oldEntries[oldIndex].object == entries_[newIndex].object;
+			})) {
+			changedTags_.set(static_cast<uint32_t>(tag));
+		}
+	}
+
+	structureDirty_ = false;
+	++statistics_.sceneGraphRebuilds;
+}
+
+void TagMatchTable::addSubtree(const core::SEditorObject& object, int parent) {
+	auto index = entries_.size();
+	TagBits tags = objectTags(object);
+	if (parent >= 0) {
+		tags |= entries_[parent].tags;
+	}
+	entries_.emplace_back(Entry{object, std::move(tags), parent, 0, object->isType<user_types::MeshNode>()});
+	entryIndices_[object] = index;
+	for (const auto& child : object->children_->asVector<core::SEditorObject>()) {
+		addSubtree(child, static_cast<int>(index));
+	}
+	entries_[index].subtreeEnd = entries_.size();
+}
+
+void TagMatchTable::updateSubtree(size_t index) {
+	// Parents precede their descendants, so the parent entries are always up to date.
+	for (size_t current = index; current < entries_[index].subtreeEnd; current++) {
+		auto& entry = entries_[current];
+		TagBits tags = objectTags(entry.object);
+		if (entry.parent >= 0) {
+			tags |= entries_[entry.parent].tags;
+		}
+		if (entry.meshNode && !(tags == entry.tags)) {
+			for (auto tag : entry.tags.ids()) {
+				if (!tags.test(tag)) {
+					auto& meshNodes = tagMeshNodes_[tag];
+					meshNodes.erase(std::lower_bound(meshNodes.begin(), meshNodes.end(), current));
+					changedTags_.set(tag);
+				}
+			}
+			for (auto tag : tags.ids()) {
+				if (!entry.tags.test(tag)) {
+					if (tag >= tagMeshNodes_.size()) {
+						tagMeshNodes_.resize(tag + 1);
+					}
+					auto& meshNodes = tagMeshNodes_[tag];
+					meshNodes.insert(std::lower_bound(meshNodes.begin(), meshNodes.end(), current), current);
+					changedTags_.set(tag);
+				}
+			}
+		}
+		entry.tags = std::move(tags);
+	}
+	++statistics_.subtreeUpdates;
+}
+
+}  // namespace raco::ramses_adaptor
@@ -159,10 +159,25 @@ RamsesTexture2D TextureSamplerAdaptor::createTexture(core::Errors* errors, PngDe
 		if (*editorObject()->flipTexture_) {
 			flipDecodedPicture(rawMipData, ramsesTextureFormatToChannelAmount(swizzleTextureFormat), decodingInfo.width * std::pow(0.5, i), decodingInfo.height * std::pow(0.5, i), decodingInfo.bitdepth);
 		}
+	}
+
+	auto textureFormat = swizzleTextureFormat;
+	bool generateMipmaps = *editorObject()->generateMipmaps_;
+	if (auto compressor = sceneAdaptor_->textureCompressor(); compressor && decodingInfo.bitdepth == 8) {
+		// Compressed textures can't be mipmapped by the GPU: the mip chain is generated before compression instead.
+		if (auto compressedFormat = compressor->compressMipLevels(rawMipDatas, swizzleTextureFormat, decodingInfo.width, decodingInfo.height, generateMipmaps)) {
+			textureFormat = *compressedFormat;
+			generateMipmaps = false;
+		} else {
+			LOG_DEBUG(log_system::RAMSES_ADAPTOR, "Texture '{}': format {} is not compressed", editorObject()->objectName(), ramsesTextureFormatToString(swizzleTextureFormat));
+		}
+	}
+
+	for (auto& rawMipData : rawMipDatas) {
 		mipDatas.emplace_back(reinterpret_cast<std::byte*>(rawMipData.data()), reinterpret_cast<std::byte*>(rawMipData.data()) + rawMipData.size());
 	}
 
-	return ramsesTexture2D(sceneAdaptor_->scene(), swizzleTextureFormat, decodingInfo.width, decodingInfo.height, mipDatas, *editorObject()->generateMipmaps_, swizzle, {}, editorObject()->objectIDAsRamsesLogicID());
+	return ramsesTexture2D(sceneAdaptor_->scene(), textureFormat, decodingInfo.width, decodingInfo.height, mipDatas, generateMipmaps, swizzle, {}, editorObject()->objectIDAsRamsesLogicID());
 }
 
 RamsesTexture2D TextureSamplerAdaptor::getFallbackTexture() {
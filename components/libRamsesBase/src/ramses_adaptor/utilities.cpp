@@ -17,6 +17,9 @@
 
 #include "core/MeshCacheInterface.h"
 
+#include <cstring>
+#include <limits>
+
 namespace raco::ramses_adaptor {
 
 raco::ramses_base::RamsesNodeBinding lookupNodeBinding(const SceneAdaptor* sceneAdaptor, core::SEditorObject node) {
@@ -91,4 +94,55 @@ ramses_base::RamsesArrayResource arrayResourceFromAttribute(ramses::Scene* scene
 	return {};
 }
 
+size_t vertexAttribElementSize(core::MeshData::VertexAttribDataType type) {
+	switch (type) {
+		case core::MeshData::VertexAttribDataType::VAT_Float:
+			return sizeof(float);
+		case core::MeshData::VertexAttribDataType::VAT_Float2:
+			return 2 * sizeof(float);
+		case core::MeshData::VertexAttribDataType::VAT_Float3:
+			return 3 * sizeof(float);
+		case core::MeshData::VertexAttribDataType::VAT_Float4:
+			return 4 * sizeof(float);
+	}
+	return 0;
+}
+
+std::optional<InterleavedVertexData> interleaveVertexAttributes(const core::MeshData& mesh) {
+	if (mesh.numAttributes() == 0) {
+		return std::nullopt;
+	}
+
+	InterleavedVertexData result;
+	result.vertexCount = mesh.attribElementCount(0);
+
+	size_t stride = 0;
+	for (uint32_t index = 0; index < mesh.numAttributes(); index++) {
+		if (mesh.attribElementCount(index) != result.vertexCount) {
+			return std::nullopt;
+		}
+		auto type = mesh.attribDataType(index);
+		result.attributes.push_back({mesh.attribName(index), type, static_cast<uint16_t>(stride)});
+		stride += vertexAttribElementSize(type);
+		if (stride > std::numeric_limits<uint16_t>::max()) {
+			return std::nullopt;
+		}
+	}
+	result.stride = static_cast<uint16_t>(stride);
+
+	result.data.resize(stride * result.vertexCount);
+	for (uint32_t index = 0; index < mesh.numAttributes(); index++) {
+		const auto& attribute = result.attributes[index];
+		auto elementSize = vertexAttribElementSize(attribute.type);
+		auto source = reinterpret_cast<const std::byte*>(mesh.attribBuffer(index));
+		auto dest = result.data.data() + attribute.offset;
+		for (uint32_t vertex = 0; vertex < result.vertexCount; vertex++) {
+			std::memcpy(dest, source, elementSize);
+			source += elementSize;
+			dest += stride;
+		}
+	}
+	return result;
+}
+
 }  // namespace raco::ramses_adaptor
\ No newline at end of file
@@ -27,6 +27,9 @@
 #include <ramses/client/logic/LuaScript.h>
 #include <ramses/client/logic/Property.h>
 
+#include <algorithm>
+#include <tuple>
+
 namespace raco::ramses_base {
 
 namespace {
@@ -94,76 +97,164 @@ std::tuple<ramses::LuaConfig, bool> CoreInterfaceImpl::createFullLuaConfig(const
 	return {luaConfig, true};
 }
 
-bool CoreInterfaceImpl::parseLuaScript(const std::string& luaScript, const std::string& scriptName, const std::vector<std::string>& stdModules, const data_storage::Table& modules, core::PropertyInterfaceList& outInputs, core::PropertyInterfaceList& outOutputs, std::string& outError) {
-	auto [luaConfig, valid] = createFullLuaConfig(stdModules, modules);
-	if (!valid) {
-		return false;
-	}
+bool CoreInterfaceImpl::LuaParseKey::operator<(const LuaParseKey& other) const {
+	return std::tie(isInterface, featureLevel, source, name, stdModules, modules) < std::tie(other.isInterface, other.featureLevel, other.source, other.name, other.stdModules, other.modules);
+}
 
-	const auto script = logicEngine()->createLuaScript(luaScript, luaConfig, scriptName);
-	if (!script) {
-		outError = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value().message;
-		return false;
+std::optional<CoreInterfaceImpl::LuaParseKey> CoreInterfaceImpl::createLuaParseKey(bool isInterface, const std::string& source, const std::string& name, const std::vector<std::string>& stdModules, const data_storage::Table& modules) const {
+	LuaParseKey key{isInterface, source, name, stdModules, {}, static_cast<int>(backend_->featureLevel())};
+	for (auto i = 0; i < modules.size(); ++i) {
+		auto moduleRef = modules.get(i)->asRef();
+		if (!moduleRef || cachedModules_.find(moduleRef) == cachedModules_.end()) {
+			return std::nullopt;
+		}
+		key.modules.emplace_back(modules.name(i), moduleRef);
 	}
+	return key;
+}
 
-	if (const auto inputs = script->getInputs()) {
-		fillLuaScriptInterface(outInputs, inputs);
+const CoreInterfaceImpl::LuaParseResult& CoreInterfaceImpl::cacheLuaParseResult(LuaParseKey&& key, LuaParseResult&& result) {
+	// Parse results of edited scripts are never used again; keep the cache from growing indefinitely.
+	static constexpr size_t MAX_CACHED_PARSE_RESULTS = 4096;
+	if (cachedParseResults_.size() >= MAX_CACHED_PARSE_RESULTS) {
+		cachedParseResults_.clear();
 	}
-	if (const auto outputs = script->getOutputs()) {
-		fillLuaScriptInterface(outOutputs, outputs);
+	if (result.success) {
+		key.name.clear();
 	}
-	auto status = logicEngine()->destroy(*script);
-	if (!status) {
-		auto error = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value();
-		LOG_ERROR(log_system::RAMSES_BACKEND, "Deleting LogicEngine object failed: {}", error.message);
+	return cachedParseResults_.insert_or_assign(std::move(key), std::move(result)).first->second;
+}
+
+void CoreInterfaceImpl::removeParseResultsUsingModule(const core::SCEditorObject& module) {
+	for (auto it = cachedParseResults_.begin(); it != cachedParseResults_.end();) {
+		const auto& modules = it->first.modules;
+		bool usesModule = std::any_of(modules.begin(), modules.end(), [&module](const auto& entry) { return entry.second == module; });
+		it = usesModule ? cachedParseResults_.erase(it) : std::next(it);
 	}
-	return true;
 }
 
-bool CoreInterfaceImpl::parseLuaInterface(const std::string& interfaceText, const std::vector<std::string>& stdModules, const data_storage::Table& modules, PropertyInterfaceList& outInputs, std::string& outError) {
+bool CoreInterfaceImpl::parseLuaScript(const std::string& luaScript, const std::string& scriptName, const std::vector<std::string>& stdModules, const data_storage::Table& modules, core::PropertyInterfaceList& outInputs, core::PropertyInterfaceList& outOutputs, std::string& outError) {
+	++luaParseStatistics_.requests;
+	auto key = createLuaParseKey(false, luaScript, {}, stdModules, modules);
+	if (!key) {
+		// We already checked the module validity before parsing
+		assert(false);
+		return false;
+	}
+
+	auto it = cachedParseResults_.find(*key);
+	if (it == cachedParseResults_.end()) {
+		key->name = scriptName;
+		it = cachedParseResults_.find(*key);
+	}
+	if (it != cachedParseResults_.end()) {
+		outInputs = it->second.inputs;
+		outOutputs = it->second.outputs;
+		outError = it->second.error;
+		return it->second.success;
+	}
+
 	auto [luaConfig, valid] = createFullLuaConfig(stdModules, modules);
 	if (!valid) {
 		return false;
 	}
 
-	ramses::LuaInterface* interface = logicEngine()->createLuaInterface(interfaceText, "Stage::Preprocess", luaConfig);
+	++luaParseStatistics_.compilations;
+	LuaParseResult result{false, {}, {}, {}};
+	if (const auto script = logicEngine()->createLuaScript(luaScript, luaConfig, scriptName)) {
+		result.success = true;
+		if (const auto inputs = script->getInputs()) {
+			fillLuaScriptInterface(result.inputs, inputs);
+		}
+		if (const auto outputs = script->getOutputs()) {
+			fillLuaScriptInterface(result.outputs, outputs);
+		}
+		auto status = logicEngine()->destroy(*script);
+		if (!status) {
+			auto error = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value();
+			LOG_ERROR(log_system::RAMSES_BACKEND, "Deleting LogicEngine object failed: {}", error.message);
+		}
+	} else {
+		result.error = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value().message;
+	}
 
-	if (!interface) {
-		outError = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value().message;
+	const auto& cached = cacheLuaParseResult(std::move(*key), std::move(result));
+	outInputs = cached.inputs;
+	outOutputs = cached.outputs;
+	outError = cached.error;
+	return cached.success;
+}
+
+bool CoreInterfaceImpl::parseLuaInterface(const std::string& interfaceText, const std::vector<std::string>& stdModules, const data_storage::Table& modules, PropertyInterfaceList& outInputs, std::string& outError) {
+	++luaParseStatistics_.requests;
+	auto key = createLuaParseKey(true, interfaceText, {}, stdModules, modules);
+	if (!key) {
+		// We already checked the module validity before parsing
+		assert(false);
 		return false;
 	}
 
-	if (auto inputs = interface->getInputs()) {
-		fillLuaScriptInterface(outInputs, inputs);
+	auto it = cachedParseResults_.find(*key);
+	if (it != cachedParseResults_.end()) {
+		outInputs = it->second.inputs;
+		outError = it->second.error;
+		return it->second.success;
 	}
 
-	auto status = logicEngine()->destroy(*interface);
-	if (!status) {
-		auto error = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value();
-		LOG_ERROR(log_system::RAMSES_BACKEND, "Deleting LogicEngine object failed: {}", error.message);
+	auto [luaConfig, valid] = createFullLuaConfig(stdModules, modules);
+	if (!valid) {
+		return false;
+	}
+
+	++luaParseStatistics_.compilations;
+	LuaParseResult result{false, {}, {}, {}};
+	if (ramses::LuaInterface* interface = logicEngine()->createLuaInterface(interfaceText, "Stage::Preprocess", luaConfig)) {
+		result.success = true;
+		if (auto inputs = interface->getInputs()) {
+			fillLuaScriptInterface(result.inputs, inputs);
+		}
+		auto status = logicEngine()->destroy(*interface);
+		if (!status) {
+			auto error = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value();
+			LOG_ERROR(log_system::RAMSES_BACKEND, "Deleting LogicEngine object failed: {}", error.message);
+		}
+	} else {
+		result.error = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value().message;
 	}
-	return true;
+
+	const auto& cached = cacheLuaParseResult(std::move(*key), std::move(result));
+	outInputs = cached.inputs;
+	outError = cached.error;
+	return cached.success;
 }
 
 bool CoreInterfaceImpl::parseLuaScriptModule(core::SEditorObject object, const std::string& luaScriptModule, const std::string& moduleName, const std::vector<std::string>& stdModules, std::string& outError) {
 	ramses::LuaConfig tempConfig = createLuaConfig(stdModules);
 
 	if (auto tempModule = ramses_base::ramsesLuaModule(luaScriptModule, logicEngine(), tempConfig, moduleName, object->objectIDAsRamsesLogicID())) {
+		removeParseResultsUsingModule(object);
 		cachedModules_[object] = tempModule;
 		return true;
 	} else {
 		outError = logicEngine()->getScene().getRamsesClient().getRamsesFramework().getLastError().value().message;
+		removeParseResultsUsingModule(object);
 		cachedModules_.erase(object);
 		return false;
 	}
 }
 
 void CoreInterfaceImpl::removeModuleFromCache(core::SCEditorObject object) {
+	removeParseResultsUsingModule(object);
 	cachedModules_.erase(object);
 }
 
 void CoreInterfaceImpl::clearModuleCache() {
 	cachedModules_.clear();
+	cachedParseResults_.clear();
+}
+
+const CoreInterfaceImpl::LuaParseStatistics& CoreInterfaceImpl::luaParseStatistics() const {
+	return luaParseStatistics_;
 }
 
 bool CoreInterfaceImpl::extractLuaDependencies(const std::string& luaScript, std::vector<std::string>& moduleList, std::string& outError) {
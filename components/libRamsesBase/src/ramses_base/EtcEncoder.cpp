@@ -0,0 +1,556 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "ramses_base/EtcEncoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <thread>
+
+namespace raco::ramses_base {
+
+namespace {
+
+// Modifier tables of the ETC1 compatible modes. The selectors 0 to 3 select +small, +large, -small, -large.
+constexpr int ETC_MODIFIERS[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+// Modifier tables of the EAC alpha block.
+constexpr int EAC_MODIFIERS[16][8] = {
+	{-3, -6, -9, -15, 2, 5, 8, 14},
+	{-3, -7, -10, -13, 2, 6, 9, 12},
+	{-2, -5, -8, -13, 1, 4, 7, 12},
+	{-2, -4, -6, -13, 1, 3, 5, 12},
+	{-3, -6, -8, -12, 2, 5, 7, 11},
+	{-3, -7, -9, -11, 2, 6, 8, 10},
+	{-4, -7, -8, -11, 3, 6, 7, 10},
+	{-3, -5, -8, -11, 2, 4, 7, 10},
+	{-2, -6, -8, -10, 1, 5, 7, 9},
+	{-2, -5, -8, -10, 1, 4, 7, 9},
+	{-2, -4, -8, -10, 1, 3, 7, 9},
+	{-2, -5, -7, -10, 1, 4, 6, 9},
+	{-3, -4, -7, -10, 2, 3, 6, 9},
+	{-1, -2, -3, -10, 0, 1, 2, 9},
+	{-4, -6, -8, -9, 3, 5, 7, 8},
+	{-3, -5, -7, -9, 2, 4, 6, 8}};
+
+// Table containing a modifier of 0, used for blocks with constant alpha.
+constexpr uint32_t EAC_ZERO_TABLE = 13;
+
+constexpr uint32_t BLOCK_SIZE = 4;
+constexpr uint32_t BLOCK_PIXELS = BLOCK_SIZE * BLOCK_SIZE;
+constexpr uint32_t SUBBLOCK_PIXELS = BLOCK_PIXELS / 2;
+
+// The pixels of a block are numbered in column-major order as in the ETC bit layout.
+struct Block {
+	std::array<std::array<int, 4>, BLOCK_PIXELS> pixels;
+};
+
+struct SubblockFit {
+	uint32_t error = std::numeric_limits<uint32_t>::max();
+	uint32_t table = 0;
+	std::array<uint32_t, SUBBLOCK_PIXELS> selectors{};
+};
+
+struct BaseColorCandidate {
+	std::array<int, 3> quantized;
+	SubblockFit fit;
+};
+
+int clamp255(int value) {
+	return std::clamp(value, 0, 255);
+}
+
+int etcModifier(uint32_t table, uint32_t selector) {
+	int value = ETC_MODIFIERS[table][selector & 1];
+	return (selector & 2) ? -value : value;
+}
+
+int expandColor(int quantized, int bits) {
+	return bits == 4 ? (quantized << 4) | quantized : (quantized << 3) | (quantized >> 2);
+}
+
+// Offsets of the quantized base colors tried around the quantized subblock average color.
+std::vector<std::array<int, 3>> baseColorOffsets(EEtcQuality quality) {
+	std::vector<std::array<int, 3>> result{{0, 0, 0}};
+	if (quality == EEtcQuality::Fast) {
+		return result;
+	}
+	if (quality == EEtcQuality::Normal) {
+		// Direct neighbours along the color axes and the gray axis.
+		for (int step : {-1, 1}) {
+			result.push_back({step, 0, 0});
+			result.push_back({0, step, 0});
+			result.push_back({0, 0, step});
+			result.push_back({step, step, step});
+		}
+		return result;
+	}
+	// Full neighbourhood cube and additional steps along the gray axis.
+	for (int r = -1; r <= 1; r++) {
+		for (int g = -1; g <= 1; g++) {
+			for (int b = -1; b <= 1; b++) {
+				if (r != 0 || g != 0 || b != 0) {
+					result.push_back({r, g, b});
+				}
+			}
+		}
+	}
+	for (int step : {-3, -2, 2, 3}) {
+		result.push_back({step, step, step});
+	}
+	return result;
+}
+
+// Search radius of the EAC multiplier; the base value is searched within twice the radius.
+int alphaSearchRadius(EEtcQuality quality) {
+	switch (quality) {
+		case EEtcQuality::Fast:
+			return 0;
+		case EEtcQuality::Normal:
+			return 1;
+		case EEtcQuality::High:
+		default:
+			return 2;
+	}
+}
+
+// Pixel indices of the two subblocks: side by side 2x4 subblocks if not flipped, 4x2 subblocks on top of each other if flipped.
+std::array<uint32_t, SUBBLOCK_PIXELS> subblockPixels(bool flip, uint32_t subblock) {
+	std::array<uint32_t, SUBBLOCK_PIXELS> result;
+	uint32_t index = 0;
+	for (uint32_t x = 0; x < BLOCK_SIZE; x++) {
+		for (uint32_t y = 0; y < BLOCK_SIZE; y++) {
+			if ((flip ? y / 2 : x / 2) == subblock) {
+				result[index++] = x * BLOCK_SIZE + y;
+			}
+		}
+	}
+	return result;
+}
+
+SubblockFit fitSubblock(const Block& block, const std::array<uint32_t, SUBBLOCK_PIXELS>& pixelIndices, const std::array<int, 3>& baseColor) {
+	SubblockFit best;
+	for (uint32_t table = 0; table < 8; table++) {
+		SubblockFit fit;
+		fit.error = 0;
+		fit.table = table;
+		for (uint32_t index = 0; index < SUBBLOCK_PIXELS && fit.error < best.error; index++) {
+			const auto& pixel = block.pixels[pixelIndices[index]];
+			uint32_t bestPixelError = std::numeric_limits<uint32_t>::max();
+			for (uint32_t selector = 0; selector < 4; selector++) {
+				int modifier = etcModifier(table, selector);
+				uint32_t pixelError = 0;
+				for (int channel = 0; channel < 3; channel++) {
+					int diff = clamp255(baseColor[channel] + modifier) - pixel[channel];
+					pixelError += static_cast<uint32_t>(diff * diff);
+				}
+				if (pixelError < bestPixelError) {
+					bestPixelError = pixelError;
+					fit.selectors[index] = selector;
+				}
+			}
+			fit.error += bestPixelError;
+		}
+		if (fit.error < best.error) {
+			best = fit;
+		}
+	}
+	return best;
+}
+
+BaseColorCandidate fitQuantizedColor(const Block& block, const std::array<uint32_t, SUBBLOCK_PIXELS>& pixelIndices, const std::array<int, 3>& quantized, int bits) {
+	std::array<int, 3> baseColor;
+	for (int channel = 0; channel < 3; channel++) {
+		baseColor[channel] = expandColor(quantized[channel], bits);
+	}
+	return {quantized, fitSubblock(block, pixelIndices, baseColor)};
+}
+
+// Fit the quantized base colors given by the offsets around the quantized subblock average.
+std::vector<BaseColorCandidate> baseColorCandidates(const Block& block, const std::array<uint32_t, SUBBLOCK_PIXELS>& pixelIndices, int bits, const std::vector<std::array<int, 3>>& offsets) {
+	const int maxValue = (1 << bits) - 1;
+	std::array<int, 3> center;
+	for (int channel = 0; channel < 3; channel++) {
+		int sum = 0;
+		for (auto index : pixelIndices) {
+			sum += block.pixels[index][channel];
+		}
+		center[channel] = static_cast<int>(std::lround(static_cast<double>(sum) / SUBBLOCK_PIXELS * maxValue / 255.0));
+	}
+
+	std::vector<BaseColorCandidate> result;
+	for (const auto& offset : offsets) {
+		std::array<int, 3> quantized;
+		bool inRange = true;
+		for (int channel = 0; channel < 3; channel++) {
+			quantized[channel] = center[channel] + offset[channel];
+			inRange = inRange && quantized[channel] >= 0 && quantized[channel] <= maxValue;
+		}
+		if (inRange) {
+			result.emplace_back(fitQuantizedColor(block, pixelIndices, quantized, bits));
+		}
+	}
+	return result;
+}
+
+const BaseColorCandidate& bestCandidate(const std::vector<BaseColorCandidate>& candidates) {
+	return *std::min_element(candidates.begin(), candidates.end(), [](const auto& left, const auto& right) {
+		return left.fit.error < right.fit.error;
+	});
+}
+
+bool validDifference(const std::array<int, 3>& first, const std::array<int, 3>& second) {
+	for (int channel = 0; channel < 3; channel++) {
+		int diff = second[channel] - first[channel];
+		if (diff < -4 || diff > 3) {
+			return false;
+		}
+	}
+	return true;
+}
+
+struct ColorBlockChoice {
+	uint64_t error = std::numeric_limits<uint64_t>::max();
+	bool flip = false;
+	bool differential = false;
+	BaseColorCandidate subblocks[2];
+};
+
+void chooseColorMode(const Block& block, bool flip, const std::vector<std::array<int, 3>>& offsets, ColorBlockChoice& best) {
+	std::array<uint32_t, SUBBLOCK_PIXELS> pixelIndices[2] = {subblockPixels(flip, 0), subblockPixels(flip, 1)};
+
+	// Individual mode: two independent 4 bit base colors.
+	{
+		auto first = bestCandidate(baseColorCandidates(block, pixelIndices[0], 4, offsets));
+		auto second = bestCandidate(baseColorCandidates(block, pixelIndices[1], 4, offsets));
+		uint64_t error = static_cast<uint64_t>(first.fit.error) + second.fit.error;
+		if (error < best.error) {
+			best = {error, flip, false, {first, second}};
+		}
+	}
+
+	// Differential mode: 5 bit base color and a 3 bit signed difference for the second subblock.
+	auto firstCandidates = baseColorCandidates(block, pixelIndices[0], 5, offsets);
+	auto secondCandidates = baseColorCandidates(block, pixelIndices[1], 5, offsets);
+	bool foundPair = false;
+	for (const auto& first : firstCandidates) {
+		for (const auto& second : secondCandidates) {
+			if (validDifference(first.quantized, second.quantized)) {
+				foundPair = true;
+				uint64_t error = static_cast<uint64_t>(first.fit.error) + second.fit.error;
+				if (error < best.error) {
+					best = {error, flip, true, {first, second}};
+				}
+			}
+		}
+	}
+	if (!foundPair) {
+		// Move the second base color into the representable range of the best first base color.
+		const auto& first = bestCandidate(firstCandidates);
+		std::array<int, 3> clamped;
+		for (int channel = 0; channel < 3; channel++) {
+			clamped[channel] = std::clamp(bestCandidate(secondCandidates).quantized[channel], std::max(0, first.quantized[channel] - 4), std::min(31, first.quantized[channel] + 3));
+		}
+		auto second = fitQuantizedColor(block, pixelIndices[1], clamped, 5);
+		uint64_t error = static_cast<uint64_t>(first.fit.error) + second.fit.error;
+		if (error < best.error) {
+			best = {error, flip, true, {first, second}};
+		}
+	}
+}
+
+uint64_t encodeColorBlock(const Block& block, const std::vector<std::array<int, 3>>& offsets) {
+	ColorBlockChoice choice;
+	chooseColorMode(block, false, offsets, choice);
+	chooseColorMode(block, true, offsets, choice);
+
+	const auto& first = choice.subblocks[0].quantized;
+	const auto& second = choice.subblocks[1].quantized;
+	uint64_t bits = 0;
+	for (int channel = 0; channel < 3; channel++) {
+		int shift = 56 - 8 * channel;
+		if (choice.differential) {
+			bits |= static_cast<uint64_t>(first[channel]) << (shift + 3);
+			bits |= static_cast<uint64_t>((second[channel] - first[channel]) & 7) << shift;
+		} else {
+			bits |= static_cast<uint64_t>(first[channel]) << (shift + 4);
+			bits |= static_cast<uint64_t>(second[channel]) << shift;
+		}
+	}
+	bits |= static_cast<uint64_t>(choice.subblocks[0].fit.table) << 37;
+	bits |= static_cast<uint64_t>(choice.subblocks[1].fit.table) << 34;
+	bits |= static_cast<uint64_t>(choice.differential) << 33;
+	bits |= static_cast<uint64_t>(choice.flip) << 32;
+
+	for (uint32_t subblock = 0; subblock < 2; subblock++) {
+		auto pixelIndices = subblockPixels(choice.flip, subblock);
+		for (uint32_t index = 0; index < SUBBLOCK_PIXELS; index++) {
+			uint32_t selector = choice.subblocks[subblock].fit.selectors[index];
+			bits |= static_cast<uint64_t>(selector >> 1) << (16 + pixelIndices[index]);
+			bits |= static_cast<uint64_t>(selector & 1) << pixelIndices[index];
+		}
+	}
+	return bits;
+}
+
+uint64_t encodeAlphaBlock(const Block& block, EEtcQuality quality) {
+	int minAlpha = 255;
+	int maxAlpha = 0;
+	for (const auto& pixel : block.pixels) {
+		minAlpha = std::min(minAlpha, pixel[3]);
+		maxAlpha = std::max(maxAlpha, pixel[3]);
+	}
+
+	uint64_t bestError = std::numeric_limits<uint64_t>::max();
+	uint64_t bestBits = 0;
+	auto tryEncoding = [&](int base, int multiplier, uint32_t table) {
+		uint64_t bits = static_cast<uint64_t>(base) << 56 | static_cast<uint64_t>(multiplier) << 52 | static_cast<uint64_t>(table) << 48;
+		uint64_t error = 0;
+		for (uint32_t index = 0; index < BLOCK_PIXELS && error < bestError; index++) {
+			int bestPixelError = std::numeric_limits<int>::max();
+			uint32_t bestSelector = 0;
+			for (uint32_t selector = 0; selector < 8; selector++) {
+				int diff = clamp255(base + EAC_MODIFIERS[table][selector] * multiplier) - block.pixels[index][3];
+				if (diff * diff < bestPixelError) {
+					bestPixelError = diff * diff;
+					bestSelector = selector;
+				}
+			}
+			error += bestPixelError;
+			bits |= static_cast<uint64_t>(bestSelector) << (45 - 3 * index);
+		}
+		if (error < bestError) {
+			bestError = error;
+			bestBits = bits;
+		}
+	};
+
+	if (minAlpha == maxAlpha) {
+		tryEncoding(minAlpha, 1, EAC_ZERO_TABLE);
+		return bestBits;
+	}
+
+	int radius = alphaSearchRadius(quality);
+	for (uint32_t table = 0; table < 16 && bestError > 0; table++) {
+		int minModifier = EAC_MODIFIERS[table][3];
+		int maxModifier = EAC_MODIFIERS[table][7];
+		int estimatedMultiplier = std::clamp(static_cast<int>(std::lround(static_cast<double>(maxAlpha - minAlpha) / (maxModifier - minModifier))), 1, 15);
+		for (int multiplier = std::max(1, estimatedMultiplier - radius); multiplier <= std::min(15, estimatedMultiplier + radius); multiplier++) {
+			int estimatedBase = static_cast<int>(std::lround((minAlpha + maxAlpha) / 2.0 - (minModifier + maxModifier) * multiplier / 2.0));
+			for (int base = std::max(0, estimatedBase - 2 * radius); base <= std::min(255, estimatedBase + 2 * radius); base++) {
+				tryEncoding(base, multiplier, table);
+			}
+		}
+	}
+	return bestBits;
+}
+
+void writeBigEndian(uint64_t bits, unsigned char* out) {
+	for (int index = 0; index < 8; index++) {
+		out[index] = static_cast<unsigned char>(bits >> (56 - 8 * index));
+	}
+}
+
+uint64_t readBigEndian(const unsigned char* in) {
+	uint64_t bits = 0;
+	for (int index = 0; index < 8; index++) {
+		bits = (bits << 8) | in[index];
+	}
+	return bits;
+}
+
+Block loadBlock(const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t channels, uint32_t blockX, uint32_t blockY) {
+	Block block;
+	for (uint32_t x = 0; x < BLOCK_SIZE; x++) {
+		for (uint32_t y = 0; y < BLOCK_SIZE; y++) {
+			uint32_t sourceX = std::min(blockX * BLOCK_SIZE + x, width - 1);
+			uint32_t sourceY = std::min(blockY * BLOCK_SIZE + y, height - 1);
+			const unsigned char* source = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * channels;
+			auto& pixel = block.pixels[x * BLOCK_SIZE + y];
+			for (uint32_t channel = 0; channel < 4; channel++) {
+				pixel[channel] = channel < channels ? source[channel] : 255;
+			}
+		}
+	}
+	return block;
+}
+
+bool decodeColorBlock(uint64_t bits, std::array<std::array<int, 4>, BLOCK_PIXELS>& pixels) {
+	bool differential = (bits >> 33) & 1;
+	bool flip = (bits >> 32) & 1;
+	std::array<int, 3> baseColors[2];
+	for (int channel = 0; channel < 3; channel++) {
+		int shift = 56 - 8 * channel;
+		if (differential) {
+			int first = static_cast<int>((bits >> (shift + 3)) & 31);
+			int diff = static_cast<int>((bits >> shift) & 7);
+			int second = first + (diff >= 4 ? diff - 8 : diff);
+			if (second < 0 || second > 31) {
+				// T, H or planar mode
+				return false;
+			}
+			baseColors[0][channel] = expandColor(first, 5);
+			baseColors[1][channel] = expandColor(second, 5);
+		} else {
+			baseColors[0][channel] = expandColor(static_cast<int>((bits >> (shift + 4)) & 15), 4);
+			baseColors[1][channel] = expandColor(static_cast<int>((bits >> shift) & 15), 4);
+		}
+	}
+	uint32_t tables[2] = {static_cast<uint32_t>((bits >> 37) & 7), static_cast<uint32_t>((bits >> 34) & 7)};
+
+	for (uint32_t x = 0; x < BLOCK_SIZE; x++) {
+		for (uint32_t y = 0; y < BLOCK_SIZE; y++) {
+			uint32_t index = x * BLOCK_SIZE + y;
+			uint32_t subblock = flip ? y / 2 : x / 2;
+			uint32_t selector = static_cast<uint32_t>(((bits >> (16 + index)) & 1) << 1 | ((bits >> index) & 1));
+			int modifier = etcModifier(tables[subblock], selector);
+			for (int channel = 0; channel < 3; channel++) {
+				pixels[index][channel] = clamp255(baseColors[subblock][channel] + modifier);
+			}
+		}
+	}
+	return true;
+}
+
+void decodeAlphaBlock(uint64_t bits, std::array<std::array<int, 4>, BLOCK_PIXELS>& pixels) {
+	int base = static_cast<int>(bits >> 56);
+	int multiplier = static_cast<int>((bits >> 52) & 15);
+	uint32_t table = static_cast<uint32_t>((bits >> 48) & 15);
+	for (uint32_t index = 0; index < BLOCK_PIXELS; index++) {
+		uint32_t selector = static_cast<uint32_t>((bits >> (45 - 3 * index)) & 7);
+		pixels[index][3] = clamp255(base + EAC_MODIFIERS[table][selector] * multiplier);
+	}
+}
+
+uint32_t blockCount(uint32_t size) {
+	return (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+}  // namespace
+
+size_t etcCompressedSize(uint32_t width, uint32_t height, bool alpha) {
+	return static_cast<size_t>(blockCount(width)) * blockCount(height) * (alpha ? 16 : 8);
+}
+
+std::vector<unsigned char> encodeEtc2(const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t channels, EEtcQuality quality, uint32_t threadCount) {
+	if (width == 0 || height == 0 || (channels != 3 && channels != 4)) {
+		return {};
+	}
+
+	const bool alpha = channels == 4;
+	const size_t blockBytes = alpha ? 16 : 8;
+	const auto offsets = baseColorOffsets(quality);
+	const uint32_t blocksX = blockCount(width);
+	const uint32_t blocksY = blockCount(height);
+	std::vector<unsigned char> result(etcCompressedSize(width, height, alpha));
+
+	auto encodeRows = [&](uint32_t firstRow, uint32_t rowStep) {
+		for (uint32_t blockY = firstRow; blockY < blocksY; blockY += rowStep) {
+			for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+				auto block = loadBlock(pixels, width, height, channels, blockX, blockY);
+				unsigned char* out = result.data() + (static_cast<size_t>(blockY) * blocksX + blockX) * blockBytes;
+				if (alpha) {
+					writeBigEndian(encodeAlphaBlock(block, quality), out);
+					out += 8;
+				}
+				writeBigEndian(encodeColorBlock(block, offsets), out);
+			}
+		}
+	};
+
+	// Interleave the block rows over the threads to balance the load for images with uneven content.
+	uint32_t numThreads = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+	numThreads = std::min(numThreads, blocksY);
+	std::vector<std::future<void>> tasks;
+	for (uint32_t thread = 1; thread < numThreads; thread++) {
+		tasks.emplace_back(std::async(std::launch::async, encodeRows, thread, numThreads));
+	}
+	encodeRows(0, numThreads);
+	for (auto& task : tasks) {
+		task.get();
+	}
+	return result;
+}
+
+std::vector<unsigned char> decodeEtc2(const unsigned char* blocks, uint32_t width, uint32_t height, uint32_t channels) {
+	if (width == 0 || height == 0 || (channels != 3 && channels != 4)) {
+		return {};
+	}
+
+	const bool alpha = channels == 4;
+	const uint32_t blocksX = blockCount(width);
+	const uint32_t blocksY = blockCount(height);
+	std::vector<unsigned char> result(static_cast<size_t>(width) * height * channels);
+
+	for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+		for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+			std::array<std::array<int, 4>, BLOCK_PIXELS> pixels;
+			for (auto& pixel : pixels) {
+				pixel[3] = 255;
+			}
+			const unsigned char* in = blocks + (static_cast<size_t>(blockY) * blocksX + blockX) * (alpha ? 16 : 8);
+			if (alpha) {
+				decodeAlphaBlock(readBigEndian(in), pixels);
+				in += 8;
+			}
+			if (!decodeColorBlock(readBigEndian(in), pixels)) {
+				return {};
+			}
+
+			for (uint32_t x = 0; x < BLOCK_SIZE && blockX * BLOCK_SIZE + x < width; x++) {
+				for (uint32_t y = 0; y < BLOCK_SIZE && blockY * BLOCK_SIZE + y < height; y++) {
+					unsigned char* out = result.data() + (static_cast<size_t>(blockY * BLOCK_SIZE + y) * width + blockX * BLOCK_SIZE + x) * channels;
+					for (uint32_t channel = 0; channel < channels; channel++) {
+						out[channel] = static_cast<unsigned char>(pixels[x * BLOCK_SIZE + y][channel]);
+					}
+				}
+			}
+		}
+	}
+	return result;
+}
+
+std::vector<unsigned char> downsampleImage(const unsigned char* pixels, uint32_t width, uint32_t height, uint32_t channels) {
+	uint32_t newWidth = std::max(1u, width / 2);
+	uint32_t newHeight = std::max(1u, height / 2);
+	std::vector<unsigned char> result(static_cast<size_t>(newWidth) * newHeight * channels);
+	for (uint32_t y = 0; y < newHeight; y++) {
+		uint32_t y0 = std::min(2 * y, height - 1);
+		uint32_t y1 = std::min(2 * y + 1, height - 1);
+		for (uint32_t x = 0; x < newWidth; x++) {
+			uint32_t x0 = std::min(2 * x, width - 1);
+			uint32_t x1 = std::min(2 * x + 1, width - 1);
+			for (uint32_t channel = 0; channel < channels; channel++) {
+				auto value = [&](uint32_t sx, uint32_t sy) {
+					return static_cast<uint32_t>(pixels[(static_cast<size_t>(sy) * width + sx) * channels + channel]);
+				};
+				result[(static_cast<size_t>(y) * newWidth + x) * channels + channel] = static_cast<unsigned char>((value(x0, y0) + value(x1, y0) + value(x0, y1) + value(x1, y1) + 2) / 4);
+			}
+		}
+	}
+	return result;
+}
+
+double computePsnr(const unsigned char* image, const unsigned char* reference, size_t size) {
+	uint64_t squaredError = 0;
+	for (size_t index = 0; index < size; index++) {
+		int diff = static_cast<int>(image[index]) - static_cast<int>(reference[index]);
+		squaredError += static_cast<uint64_t>(diff * diff);
+	}
+	if (squaredError == 0 || size == 0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	double mse = static_cast<double>(squaredError) / static_cast<double>(size);
+	return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+}  // namespace raco::ramses_base
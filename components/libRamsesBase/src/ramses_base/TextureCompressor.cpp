@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "ramses_base/TextureCompressor.h"
+
+#include "log_system/log.h"
+#include "utils/u8path.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace raco::ramses_base {
+
+TextureCompressor::TextureCompressor(EEtcQuality quality, const std::string& cacheDirectory)
+	: quality_(quality), cacheDirectory_(cacheDirectory) {
+}
+
+EEtcQuality TextureCompressor::quality() const {
+	return quality_;
+}
+
+const std::string& TextureCompressor::cacheDirectory() const {
+	return cacheDirectory_;
+}
+
+const TextureCompressor::Statistics& TextureCompressor::statistics() const {
+	return statistics_;
+}
+
+std::string TextureCompressor::cacheKey(const std::vector<unsigned char>& pixels, uint32_t width, uint32_t height, uint32_t channels, EEtcQuality quality) {
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	auto settings = fmt::format("etc2-v{} width={} height={} channels={} quality={}", ENCODER_VERSION, width, height, channels, static_cast<int>(quality));
+	hash.addData(settings.c_str(), static_cast<int>(settings.size() + 1));
+	hash.addData(reinterpret_cast<const char*>(pixels.data()), static_cast<int>(pixels.size()));
+	return hash.result().toHex().toStdString();
+}
+
+std::string TextureCompressor::cachedFilePath(const std::string& key) const {
+	return (utils::u8path(cacheDirectory_) / (key + ".etc2")).string();
+}
+
+std::vector<unsigned char> TextureCompressor::compress(const std::vector<unsigned char>& pixels, uint32_t width, uint32_t height, uint32_t channels) {
+	const auto expectedSize = etcCompressedSize(width, height, channels == 4);
+	std::string key;
+	if (!cacheDirectory_.empty()) {
+		key = cacheKey(pixels, width, height, channels, quality_);
+		QFile file(QString::fromStdString(cachedFilePath(key)));
+		if (file.open(QIODevice::ReadOnly)) {
+			auto data = file.readAll();
+			if (static_cast<size_t>(data.size()) == expectedSize) {
+				++statistics_.cacheHits;
+				return std::vector<unsigned char>(data.begin(), data.end());
+			}
+			LOG_WARNING(log_system::RAMSES_ADAPTOR, "Texture compression cache: ignoring {} with unexpected size {}", cachedFilePath(key), data.size());
+		}
+	}
+
+	auto result = encodeEtc2(pixels.data(), width, height, channels, quality_);
+	++statistics_.encodedImages;
+
+	if (!key.empty()) {
+		std::error_code ec;
+		std::filesystem::create_directories(utils::u8path(cacheDirectory_), ec);
+
+		// Write to a temporary file first and rename afterwards to prevent concurrent exports from seeing incomplete cache entries.
+		auto cachedPath = cachedFilePath(key);
+		auto tempPath = cachedPath + ".tmp";
+		QFile file(QString::fromStdString(tempPath));
+		if (!ec && file.open(QIODevice::WriteOnly) && file.write(reinterpret_cast<const char*>(result.data()), result.size()) == static_cast<qint64>(result.size())) {
+			file.close();
+			std::filesystem::rename(utils::u8path(tempPath), utils::u8path(cachedPath), ec);
+			if (!ec) {
+				++statistics_.cacheStored;
+			}
+		} else {
+			LOG_WARNING(log_system::RAMSES_ADAPTOR, "Texture compression cache: can't write {}", tempPath);
+			file.close();
+			std::filesystem::remove(utils::u8path(tempPath), ec);
+		}
+	}
+	return result;
+}
+
+std::optional<ramses::ETextureFormat> TextureCompressor::compressMipLevels(std::vector<std::vector<unsigned char>>& mipLevels, ramses::ETextureFormat format, uint32_t width, uint32_t height, bool generateMipChain) {
+	uint32_t channels;
+	ramses::ETextureFormat compressedFormat;
+	switch (format) {
+		case ramses::ETextureFormat::RGB8:
+			channels = 3;
+			compressedFormat = ramses::ETextureFormat::ETC2RGB;
+			break;
+		case ramses::ETextureFormat::RGBA8:
+			channels = 4;
+			compressedFormat = ramses::ETextureFormat::ETC2RGBA;
+			break;
+		default:
+			return std::nullopt;
+	}
+
+	if (mipLevels.empty() || (generateMipChain && mipLevels.size() > 1)) {
+		return std::nullopt;
+	}
+	for (size_t level = 0; level < mipLevels.size(); level++) {
+		auto levelWidth = std::max(1u, width >> level);
+		auto levelHeight = std::max(1u, height >> level);
+		if (mipLevels[level].size() != static_cast<size_t>(levelWidth) * levelHeight * channels) {
+			return std::nullopt;
+		}
+	}
+
+	std::vector<std::vector<unsigned char>> levels = mipLevels;
+	if (generateMipChain) {
+		for (uint32_t level = 1; std::max(width >> (level - 1), height >> (level - 1)) > 1; level++) {
+			levels.emplace_back(downsampleImage(levels.back().data(), std::max(1u, width >> (level - 1)), std::max(1u, height >> (level - 1)), channels));
+		}
+	}
+
+	for (size_t level = 0; level < levels.size(); level++) {
+		levels[level] = compress(levels[level], std::max(1u, width >> level), std::max(1u, height >> level), channels);
+	}
+	mipLevels = std::move(levels);
+	return compressedFormat;
+}
+
+}  // namespace raco::ramses_base
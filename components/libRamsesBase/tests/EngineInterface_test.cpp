@@ -9,6 +9,7 @@
  */
 
 #include "RamsesBaseFixture.h"
+#include "ramses_base/CoreInterfaceImpl.h"
 #include <gtest/gtest.h>
 
 using namespace raco::ramses_base;
@@ -73,3 +74,62 @@ end
 		EXPECT_EQ(EnginePrimitive::Double, in.at(0).children.at(i).type);
 	}
 }
+
+TEST_F(EngineInterfaceTest, parseLuaScript_compiles_identical_scripts_once) {
+	const std::string script = R"(
+function interface(IN,OUT)
+	IN.x = Type:Float()
+	OUT.y = Type:Float()
+end
+
+function run(IN,OUT)
+end
+)";
+	auto coreInterface = static_cast<CoreInterfaceImpl*>(backend.coreInterface());
+	auto stats = coreInterface->luaParseStatistics();
+	data_storage::Table modules;
+
+	for (auto name : {"first", "second", "third"}) {
+		std::string error;
+		core::PropertyInterfaceList in;
+		core::PropertyInterfaceList out;
+		EXPECT_TRUE(coreInterface->parseLuaScript(script, name, {}, modules, in, out, error));
+		ASSERT_EQ(1, in.size());
+		EXPECT_EQ("x", in.at(0).name);
+		ASSERT_EQ(1, out.size());
+		EXPECT_EQ("y", out.at(0).name);
+	}
+	EXPECT_EQ(coreInterface->luaParseStatistics().requests, stats.requests + 3);
+	EXPECT_EQ(coreInterface->luaParseStatistics().compilations, stats.compilations + 1);
+
+	// Different module configuration needs a separate compilation
+	std::string error;
+	core::PropertyInterfaceList in;
+	core::PropertyInterfaceList out;
+	EXPECT_TRUE(coreInterface->parseLuaScript(script, "first", {"math"}, modules, in, out, error));
+	EXPECT_EQ(coreInterface->luaParseStatistics().compilations, stats.compilations + 2);
+
+	coreInterface->clearModuleCache();
+	EXPECT_TRUE(coreInterface->parseLuaScript(script, "first", {}, modules, in, out, error));
+	EXPECT_EQ(coreInterface->luaParseStatistics().compilations, stats.compilations + 3);
+}
+
+TEST_F(EngineInterfaceTest, parseLuaScript_cached_error_uses_script_name) {
+	const std::string script = R"(
+function interface(IN,OUT)
+	IN.x = Type:Unknown()
+end
+)";
+	auto coreInterface = static_cast<CoreInterfaceImpl*>(backend.coreInterface());
+	data_storage::Table modules;
+
+	for (int repeat = 0; repeat < 2; repeat++) {
+		for (auto name : {"alpha", "beta"}) {
+			std::string error;
+			core::PropertyInterfaceList in;
+			core::PropertyInterfaceList out;
+			EXPECT_FALSE(coreInterface->parseLuaScript(script, name, {}, modules, in, out, error));
+			EXPECT_NE(error.find(name), std::string::npos);
+		}
+	}
+}
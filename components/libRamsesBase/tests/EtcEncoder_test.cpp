@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "RamsesBaseFixture.h"
+#include "ramses_base/EtcEncoder.h"
+#include "ramses_base/TextureCompressor.h"
+#include "ramses_base/Utils.h"
+#include "user_types/Texture.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace raco::ramses_base;
+
+namespace {
+
+// Smooth luminance pattern with slowly varying tint and an alpha gradient.
+std::vector<unsigned char> createTestImage(uint32_t width, uint32_t height, uint32_t channels) {
+	std::vector<unsigned char> result(static_cast<size_t>(width) * height * channels);
+	for (uint32_t y = 0; y < height; y++) {
+		for (uint32_t x = 0; x < width; x++) {
+			double luminance = 128.0 + 100.0 * std::sin(0.15 * x) * std::cos(0.11 * y);
+			double values[4] = {luminance + 0.3 * x, luminance - 0.2 * y, luminance + 10.0, 255.0 * (x + y) / (width + height - 2)};
+			for (uint32_t channel = 0; channel < channels; channel++) {
+				result[(static_cast<size_t>(y) * width + x) * channels + channel] = static_cast<unsigned char>(std::clamp(std::lround(values[channel]), 0L, 255L));
+			}
+		}
+	}
+	return result;
+}
+
+double roundTripPsnr(const std::vector<unsigned char>& image, uint32_t width, uint32_t height, uint32_t channels, EEtcQuality quality) {
+	auto encoded = encodeEtc2(image.data(), width, height, channels, quality);
+	EXPECT_EQ(encoded.size(), etcCompressedSize(width, height, channels == 4));
+	auto decoded = decodeEtc2(encoded.data(), width, height, channels);
+	EXPECT_EQ(decoded.size(), image.size());
+	return decoded.size() == image.size() ? computePsnr(decoded.data(), image.data(), image.size()) : 0.0;
+}
+
+}  // namespace
+
+TEST(EtcEncoderTest, psnr_rgb_quality_presets) {
+	auto image = createTestImage(64, 64, 3);
+
+	auto fast = roundTripPsnr(image, 64, 64, 3, EEtcQuality::Fast);
+	auto normal = roundTripPsnr(image, 64, 64, 3, EEtcQuality::Normal);
+	auto high = roundTripPsnr(image, 64, 64, 3, EEtcQuality::High);
+
+	EXPECT_GT(fast, 38.0);
+	EXPECT_GE(normal, fast);
+	EXPECT_GE(high, normal);
+}
+
+TEST(EtcEncoderTest, psnr_rgba) {
+	auto image = createTestImage(64, 64, 4);
+
+	EXPECT_GT(roundTripPsnr(image, 64, 64, 4, EEtcQuality::Fast), 38.0);
+	EXPECT_GT(roundTripPsnr(image, 64, 64, 4, EEtcQuality::Normal), 40.0);
+}
+
+TEST(EtcEncoderTest, constant_colors_exact) {
+	// Colors representable by a 4 bit base color and a modifier.
+	std::vector<unsigned char> image;
+	for (size_t pixel = 0; pixel < 8 * 8; pixel++) {
+		image.insert(image.end(), {17 * 3 + 2, 17 * 9 + 2, 17 * 12 + 2, 200});
+	}
+	auto encoded = encodeEtc2(image.data(), 8, 8, 4, EEtcQuality::Fast);
+	auto decoded = decodeEtc2(encoded.data(), 8, 8, 4);
+	EXPECT_EQ(decoded, image);
+}
+
+TEST(EtcEncoderTest, partial_blocks) {
+	auto image = createTestImage(13, 7, 4);
+
+	auto encoded = encodeEtc2(image.data(), 13, 7, 4, EEtcQuality::Normal);
+	EXPECT_EQ(encoded.size(), 4 * 2 * 16);
+	auto decoded = decodeEtc2(encoded.data(), 13, 7, 4);
+	ASSERT_EQ(decoded.size(), image.size());
+	EXPECT_GT(computePsnr(decoded.data(), image.data(), image.size()), 35.0);
+}
+
+TEST(EtcEncoderTest, result_independent_of_thread_count) {
+	auto image = createTestImage(40, 36, 4);
+
+	auto serial = encodeEtc2(image.data(), 40, 36, 4, EEtcQuality::Normal, 1);
+	EXPECT_EQ(encodeEtc2(image.data(), 40, 36, 4, EEtcQuality::Normal, 3), serial);
+	EXPECT_EQ(encodeEtc2(image.data(), 40, 36, 4, EEtcQuality::Normal, 16), serial);
+}
+
+TEST(EtcEncoderTest, downsample_image) {
+	std::vector<unsigned char> image{0, 4, 8, 12, 100, 100};
+	EXPECT_EQ(downsampleImage(image.data(), 3, 2, 1), std::vector<unsigned char>({29}));
+	EXPECT_EQ(downsampleImage(image.data(), 1, 6, 1), std::vector<unsigned char>({2, 10, 100}));
+}
+
+class TextureCompressorTest : public RamsesBaseFixture<> {};
+
+TEST_F(TextureCompressorTest, psnr_png_texture) {
+	auto texture = create<user_types::Texture>("texture");
+	context.set({texture, &user_types::Texture::uri_}, (test_path() / "images" / "DuckCM.png").string());
+	dispatch();
+
+	PngDecodingInfo decodingInfo;
+	auto image = decodeMipMapData(&errors, project, texture, "uri", 1, decodingInfo, true);
+	ASSERT_FALSE(image.empty());
+	auto channels = static_cast<uint32_t>(image.size() / (decodingInfo.width * decodingInfo.height));
+	ASSERT_TRUE(channels == 3 || channels == 4);
+
+	EXPECT_GT(roundTripPsnr(image, decodingInfo.width, decodingInfo.height, channels, EEtcQuality::Normal), 30.0);
+}
+
+TEST_F(TextureCompressorTest, cache_hit) {
+	auto cacheDirectory = (test_path() / "etccache").string();
+	auto image = createTestImage(32, 16, 3);
+
+	TextureCompressor compressor(EEtcQuality::Normal, cacheDirectory);
+	auto encoded = compressor.compress(image, 32, 16, 3);
+	EXPECT_EQ(compressor.statistics().encodedImages, 1);
+	EXPECT_EQ(compressor.statistics().cacheStored, 1);
+	EXPECT_TRUE(utils::u8path(cacheDirectory).existsDirectory());
+
+	TextureCompressor otherCompressor(EEtcQuality::Normal, cacheDirectory);
+	EXPECT_EQ(otherCompressor.compress(image, 32, 16, 3), encoded);
+	EXPECT_EQ(otherCompressor.statistics().cacheHits, 1);
+	EXPECT_EQ(otherCompressor.statistics().encodedImages, 0);
+
+	// Different settings must not hit the cache entry.
+	TextureCompressor fastCompressor(EEtcQuality::Fast, cacheDirectory);
+	fastCompressor.compress(image, 32, 16, 3);
+	EXPECT_EQ(fastCompressor.statistics().cacheHits, 0);
+	EXPECT_NE(TextureCompressor::cacheKey(image, 32, 16, 3, EEtcQuality::Normal), TextureCompressor::cacheKey(image, 16, 32, 3, EEtcQuality::Normal));
+}
+
+TEST_F(TextureCompressorTest, compressed_export_scene) {
+	auto texture = create<user_types::Texture>("texture");
+	context.set({texture, &user_types::Texture::uri_}, (test_path() / "images" / "DuckCM.png").string());
+	context.set({texture, &user_types::Texture::generateMipmaps_}, true);
+	dispatch();
+
+	auto compressor = std::make_shared<TextureCompressor>(EEtcQuality::Fast);
+	ramses_adaptor::SceneAdaptor compressedScene{&backend.client(), ramses::sceneId_t{2u}, &project, std::make_shared<DataChangeDispatcher>(), &errors, true, false, compressor};
+
+	auto compressedTexture = select<ramses::Texture2D>(*compressedScene.scene(), "texture_Texture2D");
+	ASSERT_TRUE(compressedTexture != nullptr);
+	EXPECT_TRUE(compressedTexture->getTextureFormat() == ramses::ETextureFormat::ETC2RGB || compressedTexture->getTextureFormat() == ramses::ETextureFormat::ETC2RGBA);
+	// The generated mip chain goes down to 1x1.
+	EXPECT_GT(compressor->statistics().encodedImages, 1);
+
+	// The default scene is not compressed.
+	auto texture2D = select<ramses::Texture2D>(*sceneContext.scene(), "texture_Texture2D");
+	ASSERT_TRUE(texture2D != nullptr);
+	EXPECT_NE(texture2D->getTextureFormat(), compressedTexture->getTextureFormat());
+}
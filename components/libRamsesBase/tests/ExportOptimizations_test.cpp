@@ -0,0 +1,365 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "RamsesBaseFixture.h"
+#include "ramses_adaptor/ExportOptimizations.h"
+#include "ramses_adaptor/MeshNodeAdaptor.h"
+#include "testing/TestUtil.h"
+#include "user_types/LuaScript.h"
+#include "user_types/Material.h"
+#include "user_types/Mesh.h"
+#include "user_types/MeshNode.h"
+#include "user_types/Node.h"
+#include "user_types/Prefab.h"
+#include "user_types/PrefabInstance.h"
+#include "user_types/RenderBuffer.h"
+#include "user_types/RenderPass.h"
+#include "user_types/RenderTarget.h"
+#include "user_types/Skin.h"
+#include "utils/FileUtils.h"
+
+using namespace raco::user_types;
+
+namespace {
+
+// Export optimizations with only the given option enabled.
+ramses_adaptor::ExportOptimizations singleOptimization(bool ramses_adaptor::ExportOptimizations::*option) {
+	ramses_adaptor::ExportOptimizations optimizations;
+	optimizations.*option = true;
+	return optimizations;
+}
+
+}  // namespace
+
+class ExportOptimizationsTest : public RamsesBaseFixture<> {
+public:
+	ExportOptimizationsTest() : RamsesBaseFixture(true, ramses_base::BaseEngineBackend::maxFeatureLevel, singleOptimization(&ramses_adaptor::ExportOptimizations::removeUnusedResources)) {}
+
+	std::vector<std::string> removedObjectNames() {
+		std::vector<std::string> names;
+		for (const auto& removed : sceneContext.exportReport().removedObjects) {
+			names.emplace_back(removed.objectName);
+		}
+		return names;
+	}
+
+	size_t ramsesRenderBufferCount() {
+		return select<ramses::RenderBuffer>(*sceneContext.scene(), ramses::ERamsesObjectType::RenderBuffer).size();
+	}
+};
+
+TEST_F(ExportOptimizationsTest, unused_resources_are_not_exported) {
+	auto usedBuffer = create<RenderBuffer>("used_buffer");
+	auto unusedBuffer = create<RenderBuffer>("unused_buffer");
+	auto target = create<RenderTarget>("target");
+	auto renderPass = create<RenderPass>("render_pass");
+	context.set({target, {"buffers", "1"}}, usedBuffer);
+	context.set({renderPass, &RenderPass::target_}, target);
+	dispatch();
+
+	EXPECT_NE(sceneContext.lookupAdaptor(usedBuffer), nullptr);
+	EXPECT_NE(sceneContext.lookupAdaptor(target), nullptr);
+	EXPECT_EQ(sceneContext.lookupAdaptor(unusedBuffer), nullptr);
+	EXPECT_EQ(ramsesRenderBufferCount(), 1);
+	EXPECT_EQ(removedObjectNames(), std::vector<std::string>({"unused_buffer"}));
+
+	context.set({target, {"buffers", "1"}}, unusedBuffer);
+	dispatch();
+
+	EXPECT_EQ(sceneContext.lookupAdaptor(usedBuffer), nullptr);
+	EXPECT_NE(sceneContext.lookupAdaptor(unusedBuffer), nullptr);
+	EXPECT_EQ(ramsesRenderBufferCount(), 1);
+	EXPECT_EQ(removedObjectNames(), std::vector<std::string>({"used_buffer"}));
+
+	context.deleteObjects({renderPass});
+	dispatch();
+
+	EXPECT_EQ(sceneContext.lookupAdaptor(target), nullptr);
+	EXPECT_EQ(sceneContext.lookupAdaptor(unusedBuffer), nullptr);
+	EXPECT_EQ(ramsesRenderBufferCount(), 0);
+	EXPECT_EQ(removedObjectNames(), std::vector<std::string>({"target", "unused_buffer", "used_buffer"}));
+}
+
+TEST_F(ExportOptimizationsTest, find_unused_resources_ignores_prefab_contents) {
+	auto prefab = create<Prefab>("prefab");
+	auto meshNode = create<MeshNode>("mesh_node", prefab);
+	auto mesh = create<Mesh>("mesh");
+	commandInterface.set({meshNode, &MeshNode::mesh_}, mesh);
+
+	EXPECT_EQ(ramses_adaptor::findUnusedResources(project), core::SEditorObjectSet({mesh}));
+
+	auto instance = create<PrefabInstance>("instance");
+	commandInterface.set({instance, &PrefabInstance::template_}, prefab);
+
+	EXPECT_EQ(ramses_adaptor::findUnusedResources(project), core::SEditorObjectSet());
+}
+
+class FlattenStaticTransformsTest : public RamsesBaseFixture<> {
+public:
+	FlattenStaticTransformsTest() : RamsesBaseFixture(true, ramses_base::BaseEngineBackend::maxFeatureLevel, singleOptimization(&ramses_adaptor::ExportOptimizations::flattenStaticTransforms)) {}
+
+	SNode createNode(const std::string& name, core::SEditorObject parent, glm::vec3 translation, glm::vec3 rotation, glm::vec3 scaling) {
+		auto node = create<Node>(name, parent);
+		context.set({node, &Node::translation_}, std::array<double, 3>{translation.x, translation.y, translation.z});
+		context.set({node, &Node::rotation_}, std::array<double, 3>{rotation.x, rotation.y, rotation.z});
+		context.set({node, &Node::scaling_}, std::array<double, 3>{scaling.x, scaling.y, scaling.z});
+		return node;
+	}
+
+	glm::mat4 worldMatrix(const ramses_adaptor::SceneAdaptor& scene, const core::SEditorObject& object) {
+		glm::mat4 matrix{1.0f};
+		auto adaptor = scene.lookup<ramses_adaptor::ISceneObjectProvider>(object);
+		EXPECT_NE(adaptor, nullptr);
+		if (adaptor) {
+			adaptor->sceneObject()->getModelMatrix(matrix);
+		}
+		return matrix;
+	}
+
+	void expectSameWorldMatrix(const ramses_adaptor::SceneAdaptor& reference, const core::SEditorObject& object) {
+		auto expected = worldMatrix(reference, object);
+		auto actual = worldMatrix(sceneContext, object);
+		for (int column = 0; column < 4; column++) {
+			for (int row = 0; row < 4; row++) {
+				EXPECT_NEAR(actual[column][row], expected[column][row], 1e-4) << object->objectName() << " [" << column << "][" << row << "]";
+			}
+		}
+	}
+};
+
+TEST_F(FlattenStaticTransformsTest, decompose_transform_roundtrip) {
+	ramses_adaptor::NodeTransform transform{{1.0f, -2.0f, 3.0f}, {10.0f, -20.0f, 30.0f}, {2.0f, 0.5f, 3.0f}};
+	auto matrix = ramses_adaptor::transformMatrix(transform);
+
+	auto decomposed = ramses_adaptor::decomposeTransform(matrix);
+	ASSERT_TRUE(decomposed.has_value());
+	auto recomposed = ramses_adaptor::transformMatrix(*decomposed);
+	for (int column = 0; column < 4; column++) {
+		for (int row = 0; row < 4; row++) {
+			EXPECT_NEAR(recomposed[column][row], matrix[column][row], 1e-5);
+		}
+	}
+
+	// Non-uniform scaling followed by a rotation results in shear.
+	auto sheared = ramses_adaptor::transformMatrix({{}, {}, {1.0f, 3.0f, 1.0f}}) * ramses_adaptor::transformMatrix({{}, {0.0f, 0.0f, 45.0f}, {1.0f, 1.0f, 1.0f}});
+	EXPECT_FALSE(ramses_adaptor::decomposeTransform(sheared).has_value());
+}
+
+TEST_F(FlattenStaticTransformsTest, flattened_hierarchy_keeps_world_matrices) {
+	auto root = createNode("root", nullptr, {1.0f, 2.0f, 3.0f}, {10.0f, 20.0f, 30.0f}, {2.0f, 2.0f, 2.0f});
+	auto middle = createNode("middle", root, {0.0f, 1.0f, 0.0f}, {45.0f, 0.0f, -30.0f}, {1.0f, 1.0f, 1.0f});
+	auto leaf = create<MeshNode>("leaf", middle);
+	context.set({leaf, &Node::translation_}, std::array<double, 3>{3.0, 0.0, 0.0});
+	context.set({leaf, &Node::rotation_}, std::array<double, 3>{0.0, 90.0, 15.0});
+	context.set({leaf, &Node::scaling_}, std::array<double, 3>{1.0, 2.0, 3.0});
+	auto skewed = createNode("skewed", root, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 3.0f, 1.0f});
+	auto rotated = createNode("rotated", skewed, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 45.0f}, {1.0f, 1.0f, 1.0f});
+	dispatch();
+
+	ramses_adaptor::SceneAdaptor reference{&backend.client(), ramses::sceneId_t{2u}, &project, dataChangeDispatcher, &errors};
+
+	EXPECT_EQ(ramses_adaptor::findFlattenableNodes(project), core::SEditorObjectSet({root, middle}));
+	EXPECT_EQ(sceneContext.lookupAdaptor(root), nullptr);
+	EXPECT_EQ(sceneContext.lookupAdaptor(middle), nullptr);
+	EXPECT_EQ(sceneContext.exportReport().removedObjects.size(), 2);
+	for (const auto& object : std::vector<core::SEditorObject>{leaf, skewed, rotated}) {
+		expectSameWorldMatrix(reference, object);
+	}
+
+	context.set({middle, &Node::visibility_}, false);
+	dispatch();
+
+	EXPECT_NE(sceneContext.lookupAdaptor(middle), nullptr);
+	EXPECT_EQ(sceneContext.exportReport().removedObjects.size(), 1);
+	for (const auto& object : std::vector<core::SEditorObject>{middle, leaf, skewed, rotated}) {
+		expectSameWorldMatrix(reference, object);
+	}
+
+	context.set(core::ValueHandle(root, {"translation", "x"}), 5.0);
+	dispatch();
+
+	for (const auto& object : std::vector<core::SEditorObject>{middle, leaf, skewed, rotated}) {
+		expectSameWorldMatrix(reference, object);
+	}
+}
+
+class RemoveUnusedLogicTest : public RamsesBaseFixture<> {
+public:
+	RemoveUnusedLogicTest() : RamsesBaseFixture(true, ramses_base::BaseEngineBackend::maxFeatureLevel, singleOptimization(&ramses_adaptor::ExportOptimizations::removeUnusedLogic)) {}
+
+	SLuaScript createScript(const std::string& name) {
+		auto script = create<LuaScript>(name);
+		context.set({script, &LuaScript::uri_}, (test_path() / "scale.lua").string());
+		return script;
+	}
+
+	glm::vec3 translation(const ramses_adaptor::SceneAdaptor& scene, const core::SEditorObject& node) {
+		return ramses_adaptor::getRamsesTranslation(scene.lookup<ramses_adaptor::ISceneObjectProvider>(node)->sceneObject().get());
+	}
+};
+
+TEST_F(RemoveUnusedLogicTest, logic_without_influence_is_not_exported) {
+	utils::file::write((test_path() / "scale.lua").string(), R"(
+function interface(IN,OUT)
+	IN.v = Type:Vec3f()
+	OUT.translation = Type:Vec3f()
+end
+function run(IN,OUT)
+	OUT.translation = { 2 * IN.v[1], IN.v[2], IN.v[3] }
+end
+)");
+	auto node = create<Node>("node");
+	auto other = create<Node>("other");
+	auto source = createScript("source");
+	auto driver = createScript("driver");
+	auto deadStart = createScript("dead_start");
+	auto deadEnd = createScript("dead_end");
+	auto isolated = createScript("isolated");
+	context.addLink({source, {"outputs", "translation"}}, {driver, {"inputs", "v"}});
+	context.addLink({driver, {"outputs", "translation"}}, {node, {"translation"}});
+	context.addLink({deadStart, {"outputs", "translation"}}, {deadEnd, {"inputs", "v"}});
+	context.set(core::ValueHandle(source, {"inputs", "v", "x"}), 1.0);
+	context.set(core::ValueHandle(deadStart, {"inputs", "v", "x"}), 3.0);
+	ASSERT_TRUE(dispatch());
+
+	ramses_adaptor::SceneAdaptor reference{&backend.client(), ramses::sceneId_t{2u}, &project, dataChangeDispatcher, &errors};
+	ASSERT_TRUE(reference.logicEngine().update());
+
+	EXPECT_EQ(ramses_adaptor::findUnusedLogic(project), core::SEditorObjectSet({deadStart, deadEnd, isolated}));
+	for (const auto& script : {deadStart, deadEnd, isolated}) {
+		EXPECT_EQ(sceneContext.lookupAdaptor(script), nullptr);
+	}
+	EXPECT_EQ(sceneContext.exportReport().removedObjects.size(), 3);
+	EXPECT_EQ(sceneContext.exportReport().removedLinks.size(), 1);
+	EXPECT_EQ(sceneContext.logicEngine().getPropertyLinks().size(), 2);
+	EXPECT_EQ(reference.logicEngine().getPropertyLinks().size(), 3);
+	EXPECT_EQ(translation(sceneContext, node), glm::vec3(4.0f, 0.0f, 0.0f));
+	EXPECT_EQ(translation(sceneContext, node), translation(reference, node));
+
+	context.addLink({deadEnd, {"outputs", "translation"}}, {other, {"translation"}});
+	ASSERT_TRUE(dispatch());
+	ASSERT_TRUE(reference.logicEngine().update());
+
+	EXPECT_NE(sceneContext.lookupAdaptor(deadStart), nullptr);
+	EXPECT_NE(sceneContext.lookupAdaptor(deadEnd), nullptr);
+	EXPECT_EQ(sceneContext.exportReport().removedObjects.size(), 1);
+	EXPECT_EQ(sceneContext.logicEngine().getPropertyLinks().size(), 4);
+	EXPECT_EQ(translation(sceneContext, other), glm::vec3(12.0f, 0.0f, 0.0f));
+	EXPECT_EQ(translation(sceneContext, node), translation(reference, node));
+	EXPECT_EQ(translation(sceneContext, other), translation(reference, other));
+}
+
+class SharePrivateAppearancesTest : public RamsesBaseFixture<> {
+public:
+	SharePrivateAppearancesTest() : RamsesBaseFixture(true, ramses_base::BaseEngineBackend::maxFeatureLevel, singleOptimization(&ramses_adaptor::ExportOptimizations::sharePrivateAppearances)) {}
+
+	SMeshNode createPrivateMeshNode(const std::string& name, SMesh mesh, SMaterial material, std::array<double, 3> color) {
+		auto meshNode = create_meshnode(name, mesh, material);
+		context.set(meshNode->getMaterialPrivateHandle(0), true);
+		context.set(core::ValueHandle(meshNode, {"materials", "material", "uniforms", "u_color"}), color);
+		return meshNode;
+	}
+
+	const ramses::Appearance* appearance(const ramses_adaptor::SceneAdaptor& scene, const core::SEditorObject& meshNode) {
+		return scene.lookup<ramses_adaptor::MeshNodeAdaptor>(meshNode)->privateAppearance()->get();
+	}
+
+	glm::vec3 color(const ramses_adaptor::SceneAdaptor& scene, const core::SEditorObject& meshNode) {
+		auto ramsesAppearance = appearance(scene, meshNode);
+		glm::vec3 value;
+		ramsesAppearance->getInputValue(ramsesAppearance->getEffect().findUniformInput("u_color").value(), value);
+		return value;
+	}
+};
+
+TEST_F(SharePrivateAppearancesTest, identical_private_materials_share_appearance) {
+	utils::file::write((test_path() / "scale.lua").string(), R"(
+function interface(IN,OUT)
+	IN.v = Type:Vec3f()
+	OUT.translation = Type:Vec3f()
+end
+function run(IN,OUT)
+	OUT.translation = { 2 * IN.v[1], IN.v[2], IN.v[3] }
+end
+)");
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+	auto material = create_material("material", "shaders/basic.vert", "shaders/basic.frag");
+	auto red = createPrivateMeshNode("red", mesh, material, {1.0, 0.0, 0.0});
+	auto alsoRed = createPrivateMeshNode("also_red", mesh, material, {1.0, 0.0, 0.0});
+	auto green = createPrivateMeshNode("green", mesh, material, {0.0, 1.0, 0.0});
+	auto linked = createPrivateMeshNode("linked", mesh, material, {1.0, 0.0, 0.0});
+	auto script = create<LuaScript>("script");
+	context.set({script, &LuaScript::uri_}, (test_path() / "scale.lua").string());
+	context.set(core::ValueHandle(script, {"inputs", "v", "x"}), 0.25);
+	context.addLink({script, {"outputs", "translation"}}, {linked, {"materials", "material", "uniforms", "u_color"}});
+	ASSERT_TRUE(dispatch());
+
+	ramses_adaptor::SceneAdaptor reference{&backend.client(), ramses::sceneId_t{2u}, &project, dataChangeDispatcher, &errors};
+	ASSERT_TRUE(reference.logicEngine().update());
+
+	auto meshNodes = std::vector<core::SEditorObject>{red, alsoRed, green, linked};
+	EXPECT_EQ(appearance(sceneContext, red), appearance(sceneContext, alsoRed));
+	EXPECT_NE(appearance(sceneContext, red), appearance(sceneContext, green));
+	EXPECT_NE(appearance(sceneContext, red), appearance(sceneContext, linked));
+	EXPECT_EQ(select<ramses::Appearance>(*sceneContext.scene(), ramses::ERamsesObjectType::Appearance).size(), 4);
+	EXPECT_EQ(select<ramses::Appearance>(*reference.scene(), ramses::ERamsesObjectType::Appearance).size(), 5);
+	for (const auto& meshNode : {red, alsoRed, green}) {
+		EXPECT_EQ(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(meshNode)->appearanceBinding(), nullptr);
+	}
+	EXPECT_NE(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(linked)->appearanceBinding(), nullptr);
+	EXPECT_EQ(color(sceneContext, linked), glm::vec3(0.5f, 0.0f, 0.0f));
+	for (const auto& meshNode : meshNodes) {
+		EXPECT_EQ(color(sceneContext, meshNode), color(reference, meshNode)) << meshNode->objectName();
+	}
+
+	context.set(core::ValueHandle(alsoRed, {"materials", "material", "uniforms", "u_color"}), std::array<double, 3>{0.0, 1.0, 0.0});
+	context.removeLink({linked, {"materials", "material", "uniforms", "u_color"}});
+	ASSERT_TRUE(dispatch());
+	ASSERT_TRUE(reference.logicEngine().update());
+
+	EXPECT_EQ(appearance(sceneContext, alsoRed), appearance(sceneContext, green));
+	EXPECT_EQ(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(linked)->appearanceBinding(), nullptr);
+	for (const auto& meshNode : meshNodes) {
+		EXPECT_EQ(color(sceneContext, meshNode), color(reference, meshNode)) << meshNode->objectName();
+	}
+}
+
+TEST_F(SharePrivateAppearancesTest, skin_targets_keep_appearance_binding) {
+	auto material = create_material("material", "shaders/skinning-template.vert", "shaders/skinning-template.frag");
+	auto mesh = create_mesh("mesh", "meshes/SimpleSkin/SimpleSkin.gltf");
+	auto skinned = create_meshnode("skinned", mesh, material);
+	auto other = create_meshnode("other", mesh, material);
+	commandInterface.set(skinned->getMaterialPrivateHandle(0), true);
+	commandInterface.set(other->getMaterialPrivateHandle(0), true);
+	auto node1 = create<Node>("node1");
+	auto node2 = create<Node>("node2");
+	dispatch();
+
+	EXPECT_EQ(appearance(sceneContext, skinned), appearance(sceneContext, other));
+	EXPECT_EQ(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(skinned)->appearanceBinding(), nullptr);
+
+	auto skin = create_skin("skin", "meshes/SimpleSkin/SimpleSkin.gltf", 0, skinned, {node1, node2});
+	dispatch();
+
+	EXPECT_FALSE(commandInterface.errors().hasError({skin}));
+	EXPECT_EQ(sceneContext.logicEngine().getCollection<ramses::SkinBinding>().size(), 1);
+	EXPECT_NE(appearance(sceneContext, skinned), appearance(sceneContext, other));
+	EXPECT_NE(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(skinned)->appearanceBinding(), nullptr);
+	EXPECT_EQ(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(other)->appearanceBinding(), nullptr);
+
+	commandInterface.set(core::ValueHandle(skin, &Skin::targets_)[0], other);
+	dispatch();
+
+	EXPECT_FALSE(commandInterface.errors().hasError({skin}));
+	EXPECT_EQ(sceneContext.logicEngine().getCollection<ramses::SkinBinding>().size(), 1);
+	EXPECT_EQ(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(skinned)->appearanceBinding(), nullptr);
+	EXPECT_NE(sceneContext.lookup<ramses_adaptor::MeshNodeAdaptor>(other)->appearanceBinding(), nullptr);
+}
@@ -584,3 +584,53 @@ end
 	ASSERT_TRUE(dispatch());
 	EXPECT_EQ(logicEngine().getPropertyLinks().size(), 1);
 }
+
+TEST_F(LinkAdaptorFixture, link_commit_resolves_shared_properties_once) {
+	auto scriptFile = makeFile("lua_script.lua", R"(
+function interface(IN,OUT)
+	IN.x = Type:Float()
+	OUT.v = Type:Vec3f()
+end
+function run(IN,OUT)
+	OUT.v = { IN.x, 0.0, 0.0 }
+end
+	)");
+	auto lua = create_lua("lua", scriptFile);
+	std::vector<SNode> nodes;
+	for (int index = 0; index < 10; index++) {
+		nodes.emplace_back(create<Node>(fmt::format("node{}", index)));
+	}
+	ASSERT_TRUE(dispatch());
+
+	auto before = sceneContext.linkStatistics();
+	for (const auto& node : nodes) {
+		commandInterface.addLink({lua, {"outputs", "v"}}, {node, {"translation"}});
+	}
+	ASSERT_TRUE(dispatch());
+	EXPECT_EQ(logicEngine().getPropertyLinks().size(), 10);
+	EXPECT_EQ(sceneContext.linkStatistics().engineLinks - before.engineLinks, 10);
+	EXPECT_EQ(sceneContext.linkStatistics().engineUnlinks - before.engineUnlinks, 0);
+	// The shared start property is only looked up once.
+	EXPECT_EQ(sceneContext.linkStatistics().propertyLookups - before.propertyLookups, 11);
+	EXPECT_EQ(sceneContext.linkStatistics().commits - before.commits, 1);
+
+	// Syncing the start object reconnects all its links in a single commit.
+	before = sceneContext.linkStatistics();
+	commandInterface.set({lua, {"inputs", "x"}}, 2.0);
+	ASSERT_TRUE(dispatch());
+	EXPECT_EQ(logicEngine().getPropertyLinks().size(), 10);
+	EXPECT_EQ(sceneContext.linkStatistics().engineLinks - before.engineLinks, 10);
+	EXPECT_EQ(sceneContext.linkStatistics().engineUnlinks - before.engineUnlinks, 10);
+	EXPECT_EQ(sceneContext.linkStatistics().propertyLookups - before.propertyLookups, 11);
+	EXPECT_EQ(sceneContext.linkStatistics().commits - before.commits, 1);
+	checkRamsesNodeTranslation("node3", {2.0, 0.0, 0.0});
+
+	before = sceneContext.linkStatistics();
+	for (const auto& node : nodes) {
+		commandInterface.removeLink({node, {"translation"}});
+	}
+	ASSERT_TRUE(dispatch());
+	EXPECT_EQ(logicEngine().getPropertyLinks().size(), 0);
+	EXPECT_EQ(sceneContext.linkStatistics().engineLinks - before.engineLinks, 0);
+	EXPECT_EQ(sceneContext.linkStatistics().engineUnlinks - before.engineUnlinks, 10);
+}
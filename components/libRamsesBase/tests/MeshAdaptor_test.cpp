@@ -76,4 +76,57 @@ TEST_F(MeshAdaptorTest, gltf_with_meshes_but_no_mesh_refs_unbaked) {
 	ASSERT_TRUE(isRamsesNameInArray("Mesh Name_MeshVertexData_a_Normal", meshStuff));
 	ASSERT_TRUE(isRamsesNameInArray("Mesh Name_MeshVertexData_a_TextureCoordinate", meshStuff));
 	ASSERT_EQ(context.errors().getError(mesh).level(), core::ErrorLevel::INFORMATION);
-}
\ No newline at end of file
+}
+
+TEST_F(MeshAdaptorTest, interleave_attributes_reconstruct) {
+	auto mesh = create<user_types::Mesh>("mesh");
+	context.set({mesh, &user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+	dispatch();
+
+	auto meshData = mesh->meshData();
+	ASSERT_TRUE(meshData != nullptr);
+	auto interleaved = ramses_adaptor::interleaveVertexAttributes(*meshData);
+	ASSERT_TRUE(interleaved.has_value());
+	ASSERT_EQ(interleaved->attributes.size(), meshData->numAttributes());
+	EXPECT_EQ(interleaved->data.size(), static_cast<size_t>(interleaved->stride) * interleaved->vertexCount);
+
+	for (uint32_t index = 0; index < meshData->numAttributes(); index++) {
+		const auto& attribute = interleaved->attributes[index];
+		EXPECT_EQ(attribute.name, meshData->attribName(index));
+		auto elementSize = ramses_adaptor::vertexAttribElementSize(attribute.type);
+		ASSERT_EQ(meshData->attribDataSize(index), elementSize * interleaved->vertexCount);
+
+		std::vector<char> reconstructed;
+		for (uint32_t vertex = 0; vertex < interleaved->vertexCount; vertex++) {
+			auto element = reinterpret_cast<const char*>(interleaved->data.data()) + vertex * interleaved->stride + attribute.offset;
+			reconstructed.insert(reconstructed.end(), element, element + elementSize);
+		}
+		EXPECT_EQ(reconstructed, std::vector<char>(meshData->attribBuffer(index), meshData->attribBuffer(index) + meshData->attribDataSize(index)));
+	}
+}
+
+TEST_F(MeshAdaptorTest, interleaved_scene_single_vertex_buffer) {
+	auto mesh = create<user_types::Mesh>("mesh");
+	context.set({mesh, &user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+	auto material = create_material("material", "shaders/basic.vert", "shaders/basic.frag");
+	create_meshnode("meshnode", mesh, material);
+	dispatch();
+
+	ramses_adaptor::SceneAdaptor interleavedScene{&backend.client(), ramses::sceneId_t{2u}, &project, std::make_shared<DataChangeDispatcher>(), &errors, true, true};
+
+	auto resources{select<ramses::ArrayResource>(*interleavedScene.scene(), ramses::ERamsesObjectType::ArrayResource)};
+	ASSERT_TRUE(isRamsesNameInArray("mesh_MeshIndexData", resources));
+	ASSERT_TRUE(isRamsesNameInArray("mesh_MeshVertexData", resources));
+	EXPECT_FALSE(isRamsesNameInArray("mesh_MeshVertexData_a_Position", resources));
+
+	auto meshAdaptor = interleavedScene.lookup<ramses_adaptor::MeshAdaptor>(mesh);
+	const auto& vertexData = meshAdaptor->vertexData();
+	ASSERT_EQ(vertexData.size(), 3);
+	EXPECT_EQ(vertexData.at("a_Position"), vertexData.at("a_Normal"));
+	EXPECT_EQ(meshAdaptor->vertexDataLayout("a_Position").stride, meshAdaptor->vertexDataLayout("a_Normal").stride);
+	EXPECT_NE(meshAdaptor->vertexDataLayout("a_Position").offset, meshAdaptor->vertexDataLayout("a_Normal").offset);
+	EXPECT_EQ(meshAdaptor->getExportInformation().size(), 2);
+
+	// The default scene still uses separate vertex buffers.
+	EXPECT_EQ(sceneContext.lookup<ramses_adaptor::MeshAdaptor>(mesh)->vertexDataLayout("a_Position").stride, 0);
+}
@@ -55,10 +55,10 @@ class RamsesBaseFixture : public TestEnvironmentCoreT<BaseClass> {
 public:
 	using DataChangeDispatcher = components::DataChangeDispatcher;
 
-	RamsesBaseFixture(bool optimizeForExport = false, ramses::EFeatureLevel featureLevel = ramses_base::BaseEngineBackend::maxFeatureLevel)
+	RamsesBaseFixture(bool optimizeForExport = false, ramses::EFeatureLevel featureLevel = ramses_base::BaseEngineBackend::maxFeatureLevel, ramses_adaptor::ExportOptimizations exportOptimizations = {})
 		: TestEnvironmentCoreT<BaseClass>(&user_types::UserObjectFactory::getInstance(), featureLevel),
 		  dataChangeDispatcher{std::make_shared<DataChangeDispatcher>()},
-		  sceneContext{&this->backend.client(), ramses::sceneId_t{1u}, &this->project, dataChangeDispatcher, &this->errors, optimizeForExport} {}
+		  sceneContext{&this->backend.client(), ramses::sceneId_t{1u}, &this->project, dataChangeDispatcher, &this->errors, optimizeForExport, false, nullptr, exportOptimizations} {}
 
 	std::shared_ptr<DataChangeDispatcher> dataChangeDispatcher;
 	ramses_adaptor::SceneAdaptor sceneContext;
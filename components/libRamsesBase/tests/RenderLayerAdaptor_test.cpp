@@ -266,6 +266,26 @@ TEST_F(RenderLayerAdaptorTest, matfilter_include_change_mat_tags) {
 	ASSERT_TRUE(engineGroupNested->containsMeshNode(*engineMeshNode_alt));
 }
 
+TEST_F(RenderLayerAdaptorTest, matfilter_include_change_meshnode_material) {
+	auto root = create<Node>("root", nullptr, {"render_main"});
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+	auto material = create<Material>("material", nullptr, {});
+	auto material_def = create<Material>("material_def", nullptr, {"mat_default"});
+	auto meshnode = create_meshnode("meshnode", mesh, material, root);
+	auto layer = create_layer("layer", {}, {{"render_main", 0}}, {"mat_default"}, false);
+
+	dispatch();
+
+	auto engineMeshNode = select<ramses::MeshNode>(*sceneContext.scene(), "meshnode");
+	auto engineGroupNested = select<ramses::RenderGroup>(*sceneContext.scene(), "layer.render_main");
+	ASSERT_FALSE(engineGroupNested->containsMeshNode(*engineMeshNode));
+
+	context.set({meshnode, {"materials", "material", "material"}}, material_def);
+	dispatch();
+	engineGroupNested = select<ramses::RenderGroup>(*sceneContext.scene(), "layer.render_main");
+	ASSERT_TRUE(engineGroupNested->containsMeshNode(*engineMeshNode));
+}
+
 TEST_F(RenderLayerAdaptorTest, matfilter_include_change_layer_matfilter) {
 	auto root = create<Node>("root", nullptr, {"render_main"});
 	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
@@ -645,3 +665,74 @@ TEST_F(RenderLayerAdaptorTest, sortorder_scenegraph) {
 	ASSERT_EQ(getGroupSortOrder(*engineGroup, *engineGroupNested_main), 1);
 	ASSERT_EQ(getGroupSortOrder(*engineGroup, *engineGroupNested_alt), 0);
 }
+
+TEST_F(RenderLayerAdaptorTest, tag_change_updates_tagged_subtree) {
+	auto root = create<Node>("root");
+	auto inner = create<Node>("inner", root);
+	auto meshnode = create<MeshNode>("meshnode", inner);
+	auto other = create<MeshNode>("other", root);
+	auto layer = create_layer("layer", {}, {{"render_main", 0}});
+
+	dispatch();
+
+	auto engineMeshNode = select<ramses::MeshNode>(*sceneContext.scene(), "meshnode");
+	auto engineOther = select<ramses::MeshNode>(*sceneContext.scene(), "other");
+	auto engineGroupNested = select<ramses::RenderGroup>(*sceneContext.scene(), "layer.render_main");
+	ASSERT_FALSE(engineGroupNested->containsMeshNode(*engineMeshNode));
+	ASSERT_FALSE(engineGroupNested->containsMeshNode(*engineOther));
+
+	auto rebuilds = sceneContext.tagMatchTable().statistics().sceneGraphRebuilds;
+	auto subtreeUpdates = sceneContext.tagMatchTable().statistics().subtreeUpdates;
+
+	context.set({inner, {"tags"}}, std::vector<std::string>({"render_main"}));
+	dispatch();
+	engineGroupNested = select<ramses::RenderGroup>(*sceneContext.scene(), "layer.render_main");
+	ASSERT_TRUE(engineGroupNested->containsMeshNode(*engineMeshNode));
+	ASSERT_FALSE(engineGroupNested->containsMeshNode(*engineOther));
+
+	// Only the subtree of the retagged node is updated.
+	EXPECT_EQ(sceneContext.tagMatchTable().statistics().sceneGraphRebuilds, rebuilds);
+	EXPECT_EQ(sceneContext.tagMatchTable().statistics().subtreeUpdates, subtreeUpdates + 1);
+
+	context.set({inner, {"tags"}}, std::vector<std::string>({}));
+	context.set({root, {"tags"}}, std::vector<std::string>({"render_main"}));
+	dispatch();
+	engineGroupNested = select<ramses::RenderGroup>(*sceneContext.scene(), "layer.render_main");
+	ASSERT_TRUE(engineGroupNested->containsMeshNode(*engineMeshNode));
+	ASSERT_TRUE(engineGroupNested->containsMeshNode(*engineOther));
+	EXPECT_EQ(sceneContext.tagMatchTable().statistics().sceneGraphRebuilds, rebuilds);
+}
+
+TEST_F(RenderLayerAdaptorTest, tag_change_only_updates_affected_layers) {
+	auto root = create<Node>("root");
+	auto meshnode = create<MeshNode>("meshnode", root);
+	auto layerMain = create_layer("layer_main", {}, {{"render_main", 0}});
+	auto layerAlt = create_layer("layer_alt", {}, {{"render_alt", 0}});
+	auto layerFilter = create_layer("layer_filter", {}, {{"render_other", 0}}, {"mat_tag"}, false);
+
+	dispatch();
+
+	auto affectedLayers = sceneContext.tagMatchTable().statistics().affectedRenderLayers;
+	context.set({root, {"tags"}}, std::vector<std::string>({"render_main"}));
+	dispatch();
+	EXPECT_EQ(sceneContext.tagMatchTable().statistics().affectedRenderLayers, affectedLayers + 1);
+
+	auto engineMeshNode = select<ramses::MeshNode>(*sceneContext.scene(), "meshnode");
+	ASSERT_TRUE(select<ramses::RenderGroup>(*sceneContext.scene(), "layer_main.render_main")->containsMeshNode(*engineMeshNode));
+	ASSERT_FALSE(select<ramses::RenderGroup>(*sceneContext.scene(), "layer_alt.render_alt")->containsMeshNode(*engineMeshNode));
+
+	// Moving the mesh node changes its scenegraph index and therefore the layers using its tags.
+	affectedLayers = sceneContext.tagMatchTable().statistics().affectedRenderLayers;
+	auto other = create<Node>("other");
+	context.moveScenegraphChildren({other}, root, 0);
+	dispatch();
+	EXPECT_EQ(sceneContext.tagMatchTable().statistics().affectedRenderLayers, affectedLayers + 1);
+
+	// Tags of materials only affect the layers filtering by them.
+	affectedLayers = sceneContext.tagMatchTable().statistics().affectedRenderLayers;
+	auto material = create<Material>("material");
+	dispatch();
+	context.set({material, {"tags"}}, std::vector<std::string>({"mat_tag"}));
+	dispatch();
+	EXPECT_EQ(sceneContext.tagMatchTable().statistics().affectedRenderLayers, affectedLayers + 1);
+}
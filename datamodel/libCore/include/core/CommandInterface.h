@@ -12,6 +12,7 @@
 #include "EditorObject.h"
 #include "Handles.h"
 #include "Link.h"
+#include "NumericDataImport.h"
 
 #include <string>
 #include <vector>
@@ -90,7 +91,26 @@ public:
 	*/
 	void set(const std::set<ValueHandle>& handles, double const& value);
 
-	
+	/**
+	 * @brief Set all numeric properties in a property subtree generating only a single undo stack entry.
+	 * 
+	 * The Int, Int64 and Double properties inside the subtree of the handle are assigned the values in depth-first order.
+	 * Other properties, volatile properties and properties inaccessible at the project feature level are skipped.
+	 * The handlers of objects referencing the changed object are invoked only once for the complete subtree.
+	 * 
+	 * @param handle Handle of a numeric property or of an Array, Struct or Table property.
+	 * @param values The number of values must match the number of numeric properties in the subtree. Values assigned
+	 *   to Int and Int64 properties must be integral and in range.
+	 */
+	void setNumericValues(ValueHandle const& handle, std::vector<NumericValue> const& values);
+
+	/**
+	 * @brief Read the values from a CSV or typed binary sidecar file and set them using setNumericValues.
+	 * 
+	 * The file format is determined from the extension, see numericDataFormatFromPath.
+	 */
+	void importNumericValues(ValueHandle const& handle, std::string const& filePath);
+
 	bool canSetTags(ValueHandle const& handle, std::vector<std::string> const& value, std::string* outError = nullptr) const;
 
 	// Set a tag set property
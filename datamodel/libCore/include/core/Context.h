@@ -15,6 +15,7 @@
 #include "ExtrefOperations.h"
 #include "Handles.h"
 #include "Link.h"
+#include "NumericDataImport.h"
 
 namespace raco::serialization {
 struct ObjectsDeserialization;
@@ -84,6 +85,13 @@ public:
 	void set(ValueHandle const& handle, std::array<int, 2> const& value);
 	void set(ValueHandle const& handle, std::array<int, 3> const& value);
 	void set(ValueHandle const& handle, std::array<int, 4> const& value);
+
+	// Set numeric properties inside the subtree of handle to the corresponding values.
+	// The value changed handler of the object is called for every changed property but the handlers of the
+	// referencing objects are called only once for the subtree instead of once per property.
+	// @param properties Int, Int64 or Double properties inside the subtree of handle with the same size as values
+	void setNumericValues(ValueHandle const& handle, std::vector<ValueHandle> const& properties, std::vector<NumericValue> const& values);
+
 	// Set struct property to struct value.
 	// Identical types are dynamically enforced at runtime.
 	void set(ValueHandle const& handle, StructBase const& value);
@@ -208,6 +208,10 @@ public:
 	// Used to check back pointers in the unit tests.
 	const std::set<WEditorObject, std::owner_less<WEditorObject>>& referencesToThis() const;
 
+	// Absolute paths of all files currently watched for this object, i.e. the files referenced by URI properties
+	// and their dependencies like shader include files.
+	std::set<std::string> watchedFilePaths() const;
+
 protected:
 	// Create file watchers for paths and associate them with the specified property.
 	void recreatePropertyFileWatchers(BaseContext& context, const std::string& propertyName, const std::set<std::string>& paths);
@@ -222,6 +226,7 @@ private:
 	mutable std::set<WEditorObject, std::owner_less<WEditorObject>> referencesToThis_;
 	
 	mutable std::map<std::string, std::set<FileChangeMonitor::UniqueListener>> uriListeners_;
+	mutable std::map<std::string, std::set<std::string>> uriWatchedPaths_;
 };
 
 class CompareEditorObjectByID {
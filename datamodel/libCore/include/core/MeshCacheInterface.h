@@ -218,6 +218,9 @@ struct MeshDescriptor {
 	std::string absPath{};
 	int submeshIndex{0};
 	bool bakeAllSubmeshes{true};
+	// Weld duplicate vertices and reorder triangles and vertices for better GPU vertex cache and fetch efficiency.
+	// Only supported for glTF files.
+	bool optimize{false};
 };
 
 // Cache entry for each file.
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace raco::core {
+
+/**
+ * @brief Value for the bulk import of numeric properties.
+ *
+ * Integral values are kept as int64_t since not every int64_t value can be represented exactly by a double.
+ */
+using NumericValue = std::variant<int64_t, double>;
+
+/**
+ * @brief Format of the sidecar files used for bulk import of numeric property values.
+ */
+enum class NumericDataFormat {
+	// Text file with numbers separated by commas, semicolons or whitespace. Lines starting with '#' are ignored.
+	Csv,
+	// Raw little-endian binary arrays of the respective element type.
+	Float32,
+	Float64,
+	Int32,
+	Int64
+};
+
+/**
+ * @brief Determine the sidecar file format from the file extension.
+ *
+ * Recognized extensions are ".csv", ".txt", ".f32", ".f64", ".i32" and ".i64".
+ *
+ * @exception std::runtime_error if the extension is not recognized.
+ */
+NumericDataFormat numericDataFormatFromPath(const std::string& path);
+
+/**
+ * @brief Read all values from a numeric sidecar file.
+ *
+ * Values of the integer binary formats and CSV numbers without fraction or exponent are returned as int64_t.
+ *
+ * @exception std::runtime_error if the file can't be read or contains invalid data.
+ */
+std::vector<NumericValue> readNumericData(const std::string& path, NumericDataFormat format);
+std::vector<NumericValue> readNumericData(const std::string& path);
+
+}  // namespace raco::core
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/EditorObject.h"
+#include "core/Link.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace raco::core {
+
+class Project;
+
+/**
+ * @brief Receives the differences found by diffProjects.
+ *
+ * The callbacks are invoked during the traversal of the projects, i.e. differences are streamed without
+ * collecting them first. Objects are reported in the order of their object IDs followed by the links.
+ * The property path is relative to the object and contains the property names, array elements use their index names.
+ */
+class ProjectDiffSink {
+public:
+	virtual ~ProjectDiffSink() = default;
+
+	virtual void objectAdded(const SEditorObject& newObject) = 0;
+	virtual void objectRemoved(const SEditorObject& oldObject) = 0;
+
+	virtual void propertyAdded(const SEditorObject& newObject, const std::vector<std::string>& path, const ValueBase& newValue) = 0;
+	virtual void propertyRemoved(const SEditorObject& oldObject, const std::vector<std::string>& path, const ValueBase& oldValue) = 0;
+	virtual void propertyChanged(const SEditorObject& newObject, const std::vector<std::string>& path, const ValueBase& oldValue, const ValueBase& newValue) = 0;
+
+	virtual void linkAdded(const SLink& newLink) = 0;
+	virtual void linkRemoved(const SLink& oldLink) = 0;
+	// Link with the same start and end properties has changed its valid or weak flag.
+	virtual void linkChanged(const SLink& oldLink, const SLink& newLink) = 0;
+};
+
+struct ProjectDiffStatistics {
+	size_t addedObjects = 0;
+	size_t removedObjects = 0;
+	size_t changedObjects = 0;
+	size_t addedProperties = 0;
+	size_t removedProperties = 0;
+	size_t changedProperties = 0;
+	size_t addedLinks = 0;
+	size_t removedLinks = 0;
+	size_t changedLinks = 0;
+
+	bool empty() const;
+};
+
+/**
+ * @brief Structural comparison of two projects.
+ *
+ * Objects are matched by object ID. The property trees of matching objects are walked side by side and
+ * only the differing leaf properties are reported. References are compared by object ID.
+ * Objects whose type has changed are reported as removed and added.
+ * Links are matched by their start and end property.
+ */
+ProjectDiffStatistics diffProjects(const Project& oldProject, const Project& newProject, ProjectDiffSink& sink);
+
+/**
+ * @brief Writes the differences as JSON Lines, i.e. one compact JSON object per difference and line.
+ *
+ * Examples:
+ *   {"op":"add","kind":"object","id":"...","type":"Node","name":"node"}
+ *   {"op":"change","kind":"property","id":"...","path":"translation.x","old":0,"new":2}
+ *   {"op":"remove","kind":"link","start":"<id>.outputs.v","end":"<id>.translation","valid":true,"weak":false}
+ */
+class ProjectDiffJsonWriter : public ProjectDiffSink {
+public:
+	explicit ProjectDiffJsonWriter(std::ostream& stream);
+
+	void objectAdded(const SEditorObject& newObject) override;
+	void objectRemoved(const SEditorObject& oldObject) override;
+
+	void propertyAdded(const SEditorObject& newObject, const std::vector<std::string>& path, const ValueBase& newValue) override;
+	void propertyRemoved(const SEditorObject& oldObject, const std::vector<std::string>& path, const ValueBase& oldValue) override;
+	void propertyChanged(const SEditorObject& newObject, const std::vector<std::string>& path, const ValueBase& oldValue, const ValueBase& newValue) override;
+
+	void linkAdded(const SLink& newLink) override;
+	void linkRemoved(const SLink& oldLink) override;
+	void linkChanged(const SLink& oldLink, const SLink& newLink) override;
+
+private:
+	std::ostream& stream_;
+};
+
+}  // namespace raco::core
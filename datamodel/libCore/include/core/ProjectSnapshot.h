@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/ChangeRecorder.h"
+#include "core/EditorObject.h"
+#include "core/Project.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace raco::core {
+
+class BaseContext;
+
+/**
+ * @brief Immutable copy of the project state which may be read from any thread.
+ *
+ * The objects and links of a snapshot are never modified after the snapshot has been created by the ProjectSnapshotter.
+ * Any number of threads may therefore read a snapshot concurrently while the live project is changed by the UI thread.
+ * Only reading operations are allowed on the snapshot objects, i.e. the const Project functions, ValueHandle getters and
+ * the const Queries functions which don't use the scenegraph parent or the referencing objects.
+ *
+ * Objects which are unchanged between consecutive snapshots are shared between them. All object references in the properties
+ * of a snapshot object point to objects of the same snapshot.
+ *
+ * The data model back pointers are not maintained in snapshot objects: EditorObject::getParent returns nullptr and
+ * EditorObject::referencesToThis is empty. Use ProjectSnapshot::parent instead.
+ * Volatile data like the parsed Lua interface or cached mesh data is not part of the snapshot.
+ */
+class ProjectSnapshot {
+public:
+	ProjectSnapshot(const ProjectSnapshot&) = delete;
+	ProjectSnapshot& operator=(const ProjectSnapshot&) = delete;
+
+	const Project& project() const;
+
+	// Consecutive snapshots of a ProjectSnapshotter have increasing generation numbers starting at 1.
+	size_t generation() const;
+
+	// Scenegraph parent of a snapshot object; nullptr for root objects.
+	// The parent map of the snapshot is built by the first call.
+	SEditorObject parent(const SEditorObject& object) const;
+
+	// Number of objects which were copied from the live project and number of objects which were shared
+	// with the previous snapshot when this snapshot was created.
+	size_t copiedObjects() const;
+	size_t sharedObjects() const;
+
+private:
+	friend class ProjectSnapshotter;
+
+	ProjectSnapshot(size_t generation);
+
+	Project project_;
+	size_t generation_;
+	size_t copiedObjects_ = 0;
+	size_t sharedObjects_ = 0;
+
+	mutable std::once_flag parentMapFlag_;
+	mutable std::unordered_map<std::string, SEditorObject> parentMap_;
+};
+
+using SProjectSnapshot = std::shared_ptr<const ProjectSnapshot>;
+
+/**
+ * @brief Creates ProjectSnapshots of the live project of a context for use by background analysis threads.
+ *
+ * The changes since the previous snapshot are tracked by a change recorder registered in the change multiplexer of the context.
+ * When a snapshot is taken the changed objects are copied into the new snapshot like in the undo stack. Since the unchanged objects are
+ * shared with the previous snapshot the objects referencing a copied object need to be copied as well, e.g. the scenegraph ancestors
+ * of a changed node. All other objects are shared. Links are only cloned if they or one of their endpoint objects changed.
+ *
+ * takeSnapshot must be called from the thread modifying the project; latest may be called from any thread.
+ * The snapshotter should be created after the project has been loaded since resetting the change multiplexer of the context
+ * also discards the changes recorded for the next snapshot.
+ */
+class ProjectSnapshotter {
+public:
+	ProjectSnapshotter(BaseContext* context);
+	~ProjectSnapshotter();
+
+	ProjectSnapshotter(const ProjectSnapshotter&) = delete;
+	ProjectSnapshotter& operator=(const ProjectSnapshotter&) = delete;
+
+	// Create a snapshot of the current project state.
+	// Returns the previous snapshot if the project hasn't changed since it was taken.
+	SProjectSnapshot takeSnapshot();
+
+	// Most recent snapshot or nullptr if no snapshot has been taken yet.
+	SProjectSnapshot latest() const;
+
+private:
+	bool hasChanges() const;
+
+	BaseContext* context_;
+	DataChangeRecorder changes_;
+
+	mutable std::mutex latestMutex_;
+	SProjectSnapshot latest_;
+};
+
+}  // namespace raco::core
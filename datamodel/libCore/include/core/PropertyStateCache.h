@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/EditorObject.h"
+#include "core/Handles.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace raco::core {
+
+class DataChangeRecorder;
+class Project;
+
+/**
+ * @brief Cache for the read-only and property browser visibility state of properties.
+ *
+ * Gives the same results as Queries::isReadOnly and Queries::isHiddenInPropertyBrowser. The states of all properties of an
+ * object are evaluated together in a single top-down pass over the property tree when the first property of the object is
+ * queried. The object-level conditions (external reference, prefab instance content, material slots) are determined only once
+ * per object and the read-only state of a property is passed down to its children instead of being recomputed for every
+ * descendant.
+ *
+ * The cached states are invalidated using the change recorder contents, see invalidate.
+ * The code-controlled object state is not cached but checked on every query.
+ */
+class PropertyStateCache {
+public:
+	// See Queries::isReadOnly(const Project&, const ValueHandle&, bool)
+	bool isReadOnly(const Project& project, const ValueHandle& handle, bool linkState = false);
+
+	// See Queries::isHiddenInPropertyBrowser
+	bool isHiddenInPropertyBrowser(const Project& project, const ValueHandle& handle, bool isMultiSelect);
+
+	// Invalidate the objects affected by the recorded changes.
+	// Structural changes (object creation or deletion, scenegraph parent changes) invalidate all objects
+	// since they can change the prefab instance membership of entire subtrees.
+	void invalidate(const DataChangeRecorder& changes);
+	void invalidate(const SEditorObject& object);
+	void clear();
+
+private:
+	struct PropertyState {
+		// Read-only state for linkState = false and linkState = true respectively
+		bool readOnly = false;
+		bool linkStateReadOnly = false;
+		// Hidden state for isMultiSelect = false and isMultiSelect = true respectively
+		bool hidden = false;
+		bool hiddenMultiSelect = false;
+	};
+
+	using ObjectStates = std::map<ValueHandle, PropertyState>;
+
+	// Object-level data used while evaluating the properties of an object.
+	struct ObjectContext;
+
+	const PropertyState* findState(const Project& project, const ValueHandle& handle);
+	static ObjectStates evaluate(const Project& project, const SEditorObject& object);
+	static void evaluateChildren(const ObjectContext& context, const ValueHandle& parent, const ReflectionInterface& container, std::vector<std::string>& propertyPath,
+		bool parentReadOnly, bool inLockedMaterialSlot, bool inLockedRenderLayerTags, bool interfaceProperty, ObjectStates& outStates);
+
+	std::unordered_map<SEditorObject, ObjectStates> objectStates_;
+};
+
+}  // namespace raco::core
@@ -32,6 +32,8 @@ namespace Queries {
 	std::vector<ValueHandle> findAllReferences(const SEditorObject& object);
 	std::vector<SEditorObject> findAllUnreferencedObjects(Project const& project, std::function<bool(SEditorObject)> predicate = nullptr);
 	std::vector<SEditorObject> findAllValidReferenceTargets(Project const& project, const ValueHandle& handle );
+	// Same as findAllValidReferenceTargets but only checks the candidate objects instead of all project instances.
+	std::vector<SEditorObject> findValidReferenceTargets(Project const& project, const ValueHandle& handle, const std::vector<SEditorObject>& candidates);
 	bool isValidReferenceTarget(Project const& project, const ValueHandle& handle, SEditorObject object);
 
 	SEditorObject findById(const Project& project, const std::string& id);
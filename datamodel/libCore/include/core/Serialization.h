@@ -138,8 +138,26 @@ std::unique_ptr<ValueBase> deserializeProperty(const core::Project& project, con
 
 std::optional<ObjectsDeserialization> deserializeObjects(const std::string& json, bool checkVersionInfo = true, core::UserObjectFactoryInterface& factory = user_types::UserObjectFactory::getInstance());
 
+/**
+ * @brief Deserialize a project file into user types.
+ * 
+ * Files at the current file version are deserialized directly into the user types using deserializeProjectToUserTypes.
+ * Older files are deserialized via the proxy types and migrated using deserializeProjectWithMigration.
+*/
 ProjectDeserializationInfo deserializeProject(const QJsonDocument& jsonDocument, const std::string& filename);
 
+/**
+ * @brief Deserialize a project file via the intermediate proxy types, run the migration code and convert the result into user types.
+*/
+ProjectDeserializationInfo deserializeProjectWithMigration(const QJsonDocument& document, const std::string& filename);
+
+/**
+ * @brief Deserialize a project file directly into user types without creating the intermediate proxy objects.
+ * 
+ * Only valid for files with the current file version RAMSES_PROJECT_FILE_VERSION since no migration is performed.
+*/
+ProjectDeserializationInfo deserializeProjectToUserTypes(const QJsonDocument& document, const std::string& filename);
+
 std::map<std::string, std::map<std::string, std::string>> makeUserTypePropertyMap(core::UserObjectFactoryInterface& objectFactory = user_types::UserObjectFactory::getInstance());
 std::map<std::string, std::map<std::string, std::string>> makeStructPropertyMap();
 std::map<std::string, std::map<std::string, std::string>> deserializeUserTypePropertyMap(const QVariant& container);
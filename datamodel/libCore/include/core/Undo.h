@@ -33,11 +33,18 @@ public:
 	static void updateEditorObject(const EditorObject *src, SEditorObject dest, translateRefFunc translateRef, excludePropertyPredicateFunc excludeIf, UserObjectFactoryInterface &factory, DataChangeRecorder *outChanges, bool invokeHandler, bool updateObjectAnnotations = true);
 	static void updateMissingTableProperties(const Table *src, Table *dest, ValueHandle destHandle, translateRefFunc translateRef, DataChangeRecorder *outChanges, bool invokeHandler);
 
+	// Check if updateSingleValue would modify the dest value including its annotation data.
+	// Only reads src and dest and may therefore be called concurrently.
+	static bool isValueEqual(const ValueBase *src, const ValueBase *dest, translateRefFunc translateRef);
+	// Check if updateEditorObject would modify the object annotations of dest.
+	static bool areObjectAnnotationsEqual(const EditorObject *src, const EditorObject *dest, translateRefFunc translateRef);
+
 private:
 	static void updateTableAsArray(const Table *src, Table *dest, ValueHandle destHandle, translateRefFunc translateRef, DataChangeRecorder *outChanges, bool invokeHandler);
 	static void updateArray(const ArrayBase *src, ArrayBase *dest, ValueHandle destHandle, translateRefFunc translateRef, DataChangeRecorder *outChanges, bool invokeHandle);
 	static void updateStruct(const ClassWithReflectedMembers *src, ClassWithReflectedMembers *dest, ValueHandle destHandle, translateRefFunc translateRef, DataChangeRecorder *outChanges, bool invokeHandler);
 	static void updateTableByName(const Table *src, Table *dest, ValueHandle destHandle, translateRefFunc translateRef, DataChangeRecorder *outChanges, bool invokeHandler);
+	static bool areAnnotationsEqual(const std::vector<AnnotationBase *> &src, const std::vector<AnnotationBase *> &dest, translateRefFunc translateRef);
 };
 
 class UndoStack {
@@ -109,6 +116,10 @@ protected:
 	BaseContext *context_;
 	Callback onChange_;
 
+	// Minimum number of objects in the project for which restoreProjectState computes the 
+	// object differences on multiple threads. Smaller projects are updated serially.
+	size_t parallelRestoreThreshold_ = 256;
+
 	struct Entry {
 		Entry(std::string description = std::string(), std::string mergeId = std::string());
 		std::string description;
@@ -11,7 +11,9 @@
 
 #include "core/Context.h"
 #include "core/CoreFormatter.h"
+#include "core/Iterators.h"
 #include "core/MeshCacheInterface.h"
+#include "core/NumericDataImport.h"
 #include "core/PathManager.h"
 #include "core/PrefabOperations.h"
 #include "core/Queries.h"
@@ -24,6 +26,8 @@
 
 #include <spdlog/fmt/bundled/ranges.h>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace raco::core {
 
@@ -255,6 +259,76 @@ void CommandInterface::set(const std::set<ValueHandle>& handles, double const& v
 	}
 }
 
+void CommandInterface::setNumericValues(ValueHandle const& handle, std::vector<NumericValue> const& values) {
+	checkHandleForSet(handle);
+
+	auto isNumeric = [this](const ValueHandle& property) {
+		auto type = property.type();
+		if (type != PrimitiveType::Int && type != PrimitiveType::Int64 && type != PrimitiveType::Double) {
+			return false;
+		}
+		if (property.query<VolatileProperty>()) {
+			return false;
+		}
+		if (auto anno = property.query<FeatureLevel>(); anno && *anno->featureLevel_ > project()->featureLevel()) {
+			return false;
+		}
+		return true;
+	};
+
+	std::vector<ValueHandle> properties;
+	if (handle.hasSubstructure()) {
+		for (auto property : ValueTreeIteratorAdaptor(handle)) {
+			if (isNumeric(property)) {
+				properties.emplace_back(property);
+			}
+		}
+	} else if (isNumeric(handle)) {
+		properties.emplace_back(handle);
+	}
+
+	if (properties.size() != values.size()) {
+		throw std::runtime_error(fmt::format("Property '{}' contains {} numeric properties but {} values were given", handle.getPropertyPath(), properties.size(), values.size()));
+	}
+
+	// Check everything before changing anything to keep the operation atomic.
+	for (size_t index = 0; index < properties.size(); index++) {
+		const auto& property = properties[index];
+		checkHandleForSet(property);
+		if (property.type() != PrimitiveType::Double) {
+			int64_t intValue;
+			if (auto doubleValue = std::get_if<double>(&values[index])) {
+				// Doubles outside of the int64_t range can't be converted. All int64_t values are accepted below.
+				if (std::trunc(*doubleValue) != *doubleValue || *doubleValue < -9223372036854775808.0 || *doubleValue >= 9223372036854775808.0) {
+					throw std::runtime_error(fmt::format("Value {} for property '{}' is not a valid integer", *doubleValue, property.getPropertyPath()));
+				}
+				intValue = static_cast<int64_t>(*doubleValue);
+			} else {
+				intValue = std::get<int64_t>(values[index]);
+			}
+			if (property.type() == PrimitiveType::Int && (intValue < std::numeric_limits<int>::min() || intValue > std::numeric_limits<int>::max())) {
+				throw std::runtime_error(fmt::format("Value {} for property '{}' is not a valid integer", intValue, property.getPropertyPath()));
+			}
+			if (auto anno = property.query<core::EnumerationAnnotation>()) {
+				auto description = user_types::enumerationDescription(static_cast<core::EUserTypeEnumerations>(anno->type_.asInt()));
+				if (description.find(static_cast<int>(intValue)) == description.end()) {
+					throw std::runtime_error(fmt::format("Value '{}' not in enumeration type", intValue));
+				}
+			}
+		}
+	}
+
+	if (!properties.empty()) {
+		context_->setNumericValues(handle, properties, values);
+		PrefabOperations::globalPrefabUpdate(*context_);
+		undoStack_->push(fmt::format("Set {} numeric values of property '{}'", values.size(), handle.getPropertyPath()));
+	}
+}
+
+void CommandInterface::importNumericValues(ValueHandle const& handle, std::string const& filePath) {
+	setNumericValues(handle, readNumericData(filePath));
+}
+
 void CommandInterface::set(ValueHandle const& handle, std::string const& value) {
 	if (checkScalarHandleForSet(handle, PrimitiveType::String, true)) {
 		auto newValue = handle.query<URIAnnotation>() ? utils::u8path::sanitizePathString(value) : value;
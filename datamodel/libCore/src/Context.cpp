@@ -36,6 +36,7 @@
 #include "user_types/Prefab.h"
 #include "user_types/PrefabInstance.h"
 #include "user_types/Skin.h"
+#include "utils/PhaseTracer.h"
 
 #include <core/PathManager.h>
 #include <spdlog/fmt/fmt.h>
@@ -117,7 +118,12 @@ void BaseContext::performExternalFileReload(const std::vector<SEditorObject>& ob
 	// This is not straightforward to fix since there are also situation where only one of the two handlers 
 	// will be called so we can't just remove one of the calls.
 	for (const auto& object : objects) {
-		object->onAfterContextActivated(*this);
+		const auto& typeName = object->getTypeDescription().typeName;
+		{
+			utils::ScopedPhase phase("onAfterContextActivated", typeName);
+			object->onAfterContextActivated(*this);
+		}
+		utils::ScopedPhase phase("onAfterReferencedObjectChanged", typeName);
 		callReferencedObjectChangedHandlers(object);
 	}
 }
@@ -305,6 +311,56 @@ void BaseContext::set(ValueHandle const& handle, std::array<int, 4> const& value
 	setT(handle, static_cast<StructBase const&>(vecValue));
 }
 
+void BaseContext::setNumericValues(ValueHandle const& handle, std::vector<ValueHandle> const& properties, std::vector<NumericValue> const& values) {
+	assert(properties.size() == values.size());
+
+	auto asInt64 = [](NumericValue const& value) {
+		return std::visit([](auto v) { return static_cast<int64_t>(v); }, value);
+	};
+	auto asDouble = [](NumericValue const& value) {
+		return std::visit([](auto v) { return static_cast<double>(v); }, value);
+	};
+
+	bool changed = false;
+	for (size_t index = 0; index < properties.size(); index++) {
+		const auto& property = properties[index];
+		ValueBase* v = property.valueRef();
+		bool propertyChanged = false;
+		switch (v->type()) {
+			case PrimitiveType::Int:
+				if (auto value = static_cast<int>(asInt64(values[index])); v->asInt() != value) {
+					v->set(value);
+					propertyChanged = true;
+				}
+				break;
+			case PrimitiveType::Int64:
+				if (auto value = asInt64(values[index]); v->asInt64() != value) {
+					v->set(value);
+					propertyChanged = true;
+				}
+				break;
+			case PrimitiveType::Double:
+				if (auto value = asDouble(values[index]); v->asDouble() != value) {
+					v->set(value);
+					propertyChanged = true;
+				}
+				break;
+			default:
+				assert(false);
+		}
+		if (propertyChanged) {
+			handle.object_->onAfterValueChanged(*this, property);
+			changeMultiplexer_.recordValueChanged(property);
+			changed = true;
+		}
+	}
+
+	if (changed) {
+		callReferencedObjectChangedHandlers(handle.object_);
+		changeMultiplexer_.recordValueChanged(handle);
+	}
+}
+
 void BaseContext::set(ValueHandle const& handle, StructBase const& value) {
 	setT(handle, value);
 }
@@ -1391,7 +1447,11 @@ void BaseContext::removeLink(const PropertyDescriptor& end) {
 }
 
 void BaseContext::updateExternalReferences(LoadContext& loadContext, int fileVersion) {
-	ExtrefOperations::updateExternalObjects(*this, project(), *externalProjectsStore(), loadContext, fileVersion);
+	{
+		utils::ScopedPhase phase("load", "updateExternalObjects");
+		ExtrefOperations::updateExternalObjects(*this, project(), *externalProjectsStore(), loadContext, fileVersion);
+	}
+	utils::ScopedPhase phase("load", "globalPrefabUpdate");
 	PrefabOperations::globalPrefabUpdate(*this, true);
 }
 
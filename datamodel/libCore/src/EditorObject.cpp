@@ -65,6 +65,7 @@ EditorObject::ChildIterator EditorObject::end() {
 void EditorObject::onBeforeDeleteObject(BaseContext& context) const {
 	context.errors().removeAll(shared_from_this());
 	uriListeners_.clear();
+	uriWatchedPaths_.clear();
 }
 
 std::pair<uint64_t, uint64_t> EditorObject::objectIDAsRamsesLogicID() const {
@@ -168,6 +169,15 @@ void EditorObject::recreatePropertyFileWatchers(BaseContext& context, const std:
 	for (const auto& path : paths) {
 		uriListeners_[propertyName].emplace(context.meshCache()->registerFileChangedHandler(path, {&context, shared_from_this()}));
 	}
+	uriWatchedPaths_[propertyName] = paths;
+}
+
+std::set<std::string> EditorObject::watchedFilePaths() const {
+	std::set<std::string> result;
+	for (const auto& [propName, paths] : uriWatchedPaths_) {
+		result.insert(paths.begin(), paths.end());
+	}
+	return result;
 }
 
 void EditorObject::onAfterContextActivated(BaseContext& context) {
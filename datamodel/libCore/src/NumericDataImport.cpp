@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/NumericDataImport.h"
+
+#include "utils/FileUtils.h"
+#include "utils/u8path.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace raco::core {
+
+namespace {
+
+bool isSeparator(char c) {
+	return c == ',' || c == ';' || std::isspace(static_cast<unsigned char>(c));
+}
+
+std::vector<NumericValue> parseCsv(const std::string& path) {
+	auto text = utils::file::read(path);
+
+	std::vector<NumericValue> values;
+	const char* current = text.c_str();
+	const char* end = current + text.size();
+	bool lineStart = true;
+	int line = 1;
+	while (current < end) {
+		if (*current == '\n') {
+			++line;
+			lineStart = true;
+			++current;
+		} else if (isSeparator(*current)) {
+			++current;
+		} else if (lineStart && *current == '#') {
+			current = std::find(current, end, '\n');
+		} else {
+			auto isValueEnd = [end](const char* valueEnd) {
+				return valueEnd == end || isSeparator(*valueEnd);
+			};
+
+			// Parse integers separately to keep the full int64_t precision.
+			char* valueEnd = nullptr;
+			errno = 0;
+			long long intValue = std::strtoll(current, &valueEnd, 10);
+			if (valueEnd != current && isValueEnd(valueEnd) && errno == 0) {
+				values.emplace_back(static_cast<int64_t>(intValue));
+			} else {
+				double value = std::strtod(current, &valueEnd);
+				if (valueEnd == current || !isValueEnd(valueEnd)) {
+					throw std::runtime_error(fmt::format("Invalid number in line {} of numeric data file '{}'", line, path));
+				}
+				values.emplace_back(value);
+			}
+			current = valueEnd;
+			lineStart = false;
+		}
+	}
+	return values;
+}
+
+// The binary formats are little-endian which is the byte order of all supported platforms.
+template <typename T, typename ValueType>
+std::vector<NumericValue> parseBinary(const std::string& path) {
+	auto data = utils::file::readBinary(path);
+	if (data.size() % sizeof(T) != 0) {
+		throw std::runtime_error(fmt::format("Size of numeric data file '{}' is not a multiple of the element size {}", path, sizeof(T)));
+	}
+
+	std::vector<NumericValue> values(data.size() / sizeof(T));
+	for (size_t index = 0; index < values.size(); index++) {
+		T value;
+		std::memcpy(&value, data.data() + index * sizeof(T), sizeof(T));
+		values[index] = static_cast<ValueType>(value);
+	}
+	return values;
+}
+
+}  // namespace
+
+NumericDataFormat numericDataFormatFromPath(const std::string& path) {
+	auto extension = utils::u8path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	if (extension == ".csv" || extension == ".txt") {
+		return NumericDataFormat::Csv;
+	} else if (extension == ".f32") {
+		return NumericDataFormat::Float32;
+	} else if (extension == ".f64") {
+		return NumericDataFormat::Float64;
+	} else if (extension == ".i32") {
+		return NumericDataFormat::Int32;
+	} else if (extension == ".i64") {
+		return NumericDataFormat::Int64;
+	}
+	throw std::runtime_error(fmt::format("Unknown numeric data file extension '{}'", extension));
+}
+
+std::vector<NumericValue> readNumericData(const std::string& path, NumericDataFormat format) {
+	if (!utils::u8path(path).existsFile()) {
+		throw std::runtime_error(fmt::format("Numeric data file '{}' not found", path));
+	}
+
+	switch (format) {
+		case NumericDataFormat::Csv:
+			return parseCsv(path);
+		case NumericDataFormat::Float32:
+			return parseBinary<float, double>(path);
+		case NumericDataFormat::Float64:
+			return parseBinary<double, double>(path);
+		case NumericDataFormat::Int32:
+			return parseBinary<int32_t, int64_t>(path);
+		case NumericDataFormat::Int64:
+			return parseBinary<int64_t, int64_t>(path);
+	}
+	return {};
+}
+
+std::vector<NumericValue> readNumericData(const std::string& path) {
+	return readNumericData(path, numericDataFormatFromPath(path));
+}
+
+}  // namespace raco::core
@@ -0,0 +1,320 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ProjectDiff.h"
+
+#include "core/Project.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace raco::core {
+
+namespace {
+
+bool hasSubstructure(const ValueBase& value) {
+	auto type = value.type();
+	return type == PrimitiveType::Table || type == PrimitiveType::Struct || type == PrimitiveType::Array;
+}
+
+bool equalLeafValues(const ValueBase& oldValue, const ValueBase& newValue) {
+	if (oldValue.type() == PrimitiveType::Ref) {
+		// References point into different projects: compare by object ID
+		auto oldRef = oldValue.asRef();
+		auto newRef = newValue.asRef();
+		if (!oldRef || !newRef) {
+			return !oldRef && !newRef;
+		}
+		return oldRef->objectID() == newRef->objectID();
+	}
+	return oldValue == newValue;
+}
+
+std::vector<SEditorObject> sortedByObjectID(const std::vector<SEditorObject>& instances) {
+	std::vector<SEditorObject> result(instances);
+	std::sort(result.begin(), result.end(), [](const SEditorObject& left, const SEditorObject& right) {
+		return left->objectID() < right->objectID();
+	});
+	return result;
+}
+
+std::vector<SLink> sortedLinks(const LinkContainer& links) {
+	std::vector<SLink> result(links.begin(), links.end());
+	std::sort(result.begin(), result.end(), [](const SLink& left, const SLink& right) {
+		return LinkDescriptor::lessThanByObjectID(left->descriptor(), right->descriptor());
+	});
+	return result;
+}
+
+class ProjectDiffer {
+public:
+	ProjectDiffer(ProjectDiffSink& sink, ProjectDiffStatistics& statistics) : sink_(sink), statistics_(statistics) {
+	}
+
+	// @return true if any difference was found.
+	bool diffObject(const SEditorObject& oldObject, const SEditorObject& newObject) {
+		oldObject_ = oldObject;
+		newObject_ = newObject;
+		path_.clear();
+		return diffStructure(*oldObject, *newObject);
+	}
+
+private:
+	bool diffStructure(const ReflectionInterface& oldStructure, const ReflectionInterface& newStructure) {
+		bool changed = false;
+		std::vector<bool> matched(newStructure.size(), false);
+
+		for (size_t oldIndex = 0; oldIndex < oldStructure.size(); oldIndex++) {
+			const auto& name = oldStructure.name(oldIndex);
+			path_.emplace_back(name.empty() ? std::to_string(oldIndex) : name);
+
+			// Fast path: unchanged property order; fall back to the name lookup otherwise.
+			// Unnamed table entries are matched by index.
+			int newIndex = -1;
+			if (oldIndex < newStructure.size() && newStructure.name(oldIndex) == name) {
+				newIndex = static_cast<int>(oldIndex);
+			} else if (!name.empty()) {
+				newIndex = newStructure.index(name);
+			}
+
+			if (newIndex >= 0 && !matched[newIndex]) {
+				matched[newIndex] = true;
+				changed = diffValue(*oldStructure.get(oldIndex), *newStructure.get(newIndex)) || changed;
+			} else {
+				++statistics_.removedProperties;
+				sink_.propertyRemoved(oldObject_, path_, *oldStructure.get(oldIndex));
+				changed = true;
+			}
+			path_.pop_back();
+		}
+
+		for (size_t newIndex = 0; newIndex < newStructure.size(); newIndex++) {
+			if (!matched[newIndex]) {
+				const auto& name = newStructure.name(newIndex);
+				path_.emplace_back(name.empty() ? std::to_string(newIndex) : name);
+				++statistics_.addedProperties;
+				sink_.propertyAdded(newObject_, path_, *newStructure.get(newIndex));
+				changed = true;
+				path_.pop_back();
+			}
+		}
+		return changed;
+	}
+
+	bool diffValue(const ValueBase& oldValue, const ValueBase& newValue) {
+		if (oldValue.type() != newValue.type() || oldValue.baseTypeName() != newValue.baseTypeName()) {
+			++statistics_.changedProperties;
+			sink_.propertyChanged(newObject_, path_, oldValue, newValue);
+			return true;
+		}
+		if (hasSubstructure(oldValue)) {
+			return diffStructure(oldValue.getSubstructure(), newValue.getSubstructure());
+		}
+		if (!equalLeafValues(oldValue, newValue)) {
+			++statistics_.changedProperties;
+			sink_.propertyChanged(newObject_, path_, oldValue, newValue);
+			return true;
+		}
+		return false;
+	}
+
+	ProjectDiffSink& sink_;
+	ProjectDiffStatistics& statistics_;
+
+	SEditorObject oldObject_;
+	SEditorObject newObject_;
+	std::vector<std::string> path_;
+};
+
+QString joinPath(const std::vector<std::string>& path) {
+	std::string result;
+	for (const auto& name : path) {
+		if (!result.empty()) {
+			result += ".";
+		}
+		result += name;
+	}
+	return QString::fromStdString(result);
+}
+
+QJsonValue valueToJson(const ValueBase& value) {
+	switch (value.type()) {
+		case PrimitiveType::Bool:
+			return value.asBool();
+		case PrimitiveType::Int:
+			return value.asInt();
+		case PrimitiveType::Int64:
+			return static_cast<qint64>(value.asInt64());
+		case PrimitiveType::Double:
+			return value.asDouble();
+		case PrimitiveType::String:
+			return QString::fromStdString(value.asString());
+		case PrimitiveType::Ref: {
+			auto ref = value.asRef();
+			return ref ? QJsonValue(QString::fromStdString(ref->objectID())) : QJsonValue();
+		}
+		default:
+			// Only the type is reported for complex values; changes inside are reported for the leaf properties.
+			return QJsonObject{{"type", QString::fromStdString(value.baseTypeName())}};
+	}
+}
+
+QString linkEndpoint(const PropertyDescriptor& property) {
+	return QString::fromStdString(property.getPropertyPath(true));
+}
+
+QJsonObject objectRecord(const char* op, const SEditorObject& object) {
+	return QJsonObject{
+		{"op", op},
+		{"kind", "object"},
+		{"id", QString::fromStdString(object->objectID())},
+		{"type", QString::fromStdString(object->getTypeDescription().typeName)},
+		{"name", QString::fromStdString(object->objectName())}};
+}
+
+QJsonObject propertyRecord(const char* op, const SEditorObject& object, const std::vector<std::string>& path) {
+	return QJsonObject{
+		{"op", op},
+		{"kind", "property"},
+		{"id", QString::fromStdString(object->objectID())},
+		{"path", joinPath(path)}};
+}
+
+QJsonObject linkRecord(const char* op, const SLink& link) {
+	auto desc = link->descriptor();
+	return QJsonObject{
+		{"op", op},
+		{"kind", "link"},
+		{"start", linkEndpoint(desc.start)},
+		{"end", linkEndpoint(desc.end)},
+		{"valid", desc.isValid},
+		{"weak", desc.isWeak}};
+}
+
+void writeRecord(std::ostream& stream, const QJsonObject& record) {
+	stream << QJsonDocument(record).toJson(QJsonDocument::Compact).toStdString() << '\n';
+}
+
+}  // namespace
+
+bool ProjectDiffStatistics::empty() const {
+	return addedObjects == 0 && removedObjects == 0 && changedObjects == 0 &&
+		   addedProperties == 0 && removedProperties == 0 && changedProperties == 0 &&
+		   addedLinks == 0 && removedLinks == 0 && changedLinks == 0;
+}
+
+ProjectDiffStatistics diffProjects(const Project& oldProject, const Project& newProject, ProjectDiffSink& sink) {
+	ProjectDiffStatistics statistics;
+
+	// Objects: merge join over the instances sorted by object ID
+	{
+		auto oldInstances = sortedByObjectID(oldProject.instances());
+		auto newInstances = sortedByObjectID(newProject.instances());
+		ProjectDiffer differ(sink, statistics);
+
+		auto oldIt = oldInstances.begin();
+		auto newIt = newInstances.begin();
+		while (oldIt != oldInstances.end() || newIt != newInstances.end()) {
+			if (newIt == newInstances.end() || (oldIt != oldInstances.end() && (*oldIt)->objectID() < (*newIt)->objectID())) {
+				++statistics.removedObjects;
+				sink.objectRemoved(*oldIt++);
+			} else if (oldIt == oldInstances.end() || (*newIt)->objectID() < (*oldIt)->objectID()) {
+				++statistics.addedObjects;
+				sink.objectAdded(*newIt++);
+			} else {
+				if ((*oldIt)->getTypeDescription().typeName != (*newIt)->getTypeDescription().typeName) {
+					++statistics.removedObjects;
+					sink.objectRemoved(*oldIt);
+					++statistics.addedObjects;
+					sink.objectAdded(*newIt);
+				} else if (differ.diffObject(*oldIt, *newIt)) {
+					++statistics.changedObjects;
+				}
+				++oldIt;
+				++newIt;
+			}
+		}
+	}
+
+	// Links: merge join over the links sorted by start and end property
+	{
+		auto oldLinks = sortedLinks(oldProject.links());
+		auto newLinks = sortedLinks(newProject.links());
+
+		auto oldIt = oldLinks.begin();
+		auto newIt = newLinks.begin();
+		while (oldIt != oldLinks.end() || newIt != newLinks.end()) {
+			if (newIt == newLinks.end() || (oldIt != oldLinks.end() && LinkDescriptor::lessThanByObjectID((*oldIt)->descriptor(), (*newIt)->descriptor()))) {
+				++statistics.removedLinks;
+				sink.linkRemoved(*oldIt++);
+			} else if (oldIt == oldLinks.end() || LinkDescriptor::lessThanByObjectID((*newIt)->descriptor(), (*oldIt)->descriptor())) {
+				++statistics.addedLinks;
+				sink.linkAdded(*newIt++);
+			} else {
+				if (*(*oldIt)->isValid_ != *(*newIt)->isValid_ || *(*oldIt)->isWeak_ != *(*newIt)->isWeak_) {
+					++statistics.changedLinks;
+					sink.linkChanged(*oldIt, *newIt);
+				}
+				++oldIt;
+				++newIt;
+			}
+		}
+	}
+
+	return statistics;
+}
+
+ProjectDiffJsonWriter::ProjectDiffJsonWriter(std::ostream& stream) : stream_(stream) {
+}
+
+void ProjectDiffJsonWriter::objectAdded(const SEditorObject& newObject) {
+	writeRecord(stream_, objectRecord("add", newObject));
+}
+
+void ProjectDiffJsonWriter::objectRemoved(const SEditorObject& oldObject) {
+	writeRecord(stream_, objectRecord("remove", oldObject));
+}
+
+void ProjectDiffJsonWriter::propertyAdded(const SEditorObject& newObject, const std::vector<std::string>& path, const ValueBase& newValue) {
+	auto record = propertyRecord("add", newObject, path);
+	record.insert("new", valueToJson(newValue));
+	writeRecord(stream_, record);
+}
+
+void ProjectDiffJsonWriter::propertyRemoved(const SEditorObject& oldObject, const std::vector<std::string>& path, const ValueBase& oldValue) {
+	auto record = propertyRecord("remove", oldObject, path);
+	record.insert("old", valueToJson(oldValue));
+	writeRecord(stream_, record);
+}
+
+void ProjectDiffJsonWriter::propertyChanged(const SEditorObject& newObject, const std::vector<std::string>& path, const ValueBase& oldValue, const ValueBase& newValue) {
+	auto record = propertyRecord("change", newObject, path);
+	record.insert("old", valueToJson(oldValue));
+	record.insert("new", valueToJson(newValue));
+	writeRecord(stream_, record);
+}
+
+void ProjectDiffJsonWriter::linkAdded(const SLink& newLink) {
+	writeRecord(stream_, linkRecord("add", newLink));
+}
+
+void ProjectDiffJsonWriter::linkRemoved(const SLink& oldLink) {
+	writeRecord(stream_, linkRecord("remove", oldLink));
+}
+
+void ProjectDiffJsonWriter::linkChanged(const SLink& oldLink, const SLink& newLink) {
+	auto record = linkRecord("change", newLink);
+	record.insert("oldValid", *oldLink->isValid_);
+	record.insert("oldWeak", *oldLink->isWeak_);
+	writeRecord(stream_, record);
+}
+
+}  // namespace raco::core
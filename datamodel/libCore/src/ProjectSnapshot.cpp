@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ProjectSnapshot.h"
+
+#include "core/Context.h"
+#include "core/Link.h"
+#include "core/Undo.h"
+#include "core/UserObjectFactoryInterface.h"
+
+namespace raco::core {
+
+ProjectSnapshot::ProjectSnapshot(size_t generation) : generation_(generation) {
+}
+
+const Project& ProjectSnapshot::project() const {
+	return project_;
+}
+
+size_t ProjectSnapshot::generation() const {
+	return generation_;
+}
+
+SEditorObject ProjectSnapshot::parent(const SEditorObject& object) const {
+	std::call_once(parentMapFlag_, [this]() {
+		for (const auto& candidate : project_.instances()) {
+			for (auto child : *candidate) {
+				if (child) {
+					parentMap_[child->objectID()] = candidate;
+				}
+			}
+		}
+	});
+	auto it = parentMap_.find(object->objectID());
+	if (it != parentMap_.end()) {
+		return it->second;
+	}
+	return nullptr;
+}
+
+size_t ProjectSnapshot::copiedObjects() const {
+	return copiedObjects_;
+}
+
+size_t ProjectSnapshot::sharedObjects() const {
+	return sharedObjects_;
+}
+
+ProjectSnapshotter::ProjectSnapshotter(BaseContext* context) : context_(context) {
+	context_->changeMultiplexer().addRecorder(&changes_);
+}
+
+ProjectSnapshotter::~ProjectSnapshotter() {
+	context_->changeMultiplexer().removeRecorder(&changes_);
+}
+
+SProjectSnapshot ProjectSnapshotter::latest() const {
+	std::lock_guard<std::mutex> lock(latestMutex_);
+	return latest_;
+}
+
+bool ProjectSnapshotter::hasChanges() const {
+	const auto* src = context_->project();
+	return !changes_.getCreatedObjects().empty() ||
+		   !changes_.getDeletedObjects().empty() ||
+		   !changes_.getChangedValues().empty() ||
+		   !changes_.getAddedLinks().empty() ||
+		   !changes_.getValidityChangedLinks().empty() ||
+		   !changes_.getRemovedLinks().empty() ||
+		   changes_.externalProjectMapChanged() ||
+		   changes_.rootOrderChanged() ||
+		   src->currentPath() != latest_->project().currentPath() ||
+		   src->currentFolder() != latest_->project().currentFolder() ||
+		   src->featureLevel() != latest_->project().featureLevel();
+}
+
+SProjectSnapshot ProjectSnapshotter::takeSnapshot() {
+	// latest_ is only written by this function, so reading it without the lock is safe here.
+	if (latest_ && !hasChanges()) {
+		return latest_;
+	}
+
+	const auto* src = context_->project();
+	const Project* ref = latest_ ? &latest_->project() : nullptr;
+	auto& factory = *context_->objectFactory();
+
+	// Objects which need to be copied: the changed objects and transitively all objects referencing a copied object.
+	// The referencing objects are found using the back pointers of the live project.
+	SEditorObjectSet copiedObjects;
+	if (ref) {
+		std::vector<SEditorObject> stack;
+		for (const auto& object : changes_.getAllChangedObjects()) {
+			if (src->getInstanceByID(object->objectID()) == object && copiedObjects.insert(object).second) {
+				stack.emplace_back(object);
+			}
+		}
+		while (!stack.empty()) {
+			auto object = stack.back();
+			stack.pop_back();
+			for (const auto& weakReferencing : object->referencesToThis()) {
+				auto referencing = weakReferencing.lock();
+				if (referencing && src->isInstance(referencing) && copiedObjects.insert(referencing).second) {
+					stack.emplace_back(referencing);
+				}
+			}
+		}
+	} else {
+		copiedObjects.insert(src->instances().begin(), src->instances().end());
+	}
+
+	std::shared_ptr<ProjectSnapshot> snapshot(new ProjectSnapshot(latest_ ? latest_->generation() + 1 : 1));
+	auto* dest = &snapshot->project_;
+
+	for (const auto& srcObj : src->instances()) {
+		SEditorObject refObj;
+		if (ref && copiedObjects.find(srcObj) == copiedObjects.end()) {
+			refObj = ref->getInstanceByID(srcObj->objectID());
+		}
+		if (refObj) {
+			dest->addInstance(refObj);
+			++snapshot->sharedObjects_;
+		} else {
+			dest->addInstance(factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID()));
+			copiedObjects.insert(srcObj);
+			++snapshot->copiedObjects_;
+		}
+	}
+
+	auto translateRef = [dest](SEditorObject srcObj) -> SEditorObject {
+		if (srcObj) {
+			return dest->getInstanceByID(srcObj->objectID());
+		}
+		return nullptr;
+	};
+
+	// Handlers are not invoked: they would update the back pointers of the shared objects which may be read concurrently.
+	for (const auto& srcObj : copiedObjects) {
+		UndoHelpers::updateEditorObject(
+			srcObj.get(), translateRef(srcObj), translateRef, [](const std::string&) { return false; }, factory, nullptr, false);
+	}
+
+	for (const auto& srcLink : src->links()) {
+		SLink refLink;
+		if (ref && !changes_.isLinkAdded(srcLink) && !changes_.isLinkValidityChanged(srcLink) &&
+			copiedObjects.find(*srcLink->startObject_) == copiedObjects.end() &&
+			copiedObjects.find(*srcLink->endObject_) == copiedObjects.end()) {
+			refLink = ref->findLinkByObjectID(srcLink);
+		}
+		dest->addLink(refLink ? refLink : Link::cloneLinkWithTranslation(srcLink, translateRef));
+	}
+
+	dest->replaceExternalProjectsMappings(src->externalProjectsMap());
+	// The current path of a new project is empty; the project folder is still needed to resolve relative URIs.
+	dest->setCurrentPath(src->currentPath().empty() ? src->currentFolder() : src->currentPath());
+	dest->setFeatureLevel(src->featureLevel());
+
+	changes_.reset();
+	{
+		std::lock_guard<std::mutex> lock(latestMutex_);
+		latest_ = snapshot;
+	}
+	return latest_;
+}
+
+}  // namespace raco::core
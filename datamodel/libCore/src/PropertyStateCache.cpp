@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/PropertyStateCache.h"
+
+#include "core/ChangeRecorder.h"
+#include "core/CoreAnnotations.h"
+#include "core/PrefabOperations.h"
+#include "core/Project.h"
+#include "core/Queries.h"
+#include "user_types/BaseCamera.h"
+#include "user_types/MeshNode.h"
+#include "user_types/Node.h"
+#include "user_types/RenderLayer.h"
+#include "user_types/Texture.h"
+
+#include <algorithm>
+#include <set>
+
+namespace raco::core {
+
+struct PropertyStateCache::ObjectContext {
+	const Project& project;
+	// Result of Queries::isReadOnly(object)
+	bool objectReadOnly = false;
+	bool insidePrefabInstance = false;
+	bool interfaceObject = false;
+	bool isCamera = false;
+	// All descendants of these properties belong to non-private material slots.
+	std::vector<ValueHandle> lockedMaterialContainers;
+	// All descendants of these properties are read-only because of the render layer sort order.
+	std::vector<ValueHandle> lockedRenderLayerTags;
+	// Property paths of the links ending on the object
+	std::set<std::vector<std::string>> linkedProperties;
+};
+
+namespace {
+
+// Same conditions as Queries::isHiddenInPropertyBrowser with the material slot membership passed in.
+bool isHidden(const Project& project, const ValueHandle& handle, const ValueBase* value, bool isCamera, bool inLockedMaterialSlot, bool isMultiSelect) {
+	if (!isMultiSelect && handle.depth() == 1 && handle.isRefToProp(&user_types::Texture::preview_)) {
+		return false;
+	}
+	if (value->query<UserTagContainerAnnotation>() || value->query<TagContainerAnnotation>() || value->query<RenderableTagContainerAnnotation>()) {
+		return false;
+	}
+	if (value->query<HiddenProperty>()) {
+		return true;
+	}
+	if (auto anno = value->query<FeatureLevel>(); anno && project.featureLevel() < *anno->featureLevel_) {
+		return true;
+	}
+	if (inLockedMaterialSlot) {
+		return true;
+	}
+	if (isCamera && handle.depth() == 1 && handle.isRefToProp(&user_types::Node::tags_)) {
+		return true;
+	}
+	return false;
+}
+
+}  // namespace
+
+void PropertyStateCache::evaluateChildren(const ObjectContext& context, const ValueHandle& parent, const ReflectionInterface& container, std::vector<std::string>& propertyPath,
+	bool parentReadOnly, bool inLockedMaterialSlot, bool inLockedRenderLayerTags, bool interfaceProperty, ObjectStates& outStates) {
+	for (size_t index = 0; index < container.size(); index++) {
+		const ValueBase* value = container.get(index);
+		ValueHandle handle = parent[index];
+		propertyPath.emplace_back(container.name(index));
+
+		bool isInterfaceProperty = parent.depth() == 0 ? context.interfaceObject && propertyPath.front() == "inputs" : interfaceProperty;
+
+		// Conditions of Queries::isReadOnly which only depend on the property itself and the object
+		bool localReadOnly = value->query<ReadOnlyAnnotation>() ||
+							 (context.insidePrefabInstance && !isInterfaceProperty) ||
+							 inLockedMaterialSlot ||
+							 inLockedRenderLayerTags ||
+							 (value->query<LinkStartAnnotation>() && !value->query<LinkEndAnnotation>());
+		bool linked = context.linkedProperties.find(propertyPath) != context.linkedProperties.end();
+
+		PropertyState state;
+		state.linkStateReadOnly = context.objectReadOnly || parentReadOnly || localReadOnly;
+		state.readOnly = state.linkStateReadOnly || linked;
+		state.hidden = isHidden(context.project, handle, value, context.isCamera, inLockedMaterialSlot, false);
+		state.hiddenMultiSelect = isHidden(context.project, handle, value, context.isCamera, inLockedMaterialSlot, true);
+		outStates[handle] = state;
+
+		if (hasTypeSubstructure(value->type())) {
+			bool childrenInLockedMaterialSlot = inLockedMaterialSlot ||
+				std::find(context.lockedMaterialContainers.begin(), context.lockedMaterialContainers.end(), handle) != context.lockedMaterialContainers.end();
+			bool childrenInLockedRenderLayerTags = inLockedRenderLayerTags ||
+				std::find(context.lockedRenderLayerTags.begin(), context.lockedRenderLayerTags.end(), handle) != context.lockedRenderLayerTags.end();
+			// A linked parent makes all children read-only, see Queries::currentLinkState
+			evaluateChildren(context, handle, value->getSubstructure(), propertyPath, parentReadOnly || localReadOnly || linked,
+				childrenInLockedMaterialSlot, childrenInLockedRenderLayerTags, isInterfaceProperty, outStates);
+		}
+
+		propertyPath.pop_back();
+	}
+}
+
+PropertyStateCache::ObjectStates PropertyStateCache::evaluate(const Project& project, const SEditorObject& object) {
+	ObjectContext context{project};
+	context.objectReadOnly = Queries::isReadOnly(object);
+	context.insidePrefabInstance = PrefabOperations::findContainingPrefabInstance(object->getParent()) != nullptr;
+	context.interfaceObject = PrefabOperations::isInterfaceObject(object);
+	context.isCamera = object->as<user_types::BaseCamera>() != nullptr;
+
+	if (auto meshnode = object->as<user_types::MeshNode>()) {
+		for (size_t matIndex = 0; matIndex < meshnode->numMaterialSlots(); matIndex++) {
+			if (!meshnode->materialPrivate(matIndex)) {
+				context.lockedMaterialContainers.emplace_back(meshnode->getMaterialOptionsHandle(matIndex));
+				context.lockedMaterialContainers.emplace_back(meshnode->getUniformContainerHandle(matIndex));
+			}
+		}
+	}
+
+	if (auto renderlayer = object->as<user_types::RenderLayer>()) {
+		if (*renderlayer->sortOrder_ == static_cast<int>(user_types::ERenderLayerOrder::SceneGraph)) {
+			context.lockedRenderLayerTags.emplace_back(ValueHandle(renderlayer, &user_types::RenderLayer::renderableTags_));
+		}
+	}
+
+	const auto& linkEndPoints = project.linkEndPoints();
+	if (auto it = linkEndPoints.find(object->objectID()); it != linkEndPoints.end()) {
+		for (const auto& link : it->second) {
+			context.linkedProperties.insert(link->endPropertyNamesVector());
+		}
+	}
+
+	ObjectStates states;
+	std::vector<std::string> propertyPath;
+	evaluateChildren(context, ValueHandle(object), *object, propertyPath, false, false, false, false, states);
+	return states;
+}
+
+const PropertyStateCache::PropertyState* PropertyStateCache::findState(const Project& project, const ValueHandle& handle) {
+	if (!handle || handle.depth() == 0) {
+		return nullptr;
+	}
+
+	auto object = handle.rootObject();
+	auto it = objectStates_.find(object);
+	if (it == objectStates_.end()) {
+		it = objectStates_.emplace(object, evaluate(project, object)).first;
+	}
+	auto stateIt = it->second.find(handle);
+	if (stateIt == it->second.end()) {
+		// Property was added after the evaluation without the cache being invalidated yet.
+		it->second = evaluate(project, object);
+		stateIt = it->second.find(handle);
+		if (stateIt == it->second.end()) {
+			return nullptr;
+		}
+	}
+	return &stateIt->second;
+}
+
+bool PropertyStateCache::isReadOnly(const Project& project, const ValueHandle& handle, bool linkState) {
+	if (auto state = findState(project, handle)) {
+		return (linkState ? state->linkStateReadOnly : state->readOnly) || project.isCodeCtrldObj(handle.rootObject());
+	}
+	return Queries::isReadOnly(project, handle, linkState);
+}
+
+bool PropertyStateCache::isHiddenInPropertyBrowser(const Project& project, const ValueHandle& handle, bool isMultiSelect) {
+	if (auto state = findState(project, handle)) {
+		return isMultiSelect ? state->hiddenMultiSelect : state->hidden;
+	}
+	return Queries::isHiddenInPropertyBrowser(project, handle, isMultiSelect);
+}
+
+void PropertyStateCache::invalidate(const DataChangeRecorder& changes) {
+	if (objectStates_.empty()) {
+		return;
+	}
+
+	if (!changes.getCreatedObjects().empty() || !changes.getDeletedObjects().empty()) {
+		clear();
+		return;
+	}
+	for (const auto& [objectID, handles] : changes.getChangedValues()) {
+		for (const auto& handle : handles) {
+			// Parent changes can move entire subtrees into or out of prefab instances.
+			if (handle.isRefToProp(&EditorObject::children_)) {
+				clear();
+				return;
+			}
+		}
+	}
+
+	// Includes the end objects of added, removed and validity-changed links.
+	for (const auto& object : changes.getAllChangedObjects(false, false, true)) {
+		invalidate(object);
+	}
+}
+
+void PropertyStateCache::invalidate(const SEditorObject& object) {
+	objectStates_.erase(object);
+}
+
+void PropertyStateCache::clear() {
+	objectStates_.clear();
+}
+
+}  // namespace raco::core
@@ -245,10 +245,14 @@ bool Queries::isValidReferenceTarget(Project const& project, const ValueHandle&
 }
 
 std::vector<SEditorObject> Queries::findAllValidReferenceTargets(Project const& project, const ValueHandle& handle) {
+	return findValidReferenceTargets(project, handle, project.instances());
+}
+
+std::vector<SEditorObject> Queries::findValidReferenceTargets(Project const& project, const ValueHandle& handle, const std::vector<SEditorObject>& candidates) {
 	auto predicate = ValidReferenceTargetPredicate(project, handle);
 
 	std::vector<SEditorObject> result;
-	std::copy_if(project.instances().begin(), project.instances().end(), std::back_inserter(result), [&predicate](SEditorObject object) {
+	std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(result), [&predicate](SEditorObject object) {
 		return predicate.isValidTarget(object);
 	});
 	return result;
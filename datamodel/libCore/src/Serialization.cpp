@@ -23,6 +23,7 @@
 #include "core/CommandInterface.h"
 #include "data_storage/Table.h"
 #include "log_system/log.h"
+#include "utils/PhaseTracer.h"
 #include "utils/u8path.h"
 
 #include <QJsonArray>
@@ -533,6 +534,26 @@ SReflectionInterface deserializeTypedObject(const QJsonObject& jsonObject, core:
 	return deserializeTypedObject(jsonObject, factory, references, makeUserTypePropertyMap(factory), makeStructPropertyMap());
 }
 
+/**
+ * Resolve the object IDs collected in `references` during deserialization into pointers to the deserialized `objects`.
+ */
+template <class SharedPtrEditorObjectType>
+void restoreReferences(const std::vector<SharedPtrEditorObjectType>& objects, const References& references) {
+	std::map<std::string, core::SEditorObject> instanceMap;
+	for (const auto& d : objects) {
+		auto obj = std::dynamic_pointer_cast<core::EditorObject>(d);
+		instanceMap[obj->objectID()] = obj;
+	}
+	for (const auto& pair : references) {
+		auto it = instanceMap.find(pair.second);
+		if (it != instanceMap.end()) {
+			*pair.first = it->second;
+		} else {
+			LOG_WARNING(log_system::DESERIALIZATION, "Load: referenced object not found: {}", pair.second);
+		}
+	}
+}
+
 using translateRefFunc = std::function<core::SEditorObject(core::SEditorObject)>;
 
 void convertObjectPropertiesIRToUser(const ReflectionInterface& dynObj, ReflectionInterface& userObj, translateRefFunc translateRef,  core::UserObjectFactoryInterface& factory);
@@ -947,7 +968,12 @@ ProjectVersionInfo deserializeProjectVersionInfo(const QJsonDocument& document)
 }
 
 ProjectDeserializationInfoIR deserializeProjectToIR(const QJsonDocument& document, const std::string& filename) {
-	auto migratedJson{raco::serializationToV23::migrateProjectToV23(document)};
+	utils::ScopedPhase phase("load", "deserializeProjectToIR");
+	QJsonDocument migratedJson;
+	{
+		utils::ScopedPhase migrationPhase("load", "migrateProjectToV23");
+		migratedJson = raco::serializationToV23::migrateProjectToV23(document);
+	}
 
 	auto& factory{serialization::proxy::ProxyObjectFactory::getInstance()};
 
@@ -976,19 +1002,7 @@ ProjectDeserializationInfoIR deserializeProjectToIR(const QJsonDocument& documen
 		deserializedProjectInfo.links.push_back(link);
 	}
 
-	// Restore references
-	std::map<std::string, core::SEditorObject> instanceMap;
-	for (auto& d : deserializedProjectInfo.objects) {
-		auto obj = std::dynamic_pointer_cast<core::EditorObject>(d);
-		instanceMap[obj->objectID()] = obj;
-	}
-	for (const auto& pair : references) {
-		if (instanceMap.find(pair.second) != instanceMap.end()) {
-			*pair.first = instanceMap.at(pair.second);
-		} else {
-			LOG_WARNING(log_system::DESERIALIZATION, "Load: referenced object not found: {}", pair.second);
-		}
-	}
+	restoreReferences(deserializedProjectInfo.objects, references);
 
 	for (const auto& obj : deserializedProjectInfo.objects) {
 		auto dynObj = std::dynamic_pointer_cast<serialization::proxy::DynamicEditorObject>(obj);
@@ -1000,15 +1014,71 @@ ProjectDeserializationInfoIR deserializeProjectToIR(const QJsonDocument& documen
 	return deserializedProjectInfo;
 }
 
-ProjectDeserializationInfo deserializeProject(const QJsonDocument& document, const std::string& filename) {
-	try {
-		auto deserializedIR{deserializeProjectToIR(document, filename)};
-		
-		// run new migration code
-		auto& factory{serialization::proxy::ProxyObjectFactory::getInstance()};
+ProjectDeserializationInfo deserializeProjectWithMigration(const QJsonDocument& document, const std::string& filename) {
+	auto deserializedIR{deserializeProjectToIR(document, filename)};
+
+	// run new migration code
+	auto& factory{serialization::proxy::ProxyObjectFactory::getInstance()};
+	{
+		utils::ScopedPhase phase("load", "migrateProject");
 		migrateProject(deserializedIR, factory);
+	}
 
-		return ConvertFromIRToUserTypes(deserializedIR);
+	utils::ScopedPhase phase("load", "ConvertFromIRToUserTypes");
+	auto result = ConvertFromIRToUserTypes(deserializedIR);
+	result.fileVersion = deserializedIR.fileVersion;
+	result.currentPath = deserializedIR.currentPath;
+	return result;
+}
+
+ProjectDeserializationInfo deserializeProjectToUserTypes(const QJsonDocument& document, const std::string& filename) {
+	assert(deserializeFileVersion(document) == RAMSES_PROJECT_FILE_VERSION);
+	utils::ScopedPhase phase("load", "deserializeProjectToUserTypes");
+
+	auto& factory{user_types::UserObjectFactory::getInstance()};
+
+	ProjectDeserializationInfo deserializedProjectInfo;
+
+	deserializedProjectInfo.versionInfo = deserializeProjectVersionInfo(document);
+	deserializedProjectInfo.fileVersion = document.object()[keys::FILE_VERSION].toInt();
+
+	deserializeExternalProjectsMap(document[keys::EXTERNAL_PROJECTS].toVariant(), deserializedProjectInfo.externalProjectsMap);
+
+	// The type maps stored in a file with the current file version are identical to the ones generated from
+	// the current user types (see the MigrationTest.check_current_type_maps test) so we don't need to parse them.
+	auto userPropTypeMap = makeUserTypePropertyMap(factory);
+	auto structTypeMap = makeStructPropertyMap();
+
+	References references;
+
+	const auto instances = document[keys::INSTANCES].toArray();
+	deserializedProjectInfo.objects.reserve(instances.size());
+	for (const auto& instance : instances) {
+		auto obj = std::dynamic_pointer_cast<core::EditorObject>(deserializeTypedObject(instance.toObject(), factory, references, userPropTypeMap, structTypeMap));
+		deserializedProjectInfo.objects.push_back(obj);
+	}
+	const auto links = document[keys::LINKS].toArray();
+	deserializedProjectInfo.links.reserve(links.size());
+	for (const auto& linkJson : links) {
+		auto link = std::dynamic_pointer_cast<core::Link>(deserializeTypedObject(linkJson.toObject(), factory, references, userPropTypeMap, structTypeMap));
+		deserializedProjectInfo.links.push_back(link);
+	}
+
+	restoreReferences(deserializedProjectInfo.objects, references);
+
+	deserializedProjectInfo.currentPath = filename;
+
+	return deserializedProjectInfo;
+}
+
+ProjectDeserializationInfo deserializeProject(const QJsonDocument& document, const std::string& filename) {
+	try {
+		// Files at the current version don't need any migration: skip the intermediate proxy object graph
+		// and deserialize directly into the user types.
+		if (deserializeFileVersion(document) == RAMSES_PROJECT_FILE_VERSION) {
+			return deserializeProjectToUserTypes(document, filename);
+		}
+		return deserializeProjectWithMigration(document, filename);
 	} catch (std::exception&) {
 		throw std::runtime_error(fmt::format("Project file format invalid."));
 	}
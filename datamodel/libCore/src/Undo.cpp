@@ -22,7 +22,11 @@
 #include "data_storage/Value.h"
 #include "data_storage/Array.h"
 
+#include <algorithm>
 #include <cassert>
+#include <future>
+#include <set>
+#include <thread>
 
 namespace raco::core {
 
@@ -243,6 +247,95 @@ void UndoHelpers::updateEditorObject(const EditorObject *src, SEditorObject dest
 	}
 }
 
+bool UndoHelpers::areAnnotationsEqual(const std::vector<AnnotationBase *> &src, const std::vector<AnnotationBase *> &dest, translateRefFunc translateRef) {
+	if (src.size() != dest.size()) {
+		return false;
+	}
+	for (size_t index = 0; index < src.size(); index++) {
+		if (!ReflectionInterface::compare(*src[index], *dest[index], translateRef)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UndoHelpers::isValueEqual(const ValueBase *src, const ValueBase *dest, translateRefFunc translateRef) {
+	if (!src->compare(*dest, translateRef) || !areAnnotationsEqual(src->baseAnnotationPtrs(), dest->baseAnnotationPtrs(), translateRef)) {
+		return false;
+	}
+	if (hasTypeSubstructure(src->type())) {
+		// The compare above already ensures that the number, names and classes of the child properties match.
+		const auto &srcChildren = src->getSubstructure();
+		const auto &destChildren = dest->getSubstructure();
+		for (size_t index = 0; index < srcChildren.size(); index++) {
+			if (!isValueEqual(srcChildren.get(index), destChildren.get(index), translateRef)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool UndoHelpers::areObjectAnnotationsEqual(const EditorObject *src, const EditorObject *dest, translateRefFunc translateRef) {
+	if (src->annotations().size() != dest->annotations().size()) {
+		return false;
+	}
+	for (const auto &srcAnno : src->annotations()) {
+		auto destAnno = dest->query(srcAnno->serializationTypeName());
+		if (!destAnno || !ReflectionInterface::compare(*srcAnno, *destAnno, translateRef)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+namespace {
+
+// Differences between an object in the undo stack snapshot and the corresponding object in the project.
+struct ObjectDelta {
+	bool annotationsChanged = false;
+	std::set<std::string> changedProperties;
+
+	bool empty() const {
+		return !annotationsChanged && changedProperties.empty();
+	}
+};
+
+ObjectDelta computeObjectDelta(const EditorObject *src, const EditorObject *dest, translateRefFunc translateRef) {
+	ObjectDelta delta;
+	delta.annotationsChanged = !UndoHelpers::areObjectAnnotationsEqual(src, dest, translateRef);
+	for (size_t index = 0; index < src->size(); index++) {
+		if (!UndoHelpers::isValueEqual(src->get(index), dest->get(index), translateRef)) {
+			delta.changedProperties.insert(src->name(index));
+		}
+	}
+	return delta;
+}
+
+// Compute the object deltas using multiple threads. Computing a delta only reads the objects, so the objects
+// can be distributed over the threads arbitrarily.
+std::vector<ObjectDelta> computeObjectDeltas(const std::vector<std::pair<const EditorObject *, const EditorObject *>> &objects, translateRefFunc translateRef) {
+	std::vector<ObjectDelta> deltas(objects.size());
+	size_t numThreads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), objects.size()));
+	size_t chunkSize = (objects.size() + numThreads - 1) / numThreads;
+
+	std::vector<std::future<void>> tasks;
+	for (size_t begin = 0; begin < objects.size(); begin += chunkSize) {
+		size_t end = std::min(begin + chunkSize, objects.size());
+		tasks.emplace_back(std::async(std::launch::async, [&objects, &deltas, &translateRef, begin, end]() {
+			for (size_t index = begin; index < end; index++) {
+				deltas[index] = computeObjectDelta(objects[index].first, objects[index].second, translateRef);
+			}
+		}));
+	}
+	for (auto &task : tasks) {
+		// Rethrows exceptions from the worker threads.
+		task.get();
+	}
+	return deltas;
+}
+
+}  // namespace
 
 void UndoStack::saveProjectState(const Project *src, Project *dest, Project *ref, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
 	assert(dest->links().size() == 0);
@@ -369,10 +462,32 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	};
 
 	// Update objects
-	for (const auto &destObj : dest->instances()) {
-		auto srcObj = src->getInstanceByID(destObj->objectID());
-		UndoHelpers::updateEditorObject(
-			srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, &changes, true);
+	if (dest->instances().size() < parallelRestoreThreshold_) {
+		for (const auto &destObj : dest->instances()) {
+			auto srcObj = src->getInstanceByID(destObj->objectID());
+			UndoHelpers::updateEditorObject(
+				srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, &changes, true);
+		}
+	} else {
+		// Find the changed properties of all objects in parallel and then only update these serially in instance order.
+		// The update invokes handlers which may modify other objects and records the changes, so it can't be parallelized.
+		// Since unchanged properties are neither modified nor recorded by the update this gives the same result
+		// as updating all objects.
+		const auto destInstances = dest->instances();
+		std::vector<std::pair<const EditorObject *, const EditorObject *>> objects;
+		objects.reserve(destInstances.size());
+		for (const auto &destObj : destInstances) {
+			objects.emplace_back(src->getInstanceByID(destObj->objectID()).get(), destObj.get());
+		}
+		auto deltas = computeObjectDeltas(objects, translateRef);
+
+		for (size_t index = 0; index < deltas.size(); index++) {
+			const auto &delta = deltas[index];
+			if (!delta.empty()) {
+				UndoHelpers::updateEditorObject(
+					objects[index].first, destInstances[index], translateRef, [&delta](const std::string &name) { return delta.changedProperties.find(name) == delta.changedProperties.end(); }, factory, &changes, true, delta.annotationsChanged);
+			}
+		}
 	}
 
 	auto findExtref = [](const std::map<std::string, std::set<ValueHandle>>& changes) {
@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/NumericDataImport.h"
+
+#include "core/Iterators.h"
+#include "testing/TestEnvironmentCore.h"
+#include "user_types/LuaScript.h"
+#include "user_types/PerspectiveCamera.h"
+#include "utils/FileUtils.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <limits>
+
+using namespace raco::core;
+using namespace raco::user_types;
+
+class NumericDataImportTest : public TestEnvironmentCore {
+protected:
+	template <typename T>
+	std::string writeBinary(const std::string& fileName, const std::vector<T>& values) {
+		auto path = (test_path() / fileName).string();
+		std::ofstream out(path, std::ios::binary);
+		out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+		return path;
+	}
+
+	std::vector<double> floatArray(const SLuaScript& script) {
+		std::vector<double> result;
+		ValueHandle array{script, {"inputs", "float_array"}};
+		for (size_t index = 0; index < array.size(); index++) {
+			result.emplace_back(array[index].asDouble());
+		}
+		return result;
+	}
+};
+
+TEST_F(NumericDataImportTest, read_csv) {
+	auto path = (test_path() / "data.csv").string();
+	utils::file::write(path, "# header comment\n1, 2.5;-3\n\n4e2\t5\r\n");
+	EXPECT_EQ(readNumericData(path), std::vector<NumericValue>({int64_t{1}, 2.5, int64_t{-3}, 400.0, int64_t{5}}));
+
+	utils::file::write(path, "9007199254740993, -9223372036854775808\n");
+	EXPECT_EQ(readNumericData(path), std::vector<NumericValue>({int64_t{9007199254740993}, std::numeric_limits<int64_t>::min()}));
+
+	utils::file::write(path, "1, abc, 3\n");
+	EXPECT_THROW(readNumericData(path), std::runtime_error);
+}
+
+TEST_F(NumericDataImportTest, read_binary) {
+	EXPECT_EQ(readNumericData(writeBinary<float>("data.f32", {1.5f, -2.0f})), std::vector<NumericValue>({1.5, -2.0}));
+	EXPECT_EQ(readNumericData(writeBinary<double>("data.f64", {0.25, 3.0})), std::vector<NumericValue>({0.25, 3.0}));
+	EXPECT_EQ(readNumericData(writeBinary<int32_t>("data.i32", {7, -8})), std::vector<NumericValue>({int64_t{7}, int64_t{-8}}));
+	EXPECT_EQ(readNumericData(writeBinary<int64_t>("data.i64", {9, 9007199254740993})), std::vector<NumericValue>({int64_t{9}, int64_t{9007199254740993}}));
+
+	// Truncated element
+	auto path = (test_path() / "broken.f32").string();
+	utils::file::write(path, "abcdef");
+	EXPECT_THROW(readNumericData(path), std::runtime_error);
+
+	EXPECT_THROW(readNumericData((test_path() / "data.unknown").string()), std::runtime_error);
+	EXPECT_THROW(readNumericData((test_path() / "no-such-file.csv").string()), std::runtime_error);
+}
+
+TEST_F(NumericDataImportTest, import_array_single_undo_entry) {
+	auto script = create_lua("script", "scripts/array.lua");
+	auto path = (test_path() / "array.csv").string();
+	utils::file::write(path, "1,2,3,4,5\n");
+
+	auto undoSize = undoStack.size();
+	recorder.reset();
+	commandInterface.importNumericValues({script, {"inputs", "float_array"}}, path);
+
+	EXPECT_EQ(floatArray(script), std::vector<double>({1.0, 2.0, 3.0, 4.0, 5.0}));
+	EXPECT_EQ(undoStack.size(), undoSize + 1);
+	// The individual properties are recorded for the UI
+	const auto& changedValues = recorder.getChangedValues().at(script->objectID());
+	EXPECT_EQ(changedValues.count(ValueHandle(script, {"inputs", "float_array"})[4]), 1);
+
+	commandInterface.undoStack().undo();
+	EXPECT_EQ(floatArray(script), std::vector<double>({0.0, 0.0, 0.0, 0.0, 0.0}));
+	commandInterface.undoStack().redo();
+	EXPECT_EQ(floatArray(script), std::vector<double>({1.0, 2.0, 3.0, 4.0, 5.0}));
+}
+
+TEST_F(NumericDataImportTest, set_struct_and_scalar) {
+	auto script = create_lua("script", "scripts/types-scalar.lua");
+
+	commandInterface.setNumericValues({script, {"inputs", "vector3f"}}, {1.0, 2.0, 3.0});
+	EXPECT_EQ(ValueHandle(script, {"inputs", "vector3f", "x"}).asDouble(), 1.0);
+	EXPECT_EQ(ValueHandle(script, {"inputs", "vector3f", "z"}).asDouble(), 3.0);
+
+	commandInterface.setNumericValues({script, {"inputs", "integer64"}}, {42.0});
+	EXPECT_EQ(ValueHandle(script, {"inputs", "integer64"}).asInt64(), 42);
+}
+
+TEST_F(NumericDataImportTest, import_int64_keeps_precision) {
+	auto script = create_lua("script", "scripts/types-scalar.lua");
+	auto path = writeBinary<int64_t>("large.i64", {std::numeric_limits<int64_t>::max()});
+
+	commandInterface.importNumericValues({script, {"inputs", "integer64"}}, path);
+	EXPECT_EQ(ValueHandle(script, {"inputs", "integer64"}).asInt64(), std::numeric_limits<int64_t>::max());
+
+	commandInterface.setNumericValues({script, {"inputs", "integer64"}}, {int64_t{9007199254740993}});
+	EXPECT_EQ(ValueHandle(script, {"inputs", "integer64"}).asInt64(), 9007199254740993);
+
+	// Out of range value for 32 bit integer property
+	EXPECT_THROW(commandInterface.setNumericValues({script, {"inputs", "integer"}}, {int64_t{1} << 40}), std::runtime_error);
+}
+
+TEST_F(NumericDataImportTest, set_scalar_calls_value_changed_handler) {
+	auto camera = create<PerspectiveCamera>("camera");
+	EXPECT_FALSE(camera->frustum_->hasProperty("leftPlane"));
+
+	commandInterface.setNumericValues({camera, &PerspectiveCamera::frustumType_}, {static_cast<double>(EFrustumType::Planes)});
+	EXPECT_TRUE(camera->frustum_->hasProperty("leftPlane"));
+	EXPECT_FALSE(camera->frustum_->hasProperty("fieldOfView"));
+}
+
+TEST_F(NumericDataImportTest, invalid_values_leave_project_unchanged) {
+	auto script = create_lua("script", "scripts/types-scalar.lua");
+	auto undoSize = undoStack.size();
+
+	// Wrong number of values
+	EXPECT_THROW(commandInterface.setNumericValues({script, {"inputs", "vector3i"}}, {1.0, 2.0}), std::runtime_error);
+	// Fractional value for integer property
+	EXPECT_THROW(commandInterface.setNumericValues({script, {"inputs", "vector3i"}}, {1.0, 2.5, 3.0}), std::runtime_error);
+	// Out of range value for 32 bit integer property
+	EXPECT_THROW(commandInterface.setNumericValues({script, {"inputs", "integer"}}, {1e10}), std::runtime_error);
+
+	EXPECT_EQ(ValueHandle(script, {"inputs", "vector3i", "i1"}).asInt(), 0);
+	EXPECT_EQ(undoStack.size(), undoSize);
+}
+
+TEST_F(NumericDataImportTest, linked_property_throws) {
+	auto start = create_lua("start", "scripts/types-scalar.lua");
+	auto end = create_lua("end", "scripts/types-scalar.lua");
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ofloat"}}, ValueHandle{end, {"inputs", "vector3f", "y"}});
+
+	EXPECT_THROW(commandInterface.setNumericValues({end, {"inputs", "vector3f"}}, {1.0, 2.0, 3.0}), std::runtime_error);
+	EXPECT_EQ(ValueHandle(end, {"inputs", "vector3f", "x"}).asDouble(), 0.0);
+}
+
+#ifdef NDEBUG
+TEST_F(NumericDataImportTest, performance_set_large_array) {
+	const int arraySize = 250;
+	auto luaFile = makeFile("big-array.lua", fmt::format(R"(
+function interface(IN,OUT)
+	IN.data = Type:Array({}, Type:Struct({{a = Type:Vec4f(), b = Type:Vec4f()}}))
+end
+
+function run(IN,OUT)
+end
+)",
+												 arraySize));
+	auto script = create_lua("script", luaFile);
+
+	std::vector<NumericValue> values(arraySize * 8);
+	for (size_t index = 0; index < values.size(); index++) {
+		values[index] = static_cast<double>(index) + 1.0;
+	}
+
+	assertOperationTimeIsBelow(100, [this, script, &values]() {
+		commandInterface.setNumericValues({script, {"inputs", "data"}}, values);
+	});
+
+	size_t index = 0;
+	for (auto property : ValueTreeIteratorAdaptor(ValueHandle(script, {"inputs", "data"}))) {
+		if (property.type() == PrimitiveType::Double) {
+			EXPECT_EQ(property.asDouble(), std::get<double>(values[index++]));
+		}
+	}
+	EXPECT_EQ(index, values.size());
+}
+#endif
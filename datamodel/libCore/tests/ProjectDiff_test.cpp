@@ -0,0 +1,172 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ProjectDiff.h"
+
+#include "core/Project.h"
+#include "core/ProjectMigration.h"
+#include "core/Serialization.h"
+#include "core/SerializationKeys.h"
+#include "testing/TestEnvironmentCore.h"
+#include "user_types/LuaScript.h"
+#include "user_types/Node.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace raco::core;
+using namespace raco::user_types;
+
+class ProjectDiffTest : public TestEnvironmentCore {
+protected:
+	// Independent copy of the current project state with identical object IDs.
+	std::unique_ptr<Project> copyProject() {
+		std::unordered_map<std::string, std::vector<int>> versions = {
+			{serialization::keys::FILE_VERSION, {serialization::RAMSES_PROJECT_FILE_VERSION}},
+			{serialization::keys::RAMSES_VERSION, {0, 0, 0}},
+			{serialization::keys::RAMSES_COMPOSER_VERSION, {0, 0, 0}}};
+		std::vector<std::shared_ptr<data_storage::ReflectionInterface>> instances{project.instances().begin(), project.instances().end()};
+		std::vector<std::shared_ptr<data_storage::ReflectionInterface>> links{project.links().begin(), project.links().end()};
+		auto document = serialization::serializeProject(versions, project.featureLevel(), instances, links, project.externalProjectsMap());
+
+		auto deserialized = serialization::deserializeProject(document, "");
+		auto result = std::make_unique<Project>(deserialized.objects);
+		for (const auto& link : deserialized.links) {
+			result->addLink(link);
+		}
+		return result;
+	}
+
+	std::vector<std::string> diffLines(const Project& oldProject, const Project& newProject, ProjectDiffStatistics& statistics) {
+		std::ostringstream stream;
+		ProjectDiffJsonWriter writer(stream);
+		statistics = diffProjects(oldProject, newProject, writer);
+
+		std::vector<std::string> lines;
+		std::istringstream input(stream.str());
+		for (std::string line; std::getline(input, line);) {
+			lines.emplace_back(line);
+		}
+		return lines;
+	}
+
+	static bool containsLine(const std::vector<std::string>& lines, const std::vector<std::string>& fragments) {
+		return std::any_of(lines.begin(), lines.end(), [&fragments](const std::string& line) {
+			return std::all_of(fragments.begin(), fragments.end(), [&line](const std::string& fragment) {
+				return line.find(fragment) != std::string::npos;
+			});
+		});
+	}
+};
+
+TEST_F(ProjectDiffTest, identical_projects) {
+	auto node = create<Node>("node");
+	auto child = create<Node>("child", node);
+	commandInterface.set({child, {"translation", "x"}}, 2.0);
+
+	auto copy = copyProject();
+	ProjectDiffStatistics statistics;
+	auto lines = diffLines(*copy, project, statistics);
+
+	EXPECT_TRUE(statistics.empty());
+	EXPECT_TRUE(lines.empty());
+}
+
+TEST_F(ProjectDiffTest, added_removed_changed_objects) {
+	auto node = create<Node>("node");
+	auto removed = create<Node>("removed");
+	auto old = copyProject();
+
+	commandInterface.deleteObjects({removed});
+	auto added = create<Node>("added");
+	commandInterface.set({node, {"translation", "x"}}, 3.0);
+	commandInterface.set({node, {"visibility"}}, false);
+
+	ProjectDiffStatistics statistics;
+	auto lines = diffLines(*old, project, statistics);
+
+	EXPECT_EQ(statistics.addedObjects, 1);
+	EXPECT_EQ(statistics.removedObjects, 1);
+	EXPECT_EQ(statistics.changedObjects, 1);
+	EXPECT_EQ(statistics.changedProperties, 2);
+	EXPECT_EQ(lines.size(), 4);
+
+	EXPECT_TRUE(containsLine(lines, {R"("op":"add")", R"("kind":"object")", added->objectID(), R"("name":"added")"}));
+	EXPECT_TRUE(containsLine(lines, {R"("op":"remove")", R"("kind":"object")", removed->objectID()}));
+	EXPECT_TRUE(containsLine(lines, {R"("op":"change")", node->objectID(), R"("path":"translation.x")", R"("old":0)", R"("new":3)"}));
+	EXPECT_TRUE(containsLine(lines, {R"("op":"change")", node->objectID(), R"("path":"visibility")", R"("old":true)", R"("new":false)"}));
+}
+
+TEST_F(ProjectDiffTest, scenegraph_move_reports_reference_by_id) {
+	auto parent = create<Node>("parent");
+	auto child = create<Node>("child");
+	auto old = copyProject();
+
+	commandInterface.moveScenegraphChildren({child}, parent);
+
+	ProjectDiffStatistics statistics;
+	auto lines = diffLines(*old, project, statistics);
+
+	EXPECT_EQ(statistics.addedProperties, 1);
+	EXPECT_TRUE(containsLine(lines, {R"("op":"add")", parent->objectID(), R"("path":"children.1")", R"("new":")" + child->objectID()}));
+}
+
+TEST_F(ProjectDiffTest, dynamic_properties_and_links) {
+	auto start = create_lua("start", "scripts/types-scalar.lua");
+	auto end = create_lua("end", "scripts/types-scalar.lua");
+	auto node = create<Node>("node");
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ofloat"}}, ValueHandle{end, {"inputs", "float"}});
+	auto old = copyProject();
+
+	commandInterface.removeLink({end, {"inputs", "float"}});
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ovector3f"}}, ValueHandle{node, {"translation"}});
+	commandInterface.set({end, {"uri"}}, (test_path() / "scripts/SimpleScript.lua").string());
+
+	ProjectDiffStatistics statistics;
+	auto lines = diffLines(*old, project, statistics);
+
+	EXPECT_EQ(statistics.addedLinks, 1);
+	EXPECT_EQ(statistics.removedLinks, 1);
+	EXPECT_GT(statistics.removedProperties, 0);
+	EXPECT_TRUE(containsLine(lines, {R"("op":"add")", R"("kind":"link")", start->objectID() + ".outputs.ovector3f", node->objectID() + ".translation"}));
+	EXPECT_TRUE(containsLine(lines, {R"("op":"remove")", R"("kind":"link")", start->objectID() + ".outputs.ofloat", end->objectID() + ".inputs.float"}));
+	EXPECT_TRUE(containsLine(lines, {R"("op":"change")", end->objectID(), R"("path":"uri")"}));
+	EXPECT_TRUE(containsLine(lines, {R"("op":"remove")", end->objectID(), R"("path":"inputs.vector3f")", R"("old":{"type":"Vec3f"})"}));
+}
+
+#ifdef NDEBUG
+TEST_F(ProjectDiffTest, performance_diff_50k_nodes_sparse_changes) {
+	const int numNodes = 50000;
+	const int numChanges = 50;
+
+	Project oldProject;
+	Project newProject;
+	std::vector<SNode> newNodes;
+	for (int index = 0; index < numNodes; index++) {
+		auto id = EditorObject::normalizedObjectID(std::to_string(index));
+		oldProject.addInstance(std::make_shared<Node>(fmt::format("node {}", index), id));
+		newNodes.emplace_back(std::make_shared<Node>(fmt::format("node {}", index), id));
+		newProject.addInstance(newNodes.back());
+	}
+	for (int index = 0; index < numChanges; index++) {
+		newNodes[index * (numNodes / numChanges)]->translation_->x = 1.0;
+	}
+
+	ProjectDiffStatistics statistics;
+	std::ostringstream stream;
+	ProjectDiffJsonWriter writer(stream);
+	assertOperationTimeIsBelow(1000, [&]() {
+		statistics = diffProjects(oldProject, newProject, writer);
+	});
+
+	EXPECT_EQ(statistics.changedObjects, numChanges);
+	EXPECT_EQ(statistics.changedProperties, numChanges);
+}
+#endif
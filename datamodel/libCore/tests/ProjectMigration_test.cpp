@@ -97,6 +97,47 @@ struct MigrationTest : public TestEnvironmentCore {
 
 		return racoproject;
 	}
+
+	QJsonDocument loadJson(const QString& filename) {
+		QFile file{filename};
+		EXPECT_TRUE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+		auto document{QJsonDocument::fromJson(file.readAll())};
+		file.close();
+		return document;
+	}
+
+	QByteArray reserialize(const serialization::ProjectDeserializationInfo& deserialized) {
+		std::unordered_map<std::string, std::vector<int>> versions = {
+			{serialization::keys::FILE_VERSION, {serialization::RAMSES_PROJECT_FILE_VERSION}},
+			{serialization::keys::RAMSES_VERSION, {0, 0, 0}},
+			{serialization::keys::RAMSES_COMPOSER_VERSION, {0, 0, 0}}};
+		std::vector<std::shared_ptr<data_storage::ReflectionInterface>> instances{deserialized.objects.begin(), deserialized.objects.end()};
+		std::vector<std::shared_ptr<data_storage::ReflectionInterface>> links{deserialized.links.begin(), deserialized.links.end()};
+		return serialization::serializeProject(versions, 1, instances, links, deserialized.externalProjectsMap).toJson();
+	}
+
+	// Check that the direct deserialization into user types and the deserialization via the proxy types
+	// and the migration code create identical projects.
+	void checkDeserializationPathsIdentical(const QJsonDocument& document, const std::string& filename) {
+		ASSERT_EQ(serialization::deserializeFileVersion(document), serialization::RAMSES_PROJECT_FILE_VERSION);
+
+		auto direct = serialization::deserializeProjectToUserTypes(document, filename);
+		auto migrated = serialization::deserializeProjectWithMigration(document, filename);
+
+		ASSERT_EQ(direct.objects.size(), migrated.objects.size());
+		ASSERT_EQ(direct.links.size(), migrated.links.size());
+		for (size_t index = 0; index < direct.objects.size(); index++) {
+			EXPECT_EQ(direct.objects[index]->objectID(), migrated.objects[index]->objectID());
+			EXPECT_EQ(direct.objects[index]->getTypeDescription().typeName, migrated.objects[index]->getTypeDescription().typeName);
+		}
+		EXPECT_EQ(direct.externalProjectsMap, migrated.externalProjectsMap);
+		EXPECT_EQ(direct.fileVersion, migrated.fileVersion);
+		EXPECT_EQ(direct.versionInfo.raCoVersion, migrated.versionInfo.raCoVersion);
+		EXPECT_EQ(direct.versionInfo.ramsesVersion, migrated.versionInfo.ramsesVersion);
+		EXPECT_TRUE(direct.migrationObjWarnings.empty());
+
+		EXPECT_EQ(reserialize(direct).toStdString(), reserialize(migrated).toStdString());
+	}
 };
 
 TEST_F(MigrationTest, migrate_from_V1) {
@@ -1341,6 +1382,25 @@ TEST_F(MigrationTest, migrate_from_current) {
 	}
 }
 
+TEST_F(MigrationTest, deserialization_paths_identical_current_file) {
+	QString filename = QString::fromStdString((test_path() / "migrationTestData" / "version-current.rca").string());
+	checkDeserializationPathsIdentical(loadJson(filename), filename.toStdString());
+}
+
+TEST_F(MigrationTest, deserialization_paths_identical_after_save) {
+	// Round trip: load, serialize the loaded project again and compare both deserialization paths on the result.
+	QString filename = QString::fromStdString((test_path() / "migrationTestData" / "version-current.rca").string());
+	auto racoproject = loadAndCheckJson(filename);
+
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{serialization::keys::FILE_VERSION, {serialization::RAMSES_PROJECT_FILE_VERSION}},
+		{serialization::keys::RAMSES_VERSION, {0, 0, 0}},
+		{serialization::keys::RAMSES_COMPOSER_VERSION, {0, 0, 0}}};
+	auto document = racoproject->serializeProject(versions);
+
+	checkDeserializationPathsIdentical(document, filename.toStdString());
+}
+
 TEST_F(MigrationTest, check_current_type_maps) {
 	// Check that the type maps for user object and structs types in the "version-current.rca" are
 	// identical to the ones generated when saving a project.
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/ProjectSnapshot.h"
+
+#include "core/Iterators.h"
+#include "testing/TestEnvironmentCore.h"
+#include "user_types/Node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+
+using namespace raco::core;
+using namespace raco::user_types;
+
+class ProjectSnapshotTest : public TestEnvironmentCore {
+protected:
+	// Count the object references in the snapshot which don't point to the object with the same id in the snapshot
+	// and the children whose parent according to the snapshot is not the object containing them.
+	static size_t countInconsistencies(const ProjectSnapshot& snapshot) {
+		size_t count = 0;
+		for (const auto& object : snapshot.project().instances()) {
+			for (auto handle : ValueTreeIteratorAdaptor(ValueHandle(object))) {
+				if (handle.type() == PrimitiveType::Ref) {
+					if (auto target = handle.asRef()) {
+						if (snapshot.project().getInstanceByID(target->objectID()) != target) {
+							++count;
+						}
+					}
+				}
+			}
+			for (auto child : *object) {
+				if (snapshot.parent(child) != object) {
+					++count;
+				}
+			}
+		}
+		return count;
+	}
+
+	static double translationX(const ProjectSnapshot& snapshot, const SEditorObject& object) {
+		return ValueHandle(snapshot.project().getInstanceByID(object->objectID()), {"translation", "x"}).asDouble();
+	}
+};
+
+TEST_F(ProjectSnapshotTest, unchanged_objects_are_shared) {
+	auto root = create<Node>("root");
+	auto left = create<Node>("left", root);
+	auto leftChild = create<Node>("left_child", left);
+	auto right = create<Node>("right", root);
+
+	ProjectSnapshotter snapshotter(&context);
+	auto first = snapshotter.takeSnapshot();
+	EXPECT_EQ(first->generation(), 1);
+	EXPECT_EQ(first->copiedObjects(), project.instances().size());
+	EXPECT_EQ(first->sharedObjects(), 0);
+	EXPECT_EQ(countInconsistencies(*first), 0);
+	EXPECT_EQ(snapshotter.takeSnapshot(), first);
+	EXPECT_EQ(snapshotter.latest(), first);
+
+	commandInterface.set({leftChild, {"translation", "x"}}, 5.0);
+	auto second = snapshotter.takeSnapshot();
+	EXPECT_EQ(second->generation(), 2);
+	// The changed node and its ancestors are copied.
+	EXPECT_EQ(second->copiedObjects(), 3);
+	EXPECT_EQ(second->sharedObjects(), project.instances().size() - 3);
+	EXPECT_EQ(second->project().getInstanceByID(right->objectID()), first->project().getInstanceByID(right->objectID()));
+	EXPECT_NE(second->project().getInstanceByID(leftChild->objectID()), first->project().getInstanceByID(leftChild->objectID()));
+	EXPECT_NE(second->project().getInstanceByID(root->objectID()), first->project().getInstanceByID(root->objectID()));
+	EXPECT_EQ(translationX(*first, leftChild), 0.0);
+	EXPECT_EQ(translationX(*second, leftChild), 5.0);
+	EXPECT_EQ(countInconsistencies(*second), 0);
+
+	auto snapshotLeftChild = second->project().getInstanceByID(leftChild->objectID());
+	EXPECT_EQ(second->parent(snapshotLeftChild), second->project().getInstanceByID(left->objectID()));
+	EXPECT_EQ(second->parent(second->project().getInstanceByID(root->objectID())), nullptr);
+
+	commandInterface.deleteObjects({right});
+	auto third = snapshotter.takeSnapshot();
+	EXPECT_EQ(third->project().getInstanceByID(right->objectID()), nullptr);
+	EXPECT_NE(first->project().getInstanceByID(right->objectID()), nullptr);
+	EXPECT_EQ(third->project().getInstanceByID(leftChild->objectID()), snapshotLeftChild);
+	EXPECT_EQ(third->project().instances().size(), project.instances().size());
+	EXPECT_EQ(countInconsistencies(*third), 0);
+}
+
+TEST_F(ProjectSnapshotTest, concurrent_readers_and_writer) {
+	auto root = create<Node>("root");
+	std::vector<SEditorObject> nodes;
+	for (int index = 0; index < 20; index++) {
+		nodes.emplace_back(create<Node>("node_" + std::to_string(index), index % 2 == 0 ? root : nodes.back()));
+	}
+
+	ProjectSnapshotter snapshotter(&context);
+	snapshotter.takeSnapshot();
+
+	std::atomic<bool> stop{false};
+	std::atomic<size_t> inconsistentValues{0};
+	std::atomic<size_t> inconsistentReferences{0};
+	std::atomic<size_t> snapshotsRead{0};
+
+	std::vector<std::thread> readers;
+	for (int reader = 0; reader < 4; reader++) {
+		readers.emplace_back([&]() {
+			while (!stop) {
+				auto snapshot = snapshotter.latest();
+				// The writer sets the x translation of all nodes to the same value before taking a snapshot.
+				std::optional<double> value;
+				for (const auto& object : snapshot->project().instances()) {
+					if (object->isType<Node>()) {
+						auto x = ValueHandle(object, {"translation", "x"}).asDouble();
+						if (value && *value != x) {
+							++inconsistentValues;
+						}
+						value = x;
+					}
+				}
+				inconsistentReferences += countInconsistencies(*snapshot);
+				++snapshotsRead;
+			}
+		});
+	}
+
+	for (int iteration = 1; iteration <= 200; iteration++) {
+		for (const auto& object : project.instances()) {
+			if (object->isType<Node>()) {
+				commandInterface.set({object, {"translation", "x"}}, static_cast<double>(iteration));
+			}
+		}
+		if (iteration % 10 == 0) {
+			commandInterface.moveScenegraphChildren({nodes[iteration % nodes.size()]}, iteration % 20 == 0 ? nullptr : root);
+			nodes.emplace_back(create<Node>("node_" + std::to_string(nodes.size()), nodes.back()));
+			commandInterface.set({nodes.back(), {"translation", "x"}}, static_cast<double>(iteration));
+		}
+		if (iteration % 25 == 0) {
+			// Deletes the subtree of the node as well.
+			commandInterface.deleteObjects({nodes[nodes.size() / 2]});
+			nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [this](const SEditorObject& node) { return !project.isInstance(node); }), nodes.end());
+		}
+		auto snapshot = snapshotter.takeSnapshot();
+		EXPECT_EQ(snapshot->project().instances().size(), project.instances().size());
+	}
+
+	stop = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+
+	EXPECT_GT(snapshotsRead, 0);
+	EXPECT_EQ(inconsistentValues, 0);
+	EXPECT_EQ(inconsistentReferences, 0);
+
+	auto last = snapshotter.latest();
+	for (const auto& node : nodes) {
+		EXPECT_EQ(translationX(*last, node), 200.0);
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "core/PropertyStateCache.h"
+
+#include "core/Iterators.h"
+#include "core/Queries.h"
+#include "testing/TestEnvironmentCore.h"
+#include "user_types/LuaInterface.h"
+#include "user_types/MeshNode.h"
+#include "user_types/OrthographicCamera.h"
+#include "user_types/Prefab.h"
+#include "user_types/PrefabInstance.h"
+#include "user_types/RenderLayer.h"
+
+#include <gtest/gtest.h>
+
+using namespace raco::core;
+using namespace raco::user_types;
+
+class PropertyStateCacheTest : public TestEnvironmentCore {
+protected:
+	// Compare the cached states with the Queries functions for all properties of all objects.
+	void checkAllProperties() {
+		size_t count = 0;
+		for (const auto& object : project.instances()) {
+			for (auto handle : ValueTreeIteratorAdaptor(ValueHandle(object))) {
+				auto path = handle.getPropertyPath();
+				EXPECT_EQ(cache.isReadOnly(project, handle), Queries::isReadOnly(project, handle)) << path;
+				EXPECT_EQ(cache.isReadOnly(project, handle, true), Queries::isReadOnly(project, handle, true)) << path;
+				EXPECT_EQ(cache.isHiddenInPropertyBrowser(project, handle, false), Queries::isHiddenInPropertyBrowser(project, handle, false)) << path;
+				EXPECT_EQ(cache.isHiddenInPropertyBrowser(project, handle, true), Queries::isHiddenInPropertyBrowser(project, handle, true)) << path;
+				++count;
+			}
+		}
+		EXPECT_GT(count, 0u);
+	}
+
+	void invalidate() {
+		cache.invalidate(recorder);
+		recorder.reset();
+	}
+
+	PropertyStateCache cache;
+};
+
+TEST_F(PropertyStateCacheTest, equivalent_to_queries) {
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+	auto material = create_material("material", "shaders/basic.vert", "shaders/basic.frag");
+	auto sharedMeshNode = create_meshnode("shared", mesh, material);
+	auto privateMeshNode = create_meshnode("private", mesh, material);
+	commandInterface.set({privateMeshNode, {"materials", "material", "private"}}, true);
+
+	auto start = create_lua("start", "scripts/types-scalar.lua");
+	auto end = create_lua("end", "scripts/types-scalar.lua");
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ofloat"}}, ValueHandle{end, {"inputs", "float"}});
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ovector3f"}}, ValueHandle{end, {"inputs", "vector3f"}});
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ovector3f"}}, ValueHandle{sharedMeshNode, {"translation"}});
+
+	auto prefab = create<Prefab>("prefab");
+	auto node = create<Node>("node", prefab);
+	create_lua_interface("interface", "scripts/interface-scalar-types.lua", prefab);
+	create_lua("prefab_lua", "scripts/types-scalar.lua", node);
+	auto inst = create_prefabInstance("inst", prefab);
+
+	create<OrthographicCamera>("camera");
+	auto layer = create_layer("layer", {}, {{"tag", 1}});
+	commandInterface.set({layer, &RenderLayer::sortOrder_}, static_cast<int>(ERenderLayerOrder::SceneGraph));
+
+	checkAllProperties();
+}
+
+TEST_F(PropertyStateCacheTest, invalidated_by_changes) {
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+	auto material = create_material("material", "shaders/basic.vert", "shaders/basic.frag");
+	auto meshnode = create_meshnode("meshnode", mesh, material);
+	auto start = create_lua("start", "scripts/types-scalar.lua");
+	auto end = create_lua("end", "scripts/types-scalar.lua");
+	auto prefab = create<Prefab>("prefab");
+	auto inst = create_prefabInstance("inst", prefab);
+	invalidate();
+	checkAllProperties();
+
+	// Link changes
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ovector3f"}}, ValueHandle{end, {"inputs", "vector3f"}});
+	invalidate();
+	EXPECT_TRUE(cache.isReadOnly(project, {end, {"inputs", "vector3f", "x"}}));
+	checkAllProperties();
+
+	commandInterface.removeLink({end, {"inputs", "vector3f"}});
+	invalidate();
+	EXPECT_FALSE(cache.isReadOnly(project, {end, {"inputs", "vector3f", "x"}}));
+	checkAllProperties();
+
+	// Material private flag
+	commandInterface.set({meshnode, {"materials", "material", "private"}}, true);
+	invalidate();
+	checkAllProperties();
+
+	// Prefab changes
+	commandInterface.moveScenegraphChildren({end}, prefab);
+	invalidate();
+	EXPECT_TRUE(cache.isReadOnly(project, {inst->children_->asVector<SEditorObject>().front(), {"inputs", "float"}}));
+	checkAllProperties();
+}
@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 
 using namespace raco::core;
 using namespace raco::user_types;
@@ -2146,4 +2147,68 @@ TEST_F(UndoTest, volatile_no_undo) {
 
 	EXPECT_EQ(*node->visibility_, false);
 	EXPECT_EQ(*node->editorVisibility_, false);
-}
\ No newline at end of file
+}
+
+TEST_F(UndoTest, restore_parallel_records_same_changes_as_serial) {
+	// Summary of the recorded changes which doesn't depend on the identity of recreated objects.
+	auto recordedChanges = [this]() {
+		std::set<std::string> result;
+		for (const auto& obj : recorder.getCreatedObjects()) {
+			result.insert("created " + obj->objectID());
+		}
+		for (const auto& obj : recorder.getDeletedObjects()) {
+			result.insert("deleted " + obj->objectID());
+		}
+		for (const auto& [id, handles] : recorder.getChangedValues()) {
+			for (const auto& handle : handles) {
+				result.insert("changed " + handle.getPropertyPath(true));
+			}
+		}
+		for (const auto& [id, links] : recorder.getAddedLinks()) {
+			result.insert(fmt::format("added links {} {}", id, links.size()));
+		}
+		for (const auto& [id, links] : recorder.getRemovedLinks()) {
+			result.insert(fmt::format("removed links {} {}", id, links.size()));
+		}
+		return result;
+	};
+
+	std::vector<SEditorObject> nodes;
+	for (int index = 0; index < 20; index++) {
+		nodes.emplace_back(create<Node>(fmt::format("node{}", index)));
+	}
+	auto start = create_lua("start", "scripts/types-scalar.lua");
+	auto end = create_lua("end", "scripts/types-scalar.lua");
+	size_t createdIndex = undoStack.getIndex();
+
+	for (int index = 0; index < 10; index++) {
+		commandInterface.set({nodes[index], {"translation", "x"}}, static_cast<double>(index));
+		commandInterface.moveScenegraphChildren({nodes[index + 10]}, nodes[index]);
+	}
+	commandInterface.addLink(ValueHandle{start, {"outputs", "ofloat"}}, ValueHandle{end, {"inputs", "float"}});
+	commandInterface.deleteObjects({nodes[19], start});
+	create<MeshNode>("meshnode");
+	size_t endIndex = undoStack.getIndex();
+
+	std::vector<size_t> jumps{0, createdIndex, endIndex, createdIndex + 5, 1, endIndex};
+	std::vector<std::set<std::string>> serialChanges;
+	undoStack.setParallelRestoreThreshold(std::numeric_limits<size_t>::max());
+	for (auto index : jumps) {
+		recorder.reset();
+		undoStack.setIndex(index);
+		serialChanges.emplace_back(recordedChanges());
+	}
+
+	std::vector<std::set<std::string>> parallelChanges;
+	undoStack.setParallelRestoreThreshold(0);
+	for (auto index : jumps) {
+		recorder.reset();
+		undoStack.setIndex(index);
+		parallelChanges.emplace_back(recordedChanges());
+	}
+
+	EXPECT_EQ(serialChanges, parallelChanges);
+	EXPECT_FALSE(serialChanges.front().empty());
+	EXPECT_TRUE(findInstance("meshnode"));
+	EXPECT_FALSE(findInstance("start"));
+}
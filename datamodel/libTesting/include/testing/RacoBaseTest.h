@@ -9,7 +9,9 @@
  */
 #pragma once
 
+#include <chrono>
 #include <filesystem>
+#include <functional>
 #include "utils/FileUtils.h"
 #include "utils/u8path.h"
 #include "core/Context.h"
@@ -87,6 +89,14 @@ public:
 		}
 	}
 
+	void assertOperationTimeIsBelow(testing::TimeInMillis maxMs, const std::function<void()>& operation) {
+		auto startTime = std::chrono::steady_clock::now();
+		operation();
+		auto endTime = std::chrono::steady_clock::now();
+		auto opTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+		ASSERT_LE(opTimeMs, maxMs) << "Operation took longer than allowed boundary of " << maxMs << " ms\nActual operation duration: " << opTimeMs << " ms";
+	}
+
 
 	std::vector<std::string> split(const std::string& s, char delim) {
 		std::stringstream sstream{s};
@@ -64,6 +64,10 @@ public:
 	std::vector<std::unique_ptr<Entry>>& stack() {
 		return stack_;
 	}
+
+	void setParallelRestoreThreshold(size_t threshold) {
+		parallelRestoreThreshold_ = threshold;
+	}
 };
 
 class TestObjectFactory : public user_types::UserObjectFactory {
@@ -261,14 +265,6 @@ struct TestEnvironmentCoreT : public RacoBaseTest<BaseClass> {
 		checkLinks(project, refLinks);
 	}
 
-	void assertOperationTimeIsBelow(testing::TimeInMillis maxMs, const std::function<void()>& operation) {
-		auto startTime = std::chrono::steady_clock::now();
-		operation();
-		auto endTime = std::chrono::steady_clock::now();
-		auto opTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-		ASSERT_LE(opTimeMs, maxMs) << "Operation took longer than allowed boundary of " << maxMs << " ms\nActual operation duration: " << opTimeMs << " ms";
-	}
-
 	TestEnvironmentCoreT(UserObjectFactoryInterface* objectFactory = &UserObjectFactory::getInstance(), ramses::EFeatureLevel featureLevel = ramses_base::BaseEngineBackend::maxFeatureLevel)
 		: backend{},
 		  meshCache{},
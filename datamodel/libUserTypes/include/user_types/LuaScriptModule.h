@@ -11,6 +11,7 @@
 
 #include "user_types/BaseObject.h"
 #include "user_types/LuaStandardModuleSelection.h"
+#include "utils/SourceTextStore.h"
 
 #include <map>
 #include <set>
@@ -60,7 +61,7 @@ public:
 private:
 	void sync(BaseContext& context);
 
-	std::string currentScriptContents_;
+	utils::SharedText currentScriptContents_;
 	bool isValid_ = false;
 };
 
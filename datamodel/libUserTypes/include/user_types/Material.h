@@ -15,6 +15,7 @@
 #include "user_types/DefaultValues.h"
 #include "user_types/Enumerations.h"
 #include "user_types/SyncTableWithEngineInterface.h"
+#include "utils/SourceTextStore.h"
 
 #include <map>
 
@@ -317,7 +318,7 @@ public:
 	}
 
 	// Utility method to get preprocessed shader.
-	static std::string loadShader(const Project& project, const ValueHandle& uri);
+	static utils::SharedText loadShader(const Project& project, const ValueHandle& uri);
 
 	const PropertyInterfaceList& attributes() const;
 
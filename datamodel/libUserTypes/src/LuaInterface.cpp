@@ -15,7 +15,7 @@
 #include "core/PathQueries.h"
 #include "core/Project.h"
 #include "core/Queries.h"
-#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
 #include "LuaUtils.h"
 
 namespace raco::user_types {
@@ -56,7 +56,8 @@ void LuaInterface::syncLuaScript(BaseContext& context, bool syncModules) {
 	PropertyInterfaceList inputs{};
 
 	if (validateURI(context, {shared_from_this(), &LuaInterface::uri_})) {
-		std::string luaInterface = utils::file::read(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &LuaInterface::uri_}));
+		utils::SharedText sourceText = utils::SourceTextStore::instance().readOrEmpty(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &LuaInterface::uri_}));
+		const std::string& luaInterface = *sourceText;
 
 		std::string error{};
 		bool success = true;
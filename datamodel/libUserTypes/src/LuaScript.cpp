@@ -16,7 +16,7 @@
 #include "core/Project.h"
 #include "core/Queries.h"
 #include "user_types/LuaScriptModule.h"
-#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
 
 namespace raco::user_types {
 
@@ -59,7 +59,8 @@ void LuaScript::syncLuaScript(BaseContext& context, bool syncModules) {
 	PropertyInterfaceList outputs{};
 
 	if (validateURI(context, {shared_from_this(), &LuaScript::uri_})) {
-		std::string luaScript = utils::file::read(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &LuaScript::uri_}));
+		utils::SharedText sourceText = utils::SourceTextStore::instance().readOrEmpty(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &LuaScript::uri_}));
+		const std::string& luaScript = *sourceText;
 
 		std::string error{};
 		bool success = true;
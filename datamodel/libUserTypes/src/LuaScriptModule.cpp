@@ -14,7 +14,7 @@
 #include "core/Handles.h"
 #include "core/PathQueries.h"
 #include "core/Project.h"
-#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
 
 namespace raco::user_types {
 
@@ -40,7 +40,8 @@ void LuaScriptModule::updateFromExternalFile(BaseContext& context) {
 
 void LuaScriptModule::sync(BaseContext& context) {
 	if (validateURI(context, {shared_from_this(), &LuaScriptModule::uri_})) {
-		std::string luaScript = utils::file::read(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &LuaScriptModule::uri_}));
+		currentScriptContents_ = utils::SourceTextStore::instance().readOrEmpty(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &LuaScriptModule::uri_}));
+		const std::string& luaScript = *currentScriptContents_;
 
 		std::string error;
 		isValid_ = context.engineInterface().parseLuaScriptModule(shared_from_this(), luaScript, objectName(), stdModules_->activeModules(), error);
@@ -50,10 +51,9 @@ void LuaScriptModule::sync(BaseContext& context) {
 		} else {
 			context.errors().removeError({shared_from_this()});
 		}
-		currentScriptContents_ = luaScript;
 	} else {
 		context.errors().removeError({shared_from_this()});
-		currentScriptContents_.clear();
+		currentScriptContents_.reset();
 		context.engineInterface().removeModuleFromCache(shared_from_this());
 		isValid_ = false;
 	}
@@ -66,7 +66,8 @@ bool LuaScriptModule::isValid() const {
 }
 
 const std::string& LuaScriptModule::currentScriptContents() const {
-	return currentScriptContents_;
+	static const std::string empty;
+	return currentScriptContents_ ? *currentScriptContents_ : empty;
 }
 
 }  // namespace raco::user_types
@@ -14,7 +14,6 @@
 #include "core/MeshCacheInterface.h"
 #include "core/PathQueries.h"
 #include "core/Project.h"
-#include "utils/FileUtils.h"
 #include "utils/ShaderPreprocessor.h"
 
 namespace raco::user_types {
@@ -34,10 +33,10 @@ bool validateShaderURI(BaseContext& context, const ValueHandle& uri, bool isNonE
 	return validateURI(context, uri);
 }
 
-std::string Material::loadShader(const Project& project, const ValueHandle& uri) {
+utils::SharedText Material::loadShader(const Project& project, const ValueHandle& uri) {
 	const std::string shaderPath = PathQueries::resolveUriPropertyToAbsolutePath(project, uri);
 	const ShaderPreprocessor preprocessor(shaderPath);
-	return preprocessor.getProcessedShader();
+	return utils::SourceTextStore::instance().intern(preprocessor.getProcessedShader());
 }
 
 std::tuple<bool, std::string> Material::validateShader(BaseContext& context, const ValueHandle& uriHandle, bool isNonEmptyUriRequired) {
@@ -91,7 +90,7 @@ void Material::updateFromExternalFile(BaseContext& context) {
 
 		std::string shaderDefines;
 		if (isUriDefinesValid) {
-			shaderDefines = {utils::file::read(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &Material::uriDefines_}))};
+			shaderDefines = *utils::SourceTextStore::instance().readOrEmpty(PathQueries::resolveUriPropertyToAbsolutePath(*context.project(), {shared_from_this(), &Material::uriDefines_}));
 			// ramses treats the empty string as no shader defines should be loaded and only shows errors if the string contains at least a single charcater.
 			// We want to display errors when the file load was successful but the file is empty.
 			if (shaderDefines.empty()) {
@@ -59,9 +59,27 @@ public:
 	VisibilityState getPreviewVisibility() const;
 	VisibilityState getAbstractViewVisibility() const;
 
+	// Lowercase versions of the fields used by the ObjectTreeFilter.
+	// These are cached and only recomputed if the underlying value has changed since the filter
+	// is evaluated for every node each time the filter string changes.
+	const std::string& getLowerCaseDisplayName() const;
+	const std::string& getLowerCaseDisplayType() const;
+	const std::string& getLowerCaseID() const;
+	const std::vector<std::string>& getLowerCaseUserTags() const;
+
+	static std::string toLower(const std::string& input);
+
 	void setBelongsToExternalProject(const std::string &path, const std::string &name);
 
 protected:
+	struct LowerCaseCacheEntry {
+		bool valid = false;
+		std::string source;
+		std::string lowered;
+	};
+
+	static const std::string& updateLowerCaseCache(LowerCaseCacheEntry& entry, const std::string& source);
+
 	ObjectTreeNode *parent_;
 	ObjectTreeNodeType type_;
 	std::string externalProjectPath_ = "";
@@ -69,5 +87,12 @@ protected:
 	std::string typeName_ = "";
     std::vector<ObjectTreeNode*> children_;
 	core::SEditorObject representedObject_;
+
+	mutable LowerCaseCacheEntry lowerCaseName_;
+	mutable LowerCaseCacheEntry lowerCaseType_;
+	mutable LowerCaseCacheEntry lowerCaseID_;
+	mutable bool lowerCaseUserTagsValid_ = false;
+	mutable std::vector<std::string> userTagsSource_;
+	mutable std::vector<std::string> lowerCaseUserTags_;
 };
 }
\ No newline at end of file
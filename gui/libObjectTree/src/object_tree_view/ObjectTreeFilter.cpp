@@ -9,9 +9,123 @@
  */
 #include "object_tree_view/ObjectTreeFilter.h"
 
+#include <algorithm>
+
 using namespace raco::object_tree::view;
 using namespace raco;
 
+ObjectTreeFilterProgram ObjectTreeFilterProgram::condition(Field field, Operation operation, const std::string& value) {
+	ObjectTreeFilterProgram program;
+	program.instructions_.emplace_back(Instruction{InstructionType::Condition, field, operation, model::ObjectTreeNode::toLower(value), 0, 0});
+	return program;
+}
+
+ObjectTreeFilterProgram ObjectTreeFilterProgram::combine(InstructionType type, const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) {
+	if (lhs.empty() || rhs.empty()) {
+		return {};
+	}
+
+	ObjectTreeFilterProgram program;
+	program.instructions_.reserve(lhs.size() + rhs.size() + 1);
+	program.instructions_.insert(program.instructions_.end(), lhs.instructions_.begin(), lhs.instructions_.end());
+
+	// Operand indices of the rhs instructions need to be shifted by the size of the lhs program.
+	const auto offset = lhs.size();
+	for (auto instruction : rhs.instructions_) {
+		if (instruction.type != InstructionType::Condition) {
+			instruction.lhs += offset;
+			instruction.rhs += offset;
+		}
+		program.instructions_.emplace_back(std::move(instruction));
+	}
+
+	program.instructions_.emplace_back(Instruction{type, Field::Name, Operation::Contains, {}, lhs.size() - 1, program.instructions_.size() - 1});
+	return program;
+}
+
+ObjectTreeFilterProgram ObjectTreeFilterProgram::combineAND(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) {
+	return combine(InstructionType::And, lhs, rhs);
+}
+
+ObjectTreeFilterProgram ObjectTreeFilterProgram::combineOR(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) {
+	return combine(InstructionType::Or, lhs, rhs);
+}
+
+bool ObjectTreeFilterProgram::empty() const {
+	return instructions_.empty();
+}
+
+size_t ObjectTreeFilterProgram::size() const {
+	return instructions_.size();
+}
+
+bool ObjectTreeFilterProgram::operator()(const model::ObjectTreeNode& objectTreeNode) const {
+	if (instructions_.empty()) {
+		return false;
+	}
+	return evaluate(instructions_.size() - 1, objectTreeNode);
+}
+
+bool ObjectTreeFilterProgram::evaluate(size_t index, const model::ObjectTreeNode& objectTreeNode) const {
+	const auto& instruction = instructions_[index];
+	switch (instruction.type) {
+		case InstructionType::And:
+			return evaluate(instruction.lhs, objectTreeNode) && evaluate(instruction.rhs, objectTreeNode);
+		case InstructionType::Or:
+			return evaluate(instruction.lhs, objectTreeNode) || evaluate(instruction.rhs, objectTreeNode);
+		default:
+			return evaluateCondition(instruction, objectTreeNode);
+	}
+}
+
+bool ObjectTreeFilterProgram::matches(Operation operation, const std::string& loweredObjectValue, const std::string& loweredValue) {
+	switch (operation) {
+		case Operation::Equal:
+			return loweredObjectValue == loweredValue;
+		case Operation::NotEqual:
+			return loweredObjectValue != loweredValue;
+		case Operation::Contains:
+			return loweredObjectValue.find(loweredValue) != std::string::npos;
+		case Operation::NotContains:
+			return loweredObjectValue.find(loweredValue) == std::string::npos;
+	}
+	return false;
+}
+
+bool ObjectTreeFilterProgram::evaluateCondition(const Instruction& instruction, const model::ObjectTreeNode& objectTreeNode) const {
+	if (instruction.field == Field::Tag) {
+		const auto& tags = objectTreeNode.getLowerCaseUserTags();
+		if (instruction.operation == Operation::Equal || instruction.operation == Operation::Contains) {
+			return std::any_of(tags.begin(), tags.end(), [&instruction](const std::string& tag) {
+				return matches(instruction.operation, tag, instruction.loweredValue);
+			});
+		}
+		return std::all_of(tags.begin(), tags.end(), [&instruction](const std::string& tag) {
+			return matches(instruction.operation, tag, instruction.loweredValue);
+		});
+	}
+
+	const std::string* objValue = nullptr;
+	switch (instruction.field) {
+		case Field::Name:
+			objValue = &objectTreeNode.getLowerCaseDisplayName();
+			break;
+		case Field::Type:
+			objValue = &objectTreeNode.getLowerCaseDisplayType();
+			break;
+		case Field::ID:
+			objValue = &objectTreeNode.getLowerCaseID();
+			break;
+		default:
+			return false;
+	}
+
+	if (objValue->empty()) {
+		return false;
+	}
+	return matches(instruction.operation, *objValue, instruction.loweredValue);
+}
+
 ObjectTreeFilter::ObjectTreeFilter() : ObjectTreeFilter::base_type(start) {
 	// keywords
 	name = qi::lit("name");
@@ -55,12 +169,6 @@ ObjectTreeFilter::ObjectTreeFilter() : ObjectTreeFilter::base_type(start) {
 	start = term[qi::_val = qi::_1] >> *(-qi::lit('|') >> term[qi::_val = phx::bind(&ObjectTreeFilter::filterOR, this, qi::_val, qi::_1)]);
 }
 
-std::string ObjectTreeFilter::toLower(const std::string& input) const {
-	std::string lowered = input;
-	std::transform(input.begin(), input.end(), lowered.begin(), [](unsigned char c) { return std::tolower(c); });
-	return lowered;
-}
-
 void ObjectTreeFilter::removeQuotes(std::string& s) const {
 	s.erase(std::remove(s.begin(), s.end(), '\''), s.end());
 }
@@ -77,29 +185,15 @@ void ObjectTreeFilter::removeTrailingSpaces(std::string& s) {
 	}
 }
 
-std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter::filterOR(
-	const std::function<bool(const model::ObjectTreeNode&)>& lhs,
-	const std::function<bool(const model::ObjectTreeNode&)>& rhs) const {
-	// Define a lambda function for the filtering logic
-	auto filterFunc = [lhs, rhs](const model::ObjectTreeNode& objectTreeNode) {
-		return lhs(objectTreeNode) || rhs(objectTreeNode);
-	};
-
-	return filterFunc;
+ObjectTreeFilterProgram ObjectTreeFilter::filterOR(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) const {
+	return ObjectTreeFilterProgram::combineOR(lhs, rhs);
 }
 
-std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter::filterAND(
-	const std::function<bool(const model::ObjectTreeNode&)>& lhs,
-	const std::function<bool(const model::ObjectTreeNode&)>& rhs) const {
-	// Define a lambda function for the filtering logic
-	auto filterFunc = [lhs, rhs](const model::ObjectTreeNode& objectTreeNode) {
-		return lhs(objectTreeNode) && rhs(objectTreeNode);
-	};
-
-	return filterFunc;
+ObjectTreeFilterProgram ObjectTreeFilter::filterAND(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) const {
+	return ObjectTreeFilterProgram::combineAND(lhs, rhs);
 }
 
-std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter::filterExpressionByDefaultKey(std::string op, std::string value, bool exact) const {
+ObjectTreeFilterProgram ObjectTreeFilter::filterExpressionByDefaultKey(std::string op, std::string value, bool exact) const {
 	switch (defaultFilterKeyColumn_) {
 		case model::ObjectTreeViewDefaultModel::ColumnIndex::COLUMNINDEX_NAME: {
 			return filterExpression("name", op, value, exact);
@@ -119,61 +213,34 @@ std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter:
 	}
 }
 
-std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter::filterExpression(std::string keyword, std::string op, std::string value, bool exact) const {
+ObjectTreeFilterProgram ObjectTreeFilter::filterExpression(std::string keyword, std::string op, std::string value, bool exact) const {
 	// Remove the single quotes from the parsed value if present
 	removeQuotes(value);
 	removeTrailingSpaces(value);
 
-	// Define a lambda function for the filtering logic
-	auto filterFunc = [this, keyword, op, value, exact](const model::ObjectTreeNode& objectTreeNode) {
-		if (keyword == "tag") {
-			const auto tags = objectTreeNode.getUserTags();
-			if (op == "=" && exact == true) {
-				return std::any_of(tags.begin(), tags.end(), [this, &value](const std::string& tag) {
-					return toLower(tag) == toLower(value);
-				});
-			}
-			if (op == "!=" && exact == true) {
-				return std::all_of(tags.begin(), tags.end(), [this, &value](const std::string& tag) {
-					return toLower(tag) != toLower(value);
-				});
-			}
-			if (op == "=") {
-				return std::any_of(tags.begin(), tags.end(), [this, &value](const std::string& tag) {
-					return toLower(tag).find(toLower(value)) != std::string::npos;
-				});
-			}
-			if (op == "!=") {
-				return std::all_of(tags.begin(), tags.end(), [this, &value](const std::string& tag) {
-					return toLower(tag).find(toLower(value)) == std::string::npos;
-				});
-			}
-		} else {
-			std::string objValue;
-			if (keyword == "name") objValue = objectTreeNode.getDisplayName();
-			if (keyword == "type") objValue = objectTreeNode.getDisplayType();
-			if (keyword == "id") objValue = objectTreeNode.getID();
-
-			if (!objValue.empty()) {
-				if (op == "=" && exact == true) {
-					return toLower(objValue) == toLower(value);
-				}
-				if (op == "!=" && exact == true) {
-					return toLower(objValue) != toLower(value);
-				}
-				if (op == "=") {
-					return toLower(objValue).find(toLower(value)) != std::string::npos;
-				}
-				if (op == "!=") {
-					return toLower(objValue).find(toLower(value)) == std::string::npos;
-				}
-			}
-		}
-		
-		return false;
-	};
+	ObjectTreeFilterProgram::Field field;
+	if (keyword == "tag") {
+		field = ObjectTreeFilterProgram::Field::Tag;
+	} else if (keyword == "name") {
+		field = ObjectTreeFilterProgram::Field::Name;
+	} else if (keyword == "type") {
+		field = ObjectTreeFilterProgram::Field::Type;
+	} else if (keyword == "id") {
+		field = ObjectTreeFilterProgram::Field::ID;
+	} else {
+		return {};
+	}
+
+	ObjectTreeFilterProgram::Operation operation;
+	if (op == "=") {
+		operation = exact ? ObjectTreeFilterProgram::Operation::Equal : ObjectTreeFilterProgram::Operation::Contains;
+	} else if (op == "!=") {
+		operation = exact ? ObjectTreeFilterProgram::Operation::NotEqual : ObjectTreeFilterProgram::Operation::NotContains;
+	} else {
+		return {};
+	}
 
-	return filterFunc;
+	return ObjectTreeFilterProgram::condition(field, operation, value);
 }
 
 void ObjectTreeFilter::setDefaultFilterKeyColumn(const int column) {
@@ -181,7 +248,7 @@ void ObjectTreeFilter::setDefaultFilterKeyColumn(const int column) {
 }
 
 std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter::parse(const std::string& input, FilterResult& filterResult) {
-	std::function<bool(const model::ObjectTreeNode&)> output{};
+	ObjectTreeFilterProgram output{};
 	filterResult = FilterResult::Failed;
 
 	try {
@@ -198,6 +265,9 @@ std::function<bool(const object_tree::model::ObjectTreeNode&)> ObjectTreeFilter:
 	} catch (...) {
 	}
 
+	if (output.empty()) {
+		return {};
+	}
 	return output;
 }
 
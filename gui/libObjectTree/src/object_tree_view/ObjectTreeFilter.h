@@ -132,15 +132,22 @@
  * The types of the local variables like qi::_1 should be also declared.This is done using the template arguments qi::locals.
  * See the example :
  * class ObjectTreeFilter : public qi::grammar<std::string::const_iterator,
- * 								std::function<bool(const model::ObjectTreeNode&)>(),
+ * 								ObjectTreeFilterProgram(),
  * 								qi::space_type,
- * 								qi::locals<std::function<bool(const model::ObjectTreeNode&)>>> {
+ * 								qi::locals<ObjectTreeFilterProgram>> {
  * };
  *
  * The result of the parsing as well as the type of the arguments are also defined here using the template arguments :
- * std::function<bool(const model::ObjectTreeNode&)>()
+ * ObjectTreeFilterProgram()
  * The separator between the words here is default and defined to be a white space : qi::space_type
  *
+ *
+ * 9. Compiled filter program
+ *
+ * The semantic actions don't create nested closures but build an ObjectTreeFilterProgram: the keyword and operation strings are
+ * resolved into enums and the filter values are converted to lowercase once while parsing. Evaluating the program for a tree node
+ * then only compares these literals against the lowercase fields cached in the ObjectTreeNode.
+ *
  */
 
 #pragma once
@@ -153,7 +160,9 @@
 #include <boost/phoenix/operator/self.hpp>
 #include <boost/spirit/include/qi.hpp>
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "object_tree_view_model/ObjectTreeViewDefaultModel.h"
 #include "object_tree_view_model/ObjectTreeViewSortProxyModels.h"
@@ -164,8 +173,64 @@ using EditorObject = core::EditorObject;
 namespace qi = boost::spirit::qi;
 namespace phx = boost::phoenix;
 
-class ObjectTreeFilter : public qi::grammar<std::string::const_iterator, std::function<bool(const model::ObjectTreeNode&)>(),
-							 qi::space_type, qi::locals<std::function<bool(const model::ObjectTreeNode&)>>> {
+/**
+ * Compiled form of a parsed filter expression.
+ *
+ * The expression tree is stored in a flat instruction list with the root instruction at the end. 
+ * AND and OR instructions refer to their operands by index and are evaluated with short-circuiting.
+ */
+class ObjectTreeFilterProgram {
+public:
+	enum class Field {
+		Name,
+		Type,
+		ID,
+		Tag
+	};
+
+	enum class Operation {
+		Contains,
+		NotContains,
+		Equal,
+		NotEqual
+	};
+
+	static ObjectTreeFilterProgram condition(Field field, Operation operation, const std::string& value);
+	static ObjectTreeFilterProgram combineAND(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs);
+	static ObjectTreeFilterProgram combineOR(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs);
+
+	bool empty() const;
+	size_t size() const;
+
+	bool operator()(const model::ObjectTreeNode& objectTreeNode) const;
+
+private:
+	enum class InstructionType {
+		Condition,
+		And,
+		Or
+	};
+
+	struct Instruction {
+		InstructionType type;
+		Field field;
+		Operation operation;
+		std::string loweredValue;
+		size_t lhs;
+		size_t rhs;
+	};
+
+	static ObjectTreeFilterProgram combine(InstructionType type, const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs);
+	static bool matches(Operation operation, const std::string& loweredObjectValue, const std::string& loweredValue);
+
+	bool evaluate(size_t index, const model::ObjectTreeNode& objectTreeNode) const;
+	bool evaluateCondition(const Instruction& instruction, const model::ObjectTreeNode& objectTreeNode) const;
+
+	std::vector<Instruction> instructions_;
+};
+
+class ObjectTreeFilter : public qi::grammar<std::string::const_iterator, ObjectTreeFilterProgram(),
+							 qi::space_type, qi::locals<ObjectTreeFilterProgram>> {
 public:
 	ObjectTreeFilter();
 
@@ -176,24 +241,19 @@ private:
 	qi::rule<std::string::const_iterator, std::string(), qi::space_type> name, type, id, tag, keyword;
 	qi::rule<std::string::const_iterator, std::string(), qi::space_type> equal, not_equal, operation;
 	qi::rule<std::string::const_iterator, std::string(), qi::space_type> value, value_single_quoted, value_double_quoted;
-	qi::rule<std::string::const_iterator, std::function<bool(const model::ObjectTreeNode&)>(), qi::space_type, qi::locals<std::function<bool(const model::ObjectTreeNode&)>>> expression, expression_no_key, expression_no_key_no_op;
-	qi::rule<std::string::const_iterator, std::function<bool(const model::ObjectTreeNode&)>(), qi::space_type, qi::locals<std::function<bool(const model::ObjectTreeNode&)>>> expression_exact, expression_exact_no_key, expression_exact_no_key_no_op;
-	qi::rule<std::string::const_iterator, std::function<bool(const model::ObjectTreeNode&)>(), qi::space_type, qi::locals<std::function<bool(const model::ObjectTreeNode&)>>> term, factor, start;
+	qi::rule<std::string::const_iterator, ObjectTreeFilterProgram(), qi::space_type, qi::locals<ObjectTreeFilterProgram>> expression, expression_no_key, expression_no_key_no_op;
+	qi::rule<std::string::const_iterator, ObjectTreeFilterProgram(), qi::space_type, qi::locals<ObjectTreeFilterProgram>> expression_exact, expression_exact_no_key, expression_exact_no_key_no_op;
+	qi::rule<std::string::const_iterator, ObjectTreeFilterProgram(), qi::space_type, qi::locals<ObjectTreeFilterProgram>> term, factor, start;
 
 	inline static int defaultFilterKeyColumn_ = 0;
 
-	std::string toLower(const std::string& input) const;
 	void removeQuotes(std::string& s) const;
 	static void removeTrailingSpaces(std::string& s);
 
-	std::function<bool(const model::ObjectTreeNode&)> filterOR(
-		const std::function<bool(const model::ObjectTreeNode&)>& lhs,
-		const std::function<bool(const model::ObjectTreeNode&)>& rhs) const;
-	std::function<bool(const model::ObjectTreeNode&)> filterAND(
-		const std::function<bool(const model::ObjectTreeNode&)>& lhs,
-		const std::function<bool(const model::ObjectTreeNode&)>& rhs) const;
-	std::function<bool(const model::ObjectTreeNode&)> filterExpressionByDefaultKey(std::string op, std::string value, bool exact) const;
-	std::function<bool(const model::ObjectTreeNode&)> filterExpression(std::string keyword, std::string op, std::string value, bool exact) const;
+	ObjectTreeFilterProgram filterOR(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) const;
+	ObjectTreeFilterProgram filterAND(const ObjectTreeFilterProgram& lhs, const ObjectTreeFilterProgram& rhs) const;
+	ObjectTreeFilterProgram filterExpressionByDefaultKey(std::string op, std::string value, bool exact) const;
+	ObjectTreeFilterProgram filterExpression(std::string keyword, std::string op, std::string value, bool exact) const;
 };
 
 }  // namespace raco::object_tree::view
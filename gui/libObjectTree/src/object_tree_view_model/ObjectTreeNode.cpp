@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <iterator>
 #include "core/ProxyTypes.h"
 
 namespace raco::object_tree::model {
@@ -202,6 +204,56 @@ std::vector<std::string> ObjectTreeNode::getUserTags() const {
 	return {};
 }
 
+std::string ObjectTreeNode::toLower(const std::string& input) {
+	std::string lowered = input;
+	std::transform(input.begin(), input.end(), lowered.begin(), [](unsigned char c) { return std::tolower(c); });
+	return lowered;
+}
+
+const std::string& ObjectTreeNode::updateLowerCaseCache(LowerCaseCacheEntry& entry, const std::string& source) {
+	if (!entry.valid || entry.source != source) {
+		entry.source = source;
+		entry.lowered = toLower(source);
+		entry.valid = true;
+	}
+	return entry.lowered;
+}
+
+const std::string& ObjectTreeNode::getLowerCaseDisplayName() const {
+	if (type_ == ObjectTreeNodeType::EditorObject) {
+		return updateLowerCaseCache(lowerCaseName_, representedObject_->objectName());
+	}
+	return updateLowerCaseCache(lowerCaseName_, getDisplayName());
+}
+
+const std::string& ObjectTreeNode::getLowerCaseDisplayType() const {
+	if (type_ == ObjectTreeNodeType::EditorObject) {
+		return updateLowerCaseCache(lowerCaseType_, representedObject_->getTypeDescription().typeName);
+	}
+	return updateLowerCaseCache(lowerCaseType_, getDisplayType());
+}
+
+const std::string& ObjectTreeNode::getLowerCaseID() const {
+	if (type_ == ObjectTreeNodeType::EditorObject) {
+		return updateLowerCaseCache(lowerCaseID_, representedObject_->objectID());
+	}
+	return updateLowerCaseCache(lowerCaseID_, getID());
+}
+
+const std::vector<std::string>& ObjectTreeNode::getLowerCaseUserTags() const {
+	if (type_ != ObjectTreeNodeType::EditorObject) {
+		return lowerCaseUserTags_;
+	}
+	const auto& tags = *representedObject_->as<user_types::BaseObject>()->userTags_;
+	if (!lowerCaseUserTagsValid_ || !tags.compare(userTagsSource_)) {
+		userTagsSource_ = tags.asVector<std::string>();
+		lowerCaseUserTags_.clear();
+		std::transform(userTagsSource_.begin(), userTagsSource_.end(), std::back_inserter(lowerCaseUserTags_), &ObjectTreeNode::toLower);
+		lowerCaseUserTagsValid_ = true;
+	}
+	return lowerCaseUserTags_;
+}
+
 SEditorObject ObjectTreeNode::getRepresentedObject() const {
 	return representedObject_;
 }
@@ -79,3 +79,67 @@ INSTANTIATE_TEST_SUITE_P(ParametricTests, ObjectTreeFilterTestFixture,
 		std::make_tuple(false, QString("(name = \"name5 (1)\" & (type ! Node)) | tag = 3"), QStringList({"id_01", "id_02", "id_03", "id_04", "id_05", "id_06", "id_07", "id_08", "id_09", "id_10"})),
 		std::make_tuple(true, QString("(name = '(1)' & (type != Node)) | tag = 'tag7 (3)'"), QStringList({"id_09", "id_10"})))
 );
+
+TEST(ObjectTreeFilterTest, compiledProgramMatchesLowerCaseFieldCache) {
+	using FilterResult = object_tree::view::FilterResult;
+
+	auto root = std::make_unique<ObjectTreeNode>(ObjectTreeNodeType::Root, nullptr);
+	auto node = std::make_shared<user_types::Node>("MyNode", "ID_Node");
+	node->userTags_->set(std::vector<std::string>{"Red", "Blue"});
+	auto treeNode = new ObjectTreeNode(node, root.get());
+
+	FilterResult filterResult;
+	object_tree::view::ObjectTreeFilter filter;
+	EXPECT_TRUE(filter.parse("name = mynode", filterResult)(*treeNode));
+	EXPECT_TRUE(filter.parse("type = \"node\" & tag = \"RED\"", filterResult)(*treeNode));
+	EXPECT_FALSE(filter.parse("tag = green", filterResult)(*treeNode));
+
+	// The cached lowercase fields need to follow changes of the represented object.
+	node->userTags_->set(std::vector<std::string>{"Green"});
+	node->objectName_ = std::string("Renamed");
+	EXPECT_TRUE(filter.parse("tag = green", filterResult)(*treeNode));
+	EXPECT_FALSE(filter.parse("name = mynode", filterResult)(*treeNode));
+	EXPECT_EQ(treeNode->getLowerCaseDisplayName(), "renamed");
+	EXPECT_EQ(treeNode->getLowerCaseUserTags(), std::vector<std::string>{"green"});
+}
+
+#ifdef NDEBUG
+class ObjectTreeFilterPerformanceTest : public RacoBaseTest<> {};
+
+TEST_F(ObjectTreeFilterPerformanceTest, filter_synthetic_tree_50k_nodes) {
+	using FilterResult = object_tree::view::FilterResult;
+	constexpr int NODE_COUNT = 50000;
+	constexpr int KEYSTROKES = 20;
+
+	auto root = std::make_unique<ObjectTreeNode>(ObjectTreeNodeType::Root, nullptr);
+	std::vector<ObjectTreeNode*> treeNodes;
+	treeNodes.reserve(NODE_COUNT);
+	auto parent = root.get();
+	for (int i = 0; i < NODE_COUNT; ++i) {
+		auto node = std::make_shared<user_types::Node>(fmt::format("Node_{}", i), fmt::format("id_{}", i));
+		node->userTags_->set(std::vector<std::string>{fmt::format("Tag_{}", i % 100), "Common"});
+		auto treeNode = new ObjectTreeNode(node, i % 10 == 0 ? root.get() : parent);
+		if (i % 10 == 0) {
+			parent = treeNode;
+		}
+		treeNodes.emplace_back(treeNode);
+	}
+
+	object_tree::view::ObjectTreeFilter filter;
+	FilterResult filterResult;
+	const std::string filterString = "(name = node_4 | tag = \"tag_42\") & type != \"Mesh\" & id != id_1";
+
+	size_t matches = 0;
+	assertOperationTimeIsBelow(2000, [&]() {
+		for (int keystroke = 1; keystroke <= KEYSTROKES; ++keystroke) {
+			auto filterFunction = filter.parse(filterString.substr(0, filterString.size() * keystroke / KEYSTROKES), filterResult);
+			if (filterFunction) {
+				for (auto treeNode : treeNodes) {
+					matches += filterFunction(*treeNode) ? 1 : 0;
+				}
+			}
+		}
+	});
+	EXPECT_GT(matches, 0);
+}
+#endif
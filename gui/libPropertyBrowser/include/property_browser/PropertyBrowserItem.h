@@ -24,6 +24,7 @@
 #include <QMetaMethod>
 #include <QObject>
 #include <QString>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -31,6 +32,7 @@ namespace raco::property_browser {
 class PropertyBrowserModel;
 
 class PropertyBrowserRef;
+class ReferenceCandidateIndex;
 
 // TODO create AbstractPropertyBrowserItem interface
 
@@ -129,6 +131,8 @@ public:
 	PropertyBrowserItem* siblingItem(std::string_view propertyName) const noexcept;
 	PropertyBrowserRef* refItem() noexcept;
 	PropertyBrowserModel* model() const noexcept;
+	/** Candidate index shared by all reference items below the root item; created on first use. */
+	ReferenceCandidateIndex& referenceCandidateIndex();
 	bool isRoot() const noexcept;
 	/** locates the firstitem in hierachy which has no collapsed parent (can be this) */
 	PropertyBrowserItem* findItemWithNoCollapsedParentInHierarchy() noexcept;
@@ -253,6 +257,8 @@ private:
 	std::vector<components::Subscription> childrenChangeSubs_;
 	// TOOD maybe find a better way!? currently needed for the object name display "error" item
 	std::vector<components::Subscription> objectNameChangeSubscriptions_;
+	components::Subscription beforeDispatchSub_;
+	std::shared_ptr<ReferenceCandidateIndex> referenceCandidateIndex_;
 
 	core::CommandInterface* commandInterface_;
 	components::SDataChangeDispatcher dispatcher_;
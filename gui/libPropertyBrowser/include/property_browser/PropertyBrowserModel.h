@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "core/PropertyStateCache.h"
+
 #include <QObject>
 
 namespace raco::property_browser {
@@ -23,8 +25,17 @@ class PropertyBrowserModel final : public QObject {
 public:
 	explicit PropertyBrowserModel(QObject* parent = nullptr) noexcept
 		: QObject{parent} {}
+
+	// Read-only and visibility state of the properties shared by all items using this model.
+	core::PropertyStateCache& propertyStateCache() noexcept {
+		return propertyStateCache_;
+	}
+
 Q_SIGNALS:
 	void selectionRequested(const QString objectID, const QString objectProperty = {});
+
+private:
+	core::PropertyStateCache propertyStateCache_;
 };
 
 }  // namespace raco::property_browser
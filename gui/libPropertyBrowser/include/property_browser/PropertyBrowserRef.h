@@ -24,13 +24,18 @@ namespace raco::property_browser {
 
 class PropertyBrowserItem;
 
+/**
+ * Reference value and reference target candidates of a PropertyBrowserItem.
+ *
+ * The candidate list is only built when it is requested, e.g. when the reference dropdown is opened. Project changes
+ * which can change the candidates only mark the list as outdated. Tooltips are calculated on demand as well.
+ */
 class PropertyBrowserRef final : public QObject {
 	Q_OBJECT
 public:
 	struct RefItem {
 		QString objName;
 		QString objId;
-		QString tooltipText;
 	};
 
 	using RefItems = std::vector<RefItem>;
@@ -39,31 +44,40 @@ public:
 
 	explicit PropertyBrowserRef(PropertyBrowserItem* parent);
 
-	const RefItems& items() const noexcept;
+	// Empty reference item followed by the valid reference targets sorted by name.
+	const RefItems& items() const;
+	// Item for the current value; the empty reference item if the value is empty, invalid or differs between the handles.
+	const RefItem& currentItem() const noexcept;
 	bool hasMultipleValues() const;
-	int currentIndex() noexcept;
+	bool isEmptyRef() const noexcept;
+	QString tooltipText(const RefItem& item) const;
 
-	Q_SIGNAL void indexChanged(int index);
-	Q_SIGNAL void itemsChanged(const RefItems& items);
+	Q_SIGNAL void currentChanged();
+	Q_SIGNAL void itemsChanged();
 
 	Q_SLOT void setIndex(int index) noexcept;
 
 protected:
-	void update() noexcept;
-	void updateItems() noexcept;
-	void updateIndex() noexcept;
+	void invalidateItems() noexcept;
+	void updateItems() const;
+	void updateCurrent() noexcept;
 
 private:
 	QString getEmptyRefDescription(const core::ValueHandle& handle);
+	QString displayName(const core::SEditorObject& object) const;
 
-	RefItems items_{};
-	int index_{0};
-	bool hasMultipleValues_;
+	mutable RefItems items_{};
+	mutable bool itemsDirty_{true};
+	bool candidatesChanged_{false};
+	RefItem emptyItem_;
+	RefItem currentItem_;
+	bool hasMultipleValues_{false};
 	PropertyBrowserItem* parent_;
 	std::vector<components::Subscription> subscriptions_;
 	components::Subscription lifecycleSub_;
 	components::Subscription childMoveSub_;
-	std::vector<components::Subscription> objectNames_;
+	components::Subscription objectNameSub_;
+	components::Subscription afterDispatchSub_;
 };
 
 }  // namespace raco::property_browser
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "components/DataChangeDispatcher.h"
+#include "core/EditorObject.h"
+#include "core/Handles.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace raco::core {
+class Project;
+}
+
+namespace raco::property_browser {
+
+/**
+ * Project instances grouped by type name for finding reference targets without scanning the whole project.
+ *
+ * The index is built from the project instances on construction and afterwards kept up to date using the
+ * object lifecycle events of the dispatcher.
+ */
+class ReferenceCandidateIndex {
+public:
+	ReferenceCandidateIndex(const core::Project* project, components::SDataChangeDispatcher dispatcher);
+
+	// Valid reference targets for the handle. Only the type groups which can be set as reference are checked.
+	std::vector<core::SEditorObject> findValidReferenceTargets(const core::ValueHandle& handle) const;
+
+private:
+	const core::Project* project_;
+	std::map<std::string, core::SEditorObjectSet> objectsByType_;
+	components::Subscription lifecycleSub_;
+};
+
+}  // namespace raco::property_browser
@@ -19,6 +19,7 @@
 #include "property_browser/PropertyBrowserRef.h"
 #include "property_browser/PropertyBrowserCache.h"
 #include "property_browser/PropertyCopyPaste.h"
+#include "property_browser/ReferenceCandidateIndex.h"
 
 #include "user_types/EngineTypeAnnotation.h"
 #include "user_types/LuaInterface.h"
@@ -66,6 +67,13 @@ PropertyBrowserItem::PropertyBrowserItem(
 
 	QObject::connect(&PropertyBrowserCache::instance(), &PropertyBrowserCache::newExpandedStateCached, this, &PropertyBrowserItem::onNewExpandedStateCached);
 
+	if (!parentItem_ && model_) {
+		// Invalidate the cached property states before any item is notified about the changes.
+		beforeDispatchSub_ = dispatcher_->registerOnBeforeDispatch([this](const core::DataChangeRecorder& changes) {
+			model_->propertyStateCache().invalidate(changes);
+		});
+	}
+
 	const auto commonValueHandles = getCommonValueHandles(valueHandles_);
 	for (auto& commonHandleForSeveralObjects : commonValueHandles) {
 		children_.push_back(new PropertyBrowserItem(commonHandleForSeveralObjects, dispatcher_, commandInterface_, model_, sceneBackend_, this));
@@ -225,7 +233,9 @@ PropertyBrowserItem::PropertyBrowserItem(
 }
 
 bool PropertyBrowserItem::isHidden(core::ValueHandle handle, bool isMultiSelect) const {
-	if (core::Queries::isHiddenInPropertyBrowser(*commandInterface_->project(), handle, isMultiSelect)) {
+	// Items created without a model (e.g. standalone editors) don't use the cache.
+	if (model_ ? model_->propertyStateCache().isHiddenInPropertyBrowser(*commandInterface_->project(), handle, isMultiSelect)
+			   : core::Queries::isHiddenInPropertyBrowser(*commandInterface_->project(), handle, isMultiSelect)) {
 		return true;
 	}
 
@@ -493,6 +503,14 @@ PropertyBrowserModel* PropertyBrowserItem::model() const noexcept {
 	return model_;
 }
 
+ReferenceCandidateIndex& PropertyBrowserItem::referenceCandidateIndex() {
+	auto root = rootItem();
+	if (!root->referenceCandidateIndex_) {
+		root->referenceCandidateIndex_ = std::make_shared<ReferenceCandidateIndex>(project(), dispatcher_);
+	}
+	return *root->referenceCandidateIndex_;
+}
+
 const QList<PropertyBrowserItem*>& PropertyBrowserItem::children() {
 	return children_;
 }
@@ -683,7 +701,8 @@ core::EngineInterface& PropertyBrowserItem::engineInterface() const {
 
 bool PropertyBrowserItem::editable() noexcept {
 	return std::all_of(valueHandles_.begin(), valueHandles_.end(), [this](const core::ValueHandle& handle) {
-		return !core::Queries::isReadOnly(*commandInterface_->project(), handle);
+		return !(model_ ? model_->propertyStateCache().isReadOnly(*commandInterface_->project(), handle)
+						: core::Queries::isReadOnly(*commandInterface_->project(), handle));
 	});
 }
 
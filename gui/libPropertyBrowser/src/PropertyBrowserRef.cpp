@@ -13,6 +13,7 @@
 #include "core/Project.h"
 #include "property_browser/PropertyBrowserItem.h"
 #include "property_browser/PropertyBrowserUtilities.h"
+#include "property_browser/ReferenceCandidateIndex.h"
 
 namespace raco::property_browser {
 
@@ -20,31 +21,64 @@ PropertyBrowserRef::PropertyBrowserRef(PropertyBrowserItem* parent)
 	: QObject{parent},
 	  parent_{parent}
  {
+	// fill empty description if it's equal for all handles
+	QString emptyRefDescription = getEmptyRefDescription(*parent_->valueHandles().begin());
+	if (std::all_of(++parent_->valueHandles().begin(), parent_->valueHandles().end(), [this, &emptyRefDescription](const core::ValueHandle& handle) {
+			return emptyRefDescription == getEmptyRefDescription(handle);
+		})) {
+		emptyItem_ = {emptyRefDescription, ""};
+	} else {
+		emptyItem_ = {"<empty>", ""};
+	}
+
 	std::for_each(parent_->valueHandles().begin(), parent_->valueHandles().end(), [this](const core::ValueHandle& handle) {
 		subscriptions_.emplace_back(components::Subscription{parent_->dispatcher()->registerOn(handle, [this]() {
-			updateIndex();
-			Q_EMIT indexChanged(index_);
+			updateCurrent();
 		})});
 	});
-	lifecycleSub_ = {parent->dispatcher()->registerOnObjectsLifeCycle([this](auto) { update(); }, [this](auto) { update(); })};
-	childMoveSub_ = {parent->dispatcher()->registerOnPropertyChange("children", [this](core::ValueHandle handle) { update(); })};
-	update();
+	// Creating, deleting, moving and renaming objects can change the candidates, their order or the validity of the current value.
+	// The items are only invalidated after the dispatch when the ReferenceCandidateIndex has seen all lifecycle changes.
+	lifecycleSub_ = {parent->dispatcher()->registerOnObjectsLifeCycle([this](auto) { candidatesChanged_ = true; }, [this](auto) { candidatesChanged_ = true; })};
+	childMoveSub_ = {parent->dispatcher()->registerOnPropertyChange("children", [this](core::ValueHandle handle) { candidatesChanged_ = true; })};
+	objectNameSub_ = {parent->dispatcher()->registerOnPropertyChange("objectName", [this](core::ValueHandle handle) { candidatesChanged_ = true; })};
+	afterDispatchSub_ = {parent->dispatcher()->registerOnAfterDispatch([this]() {
+		if (candidatesChanged_) {
+			candidatesChanged_ = false;
+			invalidateItems();
+		}
+	})};
+	updateCurrent();
 }
 
-const PropertyBrowserRef::RefItems& PropertyBrowserRef::items() const noexcept {
+const PropertyBrowserRef::RefItems& PropertyBrowserRef::items() const {
+	if (itemsDirty_) {
+		updateItems();
+	}
 	return items_;
 }
 
-int PropertyBrowserRef::currentIndex() noexcept {
-	return index_;
+const PropertyBrowserRef::RefItem& PropertyBrowserRef::currentItem() const noexcept {
+	return currentItem_;
 }
 
-void PropertyBrowserRef::update() noexcept {
+bool PropertyBrowserRef::isEmptyRef() const noexcept {
+	return currentItem_.objId.isEmpty();
+}
+
+QString PropertyBrowserRef::tooltipText(const RefItem& item) const {
+	if (!item.objId.isEmpty()) {
+		if (auto object = parent_->project()->getInstanceByID(item.objId.toStdString())) {
+			return QString::fromStdString(core::Queries::getFullObjectHierarchyPath(object));
+		}
+	}
+	return {};
+}
+
+void PropertyBrowserRef::invalidateItems() noexcept {
 	if (parent_->isValid()) {
-		updateItems();
-		updateIndex();
-		Q_EMIT itemsChanged(items_);
-		Q_EMIT indexChanged(index_);
+		itemsDirty_ = true;
+		updateCurrent();
+		Q_EMIT itemsChanged();
 	}
 }
 
@@ -57,74 +91,54 @@ QString PropertyBrowserRef::getEmptyRefDescription(const core::ValueHandle& hand
 	return "<empty>";
 }
 
-void PropertyBrowserRef::updateItems() noexcept {
-	objectNames_.clear();
-	items_.clear();
-
-	// fill empty description if it's equal for all handles
-	QString emptyRefDescription = getEmptyRefDescription(*parent_->valueHandles().begin());
-
-	if (std::all_of(++parent_->valueHandles().begin(), parent_->valueHandles().end(), [this, &emptyRefDescription](const core::ValueHandle& handle) {
-			return emptyRefDescription == getEmptyRefDescription(handle);
-		})) {
-		items_.push_back({emptyRefDescription, "", ""});
-	} else {
-		items_.push_back({"<empty>", "", ""});
+QString PropertyBrowserRef::displayName(const core::SEditorObject& object) const {
+	auto projName = parent_->project()->getProjectNameForObject(object, false);
+	if (!projName.empty()) {
+		return QString::fromStdString(fmt::format("{} [{}]", object->objectName(), projName));
 	}
+	return QString::fromStdString(object->objectName());
+}
+
+void PropertyBrowserRef::updateItems() const {
+	items_.clear();
+	items_.push_back(emptyItem_);
 
+	auto& candidateIndex = parent_->referenceCandidateIndex();
 	auto validReferenceTargets = map_reduce<std::vector<core::SEditorObject>>(
 		parent_->valueHandles(),
 		intersection<std::vector<core::SEditorObject>>,
-		[this](auto handle) {
-			return sorted(core::Queries::findAllValidReferenceTargets(*parent_->project(), handle));
+		[&candidateIndex](auto handle) {
+			return sorted(candidateIndex.findValidReferenceTargets(handle));
 		});
 	
 	std::sort(validReferenceTargets.begin(), validReferenceTargets.end(), [](const auto& lhs, const auto& rhs) { return lhs->objectName() < rhs->objectName(); });
 
-	// fill items and object names
 	for (const auto& instance : validReferenceTargets) {
-		auto projName = parent_->project()->getProjectNameForObject(instance, false);
-		const auto& objName = instance->objectName();
-		std::string displayObjectName;
-		std::string tooltip;
-
-		if (!projName.empty()) {
-			displayObjectName = fmt::format("{} [{}]", objName, projName);
-		} else {
-			displayObjectName = objName;
-		}
-
-		tooltip = core::Queries::getFullObjectHierarchyPath(instance);
-
-		items_.push_back({displayObjectName.c_str(), instance->objectID().c_str(), tooltip.c_str()});
-		// This seems a little bit of an overkill
-		objectNames_.push_back(parent_->dispatcher()->registerOn({instance, {"objectName"}}, [this]() { update(); }));
+		items_.push_back({displayName(instance), QString::fromStdString(instance->objectID())});
 	}
+	itemsDirty_ = false;
 }
 
-void PropertyBrowserRef::updateIndex() noexcept {
+void PropertyBrowserRef::updateCurrent() noexcept {
 	if (parent_->isValid()) {
 		auto value = parent_->asRef();
 		if (value.has_value()) {
 			hasMultipleValues_ = false;
 
 			auto refValue = value.value();
-			if (refValue == nullptr) {
-				index_ = EMPTY_REF_INDEX;
+			// Values which are not valid reference targets are shown as empty reference like in the candidate list.
+			if (refValue && std::all_of(parent_->valueHandles().begin(), parent_->valueHandles().end(), [this, &refValue](const core::ValueHandle& handle) {
+					return core::Queries::isValidReferenceTarget(*parent_->project(), handle, refValue);
+				})) {
+				currentItem_ = {displayName(refValue), QString::fromStdString(refValue->objectID())};
 			} else {
-				auto it = std::find_if(items_.begin(), items_.end(), [this, refValue](const auto& item) {
-					return item.objId == refValue->objectID().c_str();
-				});
-				if (it == items_.end()) {
-					index_ = EMPTY_REF_INDEX;
-				} else {
-					index_ = std::distance(items_.begin(), it);
-				}
+				currentItem_ = emptyItem_;
 			}
 		} else {
 			hasMultipleValues_ = true;
-			index_ = EMPTY_REF_INDEX;
+			currentItem_ = emptyItem_;
 		}
+		Q_EMIT currentChanged();
 	}
 }
 
@@ -136,7 +150,7 @@ void PropertyBrowserRef::setIndex(int index) noexcept {
 	if (index == EMPTY_REF_INDEX) {
 		parent_->set(core::SEditorObject{});
 	} else {
-		auto objectId = items_.at(index).objId.toStdString();
+		auto objectId = items().at(index).objId.toStdString();
 		core::SEditorObject object = parent_->project()->getInstanceByID(objectId);
 		parent_->set(object);
 	}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "property_browser/ReferenceCandidateIndex.h"
+
+#include "core/Project.h"
+#include "core/Queries.h"
+
+namespace raco::property_browser {
+
+ReferenceCandidateIndex::ReferenceCandidateIndex(const core::Project* project, components::SDataChangeDispatcher dispatcher)
+	: project_(project) {
+	for (const auto& instance : project_->instances()) {
+		objectsByType_[instance->getTypeDescription().typeName].insert(instance);
+	}
+	lifecycleSub_ = dispatcher->registerOnObjectsLifeCycle(
+		[this](core::SEditorObject object) {
+			objectsByType_[object->getTypeDescription().typeName].insert(object);
+		},
+		[this](core::SEditorObject object) {
+			auto it = objectsByType_.find(object->getTypeDescription().typeName);
+			if (it != objectsByType_.end()) {
+				it->second.erase(object);
+				if (it->second.empty()) {
+					objectsByType_.erase(it);
+				}
+			}
+		});
+}
+
+std::vector<core::SEditorObject> ReferenceCandidateIndex::findValidReferenceTargets(const core::ValueHandle& handle) const {
+	std::vector<core::SEditorObject> candidates;
+	for (const auto& [typeName, objects] : objectsByType_) {
+		// Reference compatibility only depends on the object type, so one object decides for the whole group.
+		if (handle.constValueRef()->canSetRef(*objects.begin())) {
+			for (const auto& object : objects) {
+				// Deletions are only reported at the next dispatch.
+				if (project_->isInstance(object)) {
+					candidates.emplace_back(object);
+				}
+			}
+		}
+	}
+	return core::Queries::findValidReferenceTargets(*project_, handle, candidates);
+}
+
+}  // namespace raco::property_browser
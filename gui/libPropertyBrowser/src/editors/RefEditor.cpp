@@ -32,7 +32,7 @@ namespace raco::property_browser {
 using namespace style;
 
 class RefEditorPopup : public PropertyBrowserEditorPopup {
-	QMetaObject::Connection indexChangedConnection_;
+	QMetaObject::Connection currentChangedConnection_;
 
 public:
 	class RefSearchView : public ObjectSearchView {
@@ -47,7 +47,7 @@ public:
 			rebuild();
 			updateSelection();
 
-			itemsChangedConnection_ = QObject::connect(ref_, &PropertyBrowserRef::itemsChanged, [this](auto) {
+			itemsChangedConnection_ = QObject::connect(ref_, &PropertyBrowserRef::itemsChanged, [this]() {
 				rebuild();
 			});
 		}
@@ -77,13 +77,13 @@ public:
 		deleteButton_.setIcon(Icons::instance().remove);
 		update();
 
-		indexChangedConnection_ = QObject::connect(item->refItem(), &PropertyBrowserRef::indexChanged, [this](auto) {
+		currentChangedConnection_ = QObject::connect(item->refItem(), &PropertyBrowserRef::currentChanged, [this]() {
 			update();
 		});
 	}
 
 	~RefEditorPopup() {
-		QObject::disconnect(indexChangedConnection_);
+		QObject::disconnect(currentChangedConnection_);
 	}
 
 protected:
@@ -102,9 +102,8 @@ protected:
 		if (item_->refItem()->hasMultipleValues()) {
 			currentRelation_.setText(PropertyBrowserItem::MultipleValueText);
 		} else {
-			const bool hasRef = (item_->refItem()->currentIndex() != PropertyBrowserRef::EMPTY_REF_INDEX);
-			if (hasRef) {
-				currentRelation_.setText(item_->refItem()->items().at(item_->refItem()->currentIndex()).objName);
+			if (!item_->refItem()->isEmptyRef()) {
+				currentRelation_.setText(item_->refItem()->currentItem().objName);
 			} else {
 				currentRelation_.setVisible(false);
 				deleteButton_.setVisible(false);
@@ -140,10 +139,10 @@ RefEditor::RefEditor(
 	QObject::connect(currentRef_, &QLineEdit::customContextMenuRequested, this, &RefEditor::createCustomContextMenu);
 
 	QObject::connect(goToRefObjectButton_, &QPushButton::clicked, [this, item]() {
-		item->model()->Q_EMIT selectionRequested(ref_->items().at(ref_->currentIndex()).objId);
+		item->model()->Q_EMIT selectionRequested(ref_->currentItem().objId);
 	});
 
-	QObject::connect(ref_, &PropertyBrowserRef::indexChanged, [this](auto index) {
+	QObject::connect(ref_, &PropertyBrowserRef::currentChanged, [this]() {
 		updateRef();
 	});
 
@@ -155,8 +154,7 @@ RefEditor::RefEditor(
 	QObject::connect(item, &PropertyBrowserItem::editableChanged, this, [this]() {
 		currentRef_->setEnabled(item_->editable());
 		changeRefButton_->setEnabled(item_->editable());
-		auto emptyReference = (ref_->currentIndex() == PropertyBrowserRef::EMPTY_REF_INDEX);
-		goToRefObjectButton_->setDisabled(emptyReference || ref_->hasMultipleValues());
+		goToRefObjectButton_->setDisabled(ref_->isEmptyRef() || ref_->hasMultipleValues());
 	});
 }
 
@@ -165,11 +163,10 @@ void RefEditor::updateRef() {
 		currentRef_->setText(PropertyBrowserItem::MultipleValueText);
 		currentRef_->setToolTip(PropertyBrowserItem::MultipleValueText);
 	} else {
-		currentRef_->setText(ref_->items().at(ref_->currentIndex()).objName);
-		currentRef_->setToolTip(ref_->items().at(ref_->currentIndex()).tooltipText);
+		currentRef_->setText(ref_->currentItem().objName);
+		currentRef_->setToolTip(ref_->tooltipText(ref_->currentItem()));
 	}
-	auto emptyReference = (ref_->currentIndex() == PropertyBrowserRef::EMPTY_REF_INDEX);
-	goToRefObjectButton_->setDisabled(emptyReference || ref_->hasMultipleValues());
+	goToRefObjectButton_->setDisabled(ref_->isEmptyRef() || ref_->hasMultipleValues());
 	currentRef_->update();
 }
 
@@ -220,7 +217,7 @@ void RefEditor::createCustomContextMenu(const QPoint& p) {
 		auto* setRefAction = lineEditMenu->addAction(QString("Set Reference to Copied Object %1").arg(validRefTargets.front().first.objName), [this, &validRefTargets]() {
 			ref_->setIndex(validRefTargets.front().second);
 		});
-		setRefAction->setToolTip(validRefTargets.front().first.tooltipText);
+		setRefAction->setToolTip(ref_->tooltipText(validRefTargets.front().first));
 	} else if (validRefTargets.size() > 1) {
 		auto setReferenceMenu = lineEditMenu->addMenu("Set Reference to Copied Objects...");
 		setReferenceMenu->setToolTipsVisible(true);
@@ -229,7 +226,7 @@ void RefEditor::createCustomContextMenu(const QPoint& p) {
 			auto* setRefAction = setReferenceMenu->addAction(validRefTarget.first.objName, [this, &validRefTarget]() {
 				ref_->setIndex(validRefTarget.second);
 			});
-			setRefAction->setToolTip(validRefTarget.first.tooltipText);
+			setRefAction->setToolTip(ref_->tooltipText(validRefTarget.first));
 		}
 	}
 
@@ -261,4 +261,55 @@ TEST_F(RefEditorTest, paste_property_target_invalid) {
 	EXPECT_FALSE(refEditor.isRefEmpty());
 }
 
+TEST_F(RefEditorTest, candidates_follow_object_changes) {
+	commandInterface.set(handle_1, prefab_3);
+	dispatch();
+
+	PropertyBrowserItem item{{handle_1}, dataChangeDispatcher, &commandInterface, nullptr};
+	const auto refEditor = ExposedRefEditor(&item);
+
+	EXPECT_EQ(refEditor.getRefItems(), QStringList({"<empty>", "prefab_2", "prefab_3", "prefab_4"}));
+
+	auto prefab_5 = create<Prefab>("prefab_5");
+	commandInterface.set({prefab_3, {"objectName"}}, std::string("prefab_0"));
+	dispatch();
+
+	EXPECT_EQ(refEditor.getRefItems(), QStringList({"<empty>", "prefab_0", "prefab_2", "prefab_4", "prefab_5"}));
+	EXPECT_EQ(refEditor.getCurrentRefText(), "prefab_0");
+	EXPECT_EQ(refEditor.getCurrentRefToolTip(), "prefab_0");
+
+	commandInterface.deleteObjects({prefab_3, prefab_4});
+	dispatch();
+
+	EXPECT_EQ(refEditor.getRefItems(), QStringList({"<empty>", "prefab_2", "prefab_5"}));
+	EXPECT_EQ(refEditor.getCurrentRefText(), "<empty>");
+	EXPECT_FALSE(refEditor.isGoToRefButtonEnabled());
+}
+
+TEST_F(RefEditorTest, candidates_are_current_in_items_changed) {
+	PropertyBrowserItem item{{handle_1}, dataChangeDispatcher, &commandInterface, nullptr};
+	const auto refEditor = ExposedRefEditor(&item);
+	EXPECT_EQ(refEditor.getRefItems(), QStringList({"<empty>", "prefab_2", "prefab_3", "prefab_4"}));
+
+	// Views like the reference popup rebuild their list synchronously when the items change.
+	QStringList itemsSeen;
+	QObject::connect(item.refItem(), &PropertyBrowserRef::itemsChanged, [&item, &itemsSeen]() {
+		itemsSeen.clear();
+		for (const auto& refItem : item.refItem()->items()) {
+			itemsSeen.append(refItem.objName);
+		}
+	});
+
+	create<Prefab>("prefab_5");
+	dispatch();
+
+	EXPECT_EQ(itemsSeen, QStringList({"<empty>", "prefab_2", "prefab_3", "prefab_4", "prefab_5"}));
+	EXPECT_EQ(refEditor.getRefItems(), QStringList({"<empty>", "prefab_2", "prefab_3", "prefab_4", "prefab_5"}));
+
+	commandInterface.deleteObjects({prefab_4});
+	dispatch();
+
+	EXPECT_EQ(itemsSeen, QStringList({"<empty>", "prefab_2", "prefab_3", "prefab_5"}));
+}
+
 }  // namespace raco::property_browser
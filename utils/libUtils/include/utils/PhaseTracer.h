@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace raco::utils {
+
+/**
+ * @brief Collects timed phases, e.g. of the project load pipeline, for performance analysis.
+ *
+ * Phases are recorded with ScopedPhase. Each phase has a category, e.g. "load" for the pipeline steps or
+ * "createAdaptor" for the per-object work, and a name, e.g. the pipeline step or the object type name.
+ * The recorded phases can be written as Chrome trace JSON (viewable in chrome://tracing or Perfetto) and are
+ * aggregated per category and name.
+ *
+ * Tracing is disabled by default; a disabled tracer only costs a single atomic load per ScopedPhase.
+ * Thread-safe.
+ */
+class PhaseTracer {
+public:
+	// Individual events beyond this number are dropped; they are still included in the aggregates.
+	static constexpr size_t MAX_EVENTS = 1000000;
+
+	struct Event {
+		std::string category;
+		std::string name;
+		// Start time and duration in microseconds relative to the time the tracer was enabled
+		int64_t start;
+		int64_t duration;
+		uint32_t threadIndex;
+	};
+
+	struct Aggregate {
+		size_t count = 0;
+		int64_t total = 0;
+		int64_t max = 0;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	static PhaseTracer& instance();
+
+	bool enabled() const {
+		return enabled_.load(std::memory_order_relaxed);
+	}
+
+	// Enabling the tracer clears all previously recorded phases.
+	void setEnabled(bool enabled);
+	void clear();
+
+	void record(std::string_view category, std::string_view name, Clock::time_point start, Clock::time_point end);
+
+	std::vector<Event> events() const;
+	// Aggregated durations in microseconds per (category, name)
+	std::map<std::pair<std::string, std::string>, Aggregate> aggregates() const;
+	size_t droppedEvents() const;
+
+	std::string chromeTraceJson() const;
+	bool writeChromeTrace(const std::string& path) const;
+
+	// Multi-line table of the aggregates sorted by category and descending total duration.
+	std::string summary() const;
+
+private:
+	uint32_t threadIndexLocked(std::thread::id id);
+
+	std::atomic<bool> enabled_{false};
+	mutable std::mutex mutex_;
+	Clock::time_point origin_{Clock::now()};
+	std::vector<Event> events_;
+	std::map<std::pair<std::string, std::string>, Aggregate> aggregates_;
+	std::map<std::thread::id, uint32_t> threadIndices_;
+	size_t droppedEvents_ = 0;
+};
+
+/**
+ * @brief Records the lifetime of the object as a phase in the PhaseTracer if tracing is enabled.
+ *
+ * The category and name are not copied and need to stay valid until the end of the scope.
+ */
+class ScopedPhase {
+public:
+	ScopedPhase(std::string_view category, std::string_view name) {
+		if (PhaseTracer::instance().enabled()) {
+			category_ = category;
+			name_ = name;
+			start_ = PhaseTracer::Clock::now();
+			active_ = true;
+		}
+	}
+
+	~ScopedPhase() {
+		if (active_) {
+			PhaseTracer::instance().record(category_, name_, start_, PhaseTracer::Clock::now());
+		}
+	}
+
+	ScopedPhase(const ScopedPhase&) = delete;
+	ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+private:
+	std::string_view category_;
+	std::string_view name_;
+	PhaseTracer::Clock::time_point start_;
+	bool active_ = false;
+};
+
+}  // namespace raco::utils
@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "u8path.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace raco::utils {
+
+// Immutable text shared between all users of identical contents.
+using SharedText = std::shared_ptr<const std::string>;
+
+/**
+ * @brief Content-addressed store for shader and script source texts.
+ *
+ * Identical texts are only held once in memory no matter how many objects use them. The store only keeps weak
+ * references: a text is released when the last user drops it.
+ * Thread-safe.
+ */
+class SourceTextStore {
+public:
+	struct Statistics {
+		// Number of read and intern calls
+		size_t requests = 0;
+		// Number of requests which returned an already stored text
+		size_t hits = 0;
+		// Number and total size of the distinct texts currently in use
+		size_t uniqueTexts = 0;
+		size_t uniqueBytes = 0;
+		// Total size of the texts summed over all current users, i.e. the memory needed without sharing
+		size_t referencedBytes = 0;
+
+		double deduplicationRatio() const {
+			return uniqueBytes > 0 ? static_cast<double>(referencedBytes) / static_cast<double>(uniqueBytes) : 1.0;
+		}
+	};
+
+	static SourceTextStore& instance();
+
+	// Read the file contents and return the shared text; nullptr if the file can't be read.
+	SharedText read(const u8path& path);
+	// Same as read but returns the empty text if the file can't be read, like utils::file::read.
+	SharedText readOrEmpty(const u8path& path);
+
+	// Return the shared text with the given contents.
+	SharedText intern(std::string text);
+
+	Statistics statistics() const;
+
+private:
+	SharedText internLocked(std::string&& text);
+	void removeExpiredLocked();
+
+	mutable std::mutex mutex_;
+
+	// Content hash -> text. Multiple entries per hash are possible in case of hash collisions.
+	std::unordered_multimap<size_t, std::weak_ptr<const std::string>> texts_;
+	// Last text read from each file; allows to skip the hashing if the file has not changed.
+	std::unordered_map<std::string, std::weak_ptr<const std::string>> files_;
+
+	size_t requests_ = 0;
+	size_t hits_ = 0;
+	size_t insertionsSinceCleanup_ = 0;
+};
+
+}  // namespace raco::utils
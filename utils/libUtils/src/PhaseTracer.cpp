@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "utils/PhaseTracer.h"
+
+#include "utils/u8path.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace raco::utils {
+
+namespace {
+
+std::string escapeJson(std::string_view text) {
+	std::string result;
+	result.reserve(text.size());
+	for (char c : text) {
+		switch (c) {
+			case '"':
+				result += "\\\"";
+				break;
+			case '\\':
+				result += "\\\\";
+				break;
+			case '\n':
+				result += "\\n";
+				break;
+			case '\t':
+				result += "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20) {
+					result += fmt::format("\\u{:04x}", static_cast<int>(c));
+				} else {
+					result += c;
+				}
+		}
+	}
+	return result;
+}
+
+}  // namespace
+
+PhaseTracer& PhaseTracer::instance() {
+	static PhaseTracer tracer;
+	return tracer;
+}
+
+void PhaseTracer::setEnabled(bool enabled) {
+	if (enabled) {
+		clear();
+	}
+	enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void PhaseTracer::clear() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	origin_ = Clock::now();
+	events_.clear();
+	aggregates_.clear();
+	threadIndices_.clear();
+	droppedEvents_ = 0;
+}
+
+uint32_t PhaseTracer::threadIndexLocked(std::thread::id id) {
+	auto it = threadIndices_.find(id);
+	if (it == threadIndices_.end()) {
+		it = threadIndices_.emplace(id, static_cast<uint32_t>(threadIndices_.size()) + 1).first;
+	}
+	return it->second;
+}
+
+void PhaseTracer::record(std::string_view category, std::string_view name, Clock::time_point start, Clock::time_point end) {
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto& aggregate = aggregates_[{std::string(category), std::string(name)}];
+	aggregate.count++;
+	aggregate.total += duration;
+	aggregate.max = std::max(aggregate.max, static_cast<int64_t>(duration));
+
+	if (events_.size() < MAX_EVENTS) {
+		events_.emplace_back(Event{std::string(category), std::string(name),
+			std::chrono::duration_cast<std::chrono::microseconds>(start - origin_).count(), duration,
+			threadIndexLocked(std::this_thread::get_id())});
+	} else {
+		++droppedEvents_;
+	}
+}
+
+std::vector<PhaseTracer::Event> PhaseTracer::events() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return events_;
+}
+
+std::map<std::pair<std::string, std::string>, PhaseTracer::Aggregate> PhaseTracer::aggregates() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return aggregates_;
+}
+
+size_t PhaseTracer::droppedEvents() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return droppedEvents_;
+}
+
+std::string PhaseTracer::chromeTraceJson() const {
+	auto allEvents = events();
+
+	// Enclosing phases start first; ordering them before the nested phases with the same start time keeps the viewers happy.
+	std::stable_sort(allEvents.begin(), allEvents.end(), [](const Event& left, const Event& right) {
+		return left.start < right.start || (left.start == right.start && left.duration > right.duration);
+	});
+
+	std::string result = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (size_t index = 0; index < allEvents.size(); index++) {
+		const auto& event = allEvents[index];
+		result += fmt::format("{}\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":1,\"tid\":{}}}",
+			index > 0 ? "," : "", escapeJson(event.name), escapeJson(event.category), event.start, event.duration, event.threadIndex);
+	}
+	result += "\n]}\n";
+	return result;
+}
+
+bool PhaseTracer::writeChromeTrace(const std::string& path) const {
+	std::ofstream out(u8path(path).internalPath(), std::ios::out | std::ios::trunc);
+	if (!out.is_open()) {
+		return false;
+	}
+	out << chromeTraceJson();
+	return out.good();
+}
+
+std::string PhaseTracer::summary() const {
+	auto allAggregates = aggregates();
+
+	std::vector<std::pair<std::pair<std::string, std::string>, Aggregate>> sorted(allAggregates.begin(), allAggregates.end());
+	std::stable_sort(sorted.begin(), sorted.end(), [](const auto& left, const auto& right) {
+		return left.first.first < right.first.first || (left.first.first == right.first.first && left.second.total > right.second.total);
+	});
+
+	std::string result = fmt::format("{:<24} {:<40} {:>8} {:>12} {:>12}", "Category", "Name", "Count", "Total [ms]", "Max [ms]");
+	for (const auto& [key, aggregate] : sorted) {
+		result += fmt::format("\n{:<24} {:<40} {:>8} {:>12.3f} {:>12.3f}", key.first, key.second, aggregate.count, aggregate.total / 1000.0, aggregate.max / 1000.0);
+	}
+	return result;
+}
+
+}  // namespace raco::utils
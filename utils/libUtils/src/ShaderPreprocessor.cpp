@@ -9,7 +9,8 @@
  */
 #include "utils/ShaderPreprocessor.h"
 
-#include <fstream>
+#include "utils/SourceTextStore.h"
+
 #include <sstream>
 #include <regex>
 
@@ -112,11 +113,12 @@ bool ShaderPreprocessor::traverseIncludedFiles(const std::string& filePath, std:
 	// Specified path does not have to exist. File is reported as included anyway to set file watchers.
 	includedFiles_.emplace(filePath);
 
-	std::ifstream shaderFile(u8path(filePath).internalPath());
-	if (!shaderFile.is_open()) {
+	auto shaderText = SourceTextStore::instance().read(u8path(filePath));
+	if (!shaderText) {
 		error_ = fmt::format("Cannot open file: '{}'", filePath);
 		return false;
 	}
+	std::istringstream shaderFile(*shaderText);
 
 	std::string line;
 	while (std::getline(shaderFile, line)) {
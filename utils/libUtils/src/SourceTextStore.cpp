@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "utils/SourceTextStore.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace raco::utils {
+
+namespace {
+// Expired entries are removed after this many insertions to keep the maps from growing indefinitely.
+constexpr size_t CLEANUP_INTERVAL = 1024;
+}  // namespace
+
+SourceTextStore& SourceTextStore::instance() {
+	static SourceTextStore store;
+	return store;
+}
+
+SharedText SourceTextStore::read(const u8path& path) {
+	std::ifstream in{path.internalPath(), std::ifstream::in};
+	if (!in.is_open()) {
+		return nullptr;
+	}
+	std::stringstream ss{};
+	ss << in.rdbuf();
+	auto contents = ss.str();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	auto& fileEntry = files_[path.string()];
+	if (auto previous = fileEntry.lock(); previous && *previous == contents) {
+		++requests_;
+		++hits_;
+		return previous;
+	}
+	auto text = internLocked(std::move(contents));
+	fileEntry = text;
+	return text;
+}
+
+SharedText SourceTextStore::readOrEmpty(const u8path& path) {
+	if (auto text = read(path)) {
+		return text;
+	}
+	return intern({});
+}
+
+SharedText SourceTextStore::intern(std::string text) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return internLocked(std::move(text));
+}
+
+SharedText SourceTextStore::internLocked(std::string&& text) {
+	++requests_;
+	auto hash = std::hash<std::string>{}(text);
+	auto [begin, end] = texts_.equal_range(hash);
+	for (auto it = begin; it != end; ++it) {
+		if (auto existing = it->second.lock(); existing && *existing == text) {
+			++hits_;
+			return existing;
+		}
+	}
+
+	if (++insertionsSinceCleanup_ >= CLEANUP_INTERVAL) {
+		removeExpiredLocked();
+	}
+
+	auto result = std::make_shared<const std::string>(std::move(text));
+	texts_.emplace(hash, result);
+	return result;
+}
+
+void SourceTextStore::removeExpiredLocked() {
+	for (auto it = texts_.begin(); it != texts_.end();) {
+		it = it->second.expired() ? texts_.erase(it) : std::next(it);
+	}
+	for (auto it = files_.begin(); it != files_.end();) {
+		it = it->second.expired() ? files_.erase(it) : std::next(it);
+	}
+	insertionsSinceCleanup_ = 0;
+}
+
+SourceTextStore::Statistics SourceTextStore::statistics() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	Statistics result;
+	result.requests = requests_;
+	result.hits = hits_;
+	for (const auto& [hash, weakText] : texts_) {
+		if (auto text = weakText.lock()) {
+			// Don't count the reference held by this function.
+			auto users = static_cast<size_t>(text.use_count() - 1);
+			++result.uniqueTexts;
+			result.uniqueBytes += text->size();
+			result.referencedBytes += users * text->size();
+		}
+	}
+	return result;
+}
+
+}  // namespace raco::utils
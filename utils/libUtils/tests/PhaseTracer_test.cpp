@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/FileUtils.h"
+#include "utils/PhaseTracer.h"
+#include "UtilsBaseTest.h"
+
+using namespace raco::utils;
+
+class PhaseTracerTest : public UtilsBaseTest {
+protected:
+	void TearDown() override {
+		PhaseTracer::instance().setEnabled(false);
+		PhaseTracer::instance().clear();
+		UtilsBaseTest::TearDown();
+	}
+};
+
+TEST_F(PhaseTracerTest, disabled_records_nothing) {
+	{
+		ScopedPhase phase("load", "loadFromFile");
+	}
+	EXPECT_TRUE(PhaseTracer::instance().events().empty());
+	EXPECT_TRUE(PhaseTracer::instance().aggregates().empty());
+}
+
+TEST_F(PhaseTracerTest, nested_phases_and_aggregates) {
+	PhaseTracer::instance().setEnabled(true);
+	{
+		ScopedPhase outer("load", "loadFromFile");
+		for (int index = 0; index < 3; index++) {
+			ScopedPhase inner("onAfterContextActivated", "Node");
+		}
+		ScopedPhase other("onAfterContextActivated", "MeshNode");
+	}
+
+	auto events = PhaseTracer::instance().events();
+	ASSERT_EQ(events.size(), 5);
+	const auto& outer = events.back();
+	EXPECT_EQ(outer.name, "loadFromFile");
+	for (const auto& event : events) {
+		EXPECT_GE(event.start, outer.start);
+		EXPECT_LE(event.start + event.duration, outer.start + outer.duration);
+	}
+
+	auto aggregates = PhaseTracer::instance().aggregates();
+	ASSERT_EQ(aggregates.size(), 3);
+	EXPECT_EQ((aggregates[{"onAfterContextActivated", "Node"}].count), 3);
+	EXPECT_EQ((aggregates[{"onAfterContextActivated", "MeshNode"}].count), 1);
+	EXPECT_EQ((aggregates[{"load", "loadFromFile"}].count), 1);
+	EXPECT_NE(PhaseTracer::instance().summary().find("MeshNode"), std::string::npos);
+}
+
+TEST_F(PhaseTracerTest, chrome_trace_json) {
+	auto& tracer = PhaseTracer::instance();
+	tracer.setEnabled(true);
+	auto start = PhaseTracer::Clock::now();
+	tracer.record("load", "quote\"name", start, start + std::chrono::milliseconds(2));
+
+	auto json = tracer.chromeTraceJson();
+	EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+	EXPECT_NE(json.find("\"name\":\"quote\\\"name\""), std::string::npos);
+	EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+	EXPECT_NE(json.find("\"dur\":2000"), std::string::npos);
+
+	auto path = test_path() / "trace.json";
+	ASSERT_TRUE(tracer.writeChromeTrace(path.string()));
+	EXPECT_EQ(file::read(path), json);
+}
+
+TEST_F(PhaseTracerTest, enabling_clears_previous_phases) {
+	auto& tracer = PhaseTracer::instance();
+	tracer.setEnabled(true);
+	{
+		ScopedPhase phase("load", "first");
+	}
+	tracer.setEnabled(false);
+	{
+		ScopedPhase phase("load", "ignored");
+	}
+	EXPECT_EQ(tracer.events().size(), 1);
+
+	tracer.setEnabled(true);
+	EXPECT_TRUE(tracer.events().empty());
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/FileUtils.h"
+#include "utils/SourceTextStore.h"
+#include "UtilsBaseTest.h"
+
+using namespace raco::utils;
+
+class SourceTextStoreTest : public UtilsBaseTest {
+protected:
+	SourceTextStore store;
+};
+
+TEST_F(SourceTextStoreTest, identical_files_share_text) {
+	file::write(test_path() / "a.lua", "function run() end");
+	file::write(test_path() / "b.lua", "function run() end");
+	file::write(test_path() / "c.lua", "function interface() end");
+
+	auto a = store.read(test_path() / "a.lua");
+	auto b = store.read(test_path() / "b.lua");
+	auto c = store.read(test_path() / "c.lua");
+
+	ASSERT_NE(a, nullptr);
+	EXPECT_EQ(*a, "function run() end");
+	EXPECT_EQ(a.get(), b.get());
+	EXPECT_NE(a.get(), c.get());
+	EXPECT_EQ(store.intern("function run() end").get(), a.get());
+}
+
+TEST_F(SourceTextStoreTest, changed_file_returns_new_text) {
+	auto path = test_path() / "shader.glsl";
+	file::write(path, "void main() {}");
+	auto first = store.read(path);
+	EXPECT_EQ(store.read(path).get(), first.get());
+
+	file::write(path, "void main() { discard; }");
+	auto second = store.read(path);
+	EXPECT_EQ(*second, "void main() { discard; }");
+	EXPECT_EQ(*first, "void main() {}");
+}
+
+TEST_F(SourceTextStoreTest, missing_file) {
+	EXPECT_EQ(store.read(test_path() / "missing.lua"), nullptr);
+	auto empty = store.readOrEmpty(test_path() / "missing.lua");
+	ASSERT_NE(empty, nullptr);
+	EXPECT_TRUE(empty->empty());
+}
+
+TEST_F(SourceTextStoreTest, text_released_when_unused) {
+	std::weak_ptr<const std::string> weak = store.intern("temporary");
+	EXPECT_TRUE(weak.expired());
+	EXPECT_EQ(store.statistics().uniqueTexts, 0u);
+}
+
+TEST_F(SourceTextStoreTest, statistics) {
+	std::string text(1000, 'x');
+	std::vector<SharedText> users;
+	for (int i = 0; i < 4; i++) {
+		users.emplace_back(store.intern(text));
+	}
+	auto other = store.intern("other");
+
+	auto statistics = store.statistics();
+	EXPECT_EQ(statistics.requests, 5u);
+	EXPECT_EQ(statistics.hits, 3u);
+	EXPECT_EQ(statistics.uniqueTexts, 2u);
+	EXPECT_EQ(statistics.uniqueBytes, 1005u);
+	EXPECT_EQ(statistics.referencedBytes, 4005u);
+	EXPECT_NEAR(statistics.deduplicationRatio(), 4005.0 / 1005.0, 1e-9);
+}